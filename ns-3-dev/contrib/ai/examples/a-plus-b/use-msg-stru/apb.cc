@@ -24,14 +24,20 @@
 #include <ns3/ai-module.h>
 #include <ns3/command-line.h>
 
+#include <cerrno>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <random>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #define NUM_ENV 100
 
 using namespace ns3;
 
+#include "ns3/ap-wifi-mac.h"
 #include "ns3/attribute-container.h"
 #include "ns3/bernoulli_packet_socket_client.h"
 #include "ns3/command-line.h"
@@ -39,9 +45,11 @@ using namespace ns3;
 #include "ns3/constant-rate-wifi-manager.h"
 #include "ns3/eht-configuration.h"
 #include "ns3/eht-phy.h"
+#include "ns3/event-profiler-simulator-impl.h"
 #include "ns3/frame-exchange-manager.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/log.h"
+#include "ns3/mlo-surrogate-model.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/multi-model-spectrum-channel.h"
 #include "ns3/on-off-helper.h"
@@ -49,9 +57,13 @@ using namespace ns3;
 #include "ns3/packet-socket-client.h"
 #include "ns3/packet-socket-helper.h"
 #include "ns3/packet-socket-server.h"
+#include "ns3/qos-txop.h"
 #include "ns3/qos-utils.h"
+#include "ns3/results-store.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/spectrum-wifi-helper.h"
+#include "ns3/sta-wifi-mac.h"
+#include "ns3/step-cache.h"
 #include "ns3/uinteger.h"
 #include "ns3/wifi-mac-queue.h"
 #include "ns3/wifi-net-device.h"
@@ -64,6 +76,11 @@ using namespace ns3;
 
 #include <array>
 #include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <vector>
 
 #define PI 3.1415926535
 
@@ -93,8 +110,88 @@ struct TrafficConfig
 
 using TrafficConfigMap = std::map<uint32_t /* Node ID */, TrafficConfig>;
 
+// Random stream families of the common random numbers mode (see --crn). Each family
+// draws from its own range of streams, selected by its own run number, so that two
+// runs with the same run number for a family see the same realization of it.
+enum CrnFamily : uint8_t
+{
+    CRN_TRAFFIC = 1, // arrivals, TIDs and start times of the clients
+    CRN_BACKOFF,     // MAC: backoffs, beacon and probe jitter
+    CRN_ERROR,       // PHY: reception errors, and the station managers
+};
+
+// Run numbers of the stream families, when the common random numbers mode is enabled
+struct CrnRuns
+{
+    bool m_enabled{false};
+    uint32_t m_trafficRun{0};
+    uint32_t m_backoffRun{0};
+    uint32_t m_errorRun{0};
+};
+
+// Global run of the common random numbers mode, and streams available to each run of a
+// family, far more than a scenario uses
+const uint32_t CRN_GLOBAL_RUN = 1;
+const int64_t CRN_STREAMS_PER_RUN = int64_t{1} << 20;
+
+// First stream of a run of a family. The streams assigned explicitly must stay below
+// 2^63, where ns-3 starts the streams it assigns automatically.
+int64_t
+CrnStream(CrnFamily family, uint32_t run)
+{
+    NS_ABORT_MSG_IF(run >= CRN_STREAMS_PER_RUN, "Run " << run << " too large for --crn");
+    return (static_cast<int64_t>(family) << 40) + run * CRN_STREAMS_PER_RUN;
+}
+
+// Assign the streams of the MAC and PHY of each device from their families, as
+// WifiHelper::AssignStreams does from a single range
+void
+AssignWifiCrnStreams(const NetDeviceContainer& devices, const CrnRuns& crn)
+{
+    int64_t macStream = CrnStream(CRN_BACKOFF, crn.m_backoffRun);
+    int64_t phyStream = CrnStream(CRN_ERROR, crn.m_errorRun);
+    for (auto devIt = devices.Begin(); devIt != devices.End(); ++devIt)
+    {
+        auto wifiDevice = DynamicCast<WifiNetDevice>(*devIt);
+        if (!wifiDevice)
+        {
+            continue;
+        }
+        for (const auto& phy : wifiDevice->GetPhys())
+        {
+            phyStream += phy->AssignStreams(phyStream);
+        }
+        for (const auto& manager : wifiDevice->GetRemoteStationManagers())
+        {
+            phyStream += manager->AssignStreams(phyStream);
+        }
+        auto mac = wifiDevice->GetMac();
+        for (AcIndex ac : {AC_BE, AC_BK, AC_VI, AC_VO})
+        {
+            macStream += mac->GetQosTxop(ac)->AssignStreams(macStream);
+        }
+        if (auto apMac = DynamicCast<ApWifiMac>(mac))
+        {
+            macStream += apMac->AssignStreams(macStream);
+        }
+        else if (auto staMac = DynamicCast<StaWifiMac>(mac))
+        {
+            macStream += staMac->AssignStreams(macStream);
+        }
+    }
+}
+
 Time slotTime;
 
+// Exit status of a fork server child whose episode is done (see --forkServer)
+const int FORK_EPISODE_DONE = 75;
+
+// AIFSN of every AC, so that all AIFS equal the legacy DIFS
+const uint8_t EDCA_AIFSN = 2;
+
+// time after which the MAC queue drops a pkt, in seconds
+const double MAC_QUEUE_MAX_DELAY = 0.5;
+
 
 // void
 // CheckStats()
@@ -188,13 +285,15 @@ GetBernoulliClient(const PacketSocketAddress& sockAddr,
                    const AcIndex link1Ac,
                    const bool optionalTid = false,
                    const AcIndex link2Ac = AC_UNDEF,
-                   const double optionalPr = 0)
+                   const double optionalPr = 0,
+                   Ptr<BernoulliTrafficParams> sharedParams = nullptr)
 {
     NS_ASSERT(link1Ac != AC_UNDEF);
     const auto link1Tids = wifiAcList.at(link1Ac);
     auto lowTid = link1Tids.GetLowTid();
 
     auto client = CreateObject<BernoulliPacketSocketClient>();
+    client->SetTrafficParams(sharedParams);
     client->SetAttribute("PacketSize", UintegerValue(pktSize));
     client->SetAttribute("MaxPackets", UintegerValue(0));
     client->SetAttribute("TimeSlot", TimeValue(slotTime));
@@ -264,37 +363,76 @@ void contentionWindowSetup(
 
 }
 
-void UpdateBernoulliClientProbability(NodeContainer& nodeContainer, double newProbability) {
-    for (auto nodeIt = nodeContainer.Begin(); nodeIt != nodeContainer.End(); ++nodeIt) {
-        Ptr<Node> node = *nodeIt;
-
-        for (uint32_t deviceIndex = 0; deviceIndex < node->GetNDevices(); ++deviceIndex) {
-            Ptr<NetDevice> netDevice = node->GetDevice(deviceIndex);
+// QosTxop of every device for each AC, resolved once after Setup(), with the
+// (CWmin, CWmax) last applied on each link
+struct EdcaTxops
+{
+    std::map<AcIndex, std::vector<Ptr<QosTxop>>> txops;
+    std::map<std::pair<AcIndex, uint8_t /* Link ID */>, std::pair<uint32_t, uint32_t>> applied;
+};
 
-            // Check if the device is a WifiNetDevice
-            Ptr<WifiNetDevice> wifiDevice = DynamicCast<WifiNetDevice>(netDevice);
-            if (!wifiDevice) {
-                continue;
+EdcaTxops
+ResolveEdcaTxops(const NetDeviceContainer& devices, uint8_t nLinks)
+{
+    EdcaTxops edca;
+    for (AcIndex ac : {AC_BE, AC_BK, AC_VI, AC_VO})
+    {
+        for (auto devIt = devices.Begin(); devIt != devices.End(); ++devIt)
+        {
+            auto wifiDevice = DynamicCast<WifiNetDevice>(*devIt);
+            if (wifiDevice && wifiDevice->GetMac()->GetQosTxop(ac))
+            {
+                edca.txops[ac].push_back(wifiDevice->GetMac()->GetQosTxop(ac));
             }
-
-            // Check if this node has applications installed
-            for (uint32_t appIndex = 0; appIndex < node->GetNApplications(); ++appIndex) {
-                Ptr<Application> app = node->GetApplication(appIndex);
-
-                // Check if the application is a BernoulliPacketSocketClient
-                Ptr<BernoulliPacketSocketClient> bernoulliClient = DynamicCast<BernoulliPacketSocketClient>(app);
-                if (bernoulliClient) {
-                    // // Update the BernoulliPr attribute
-                    // bernoulliClient->SetAttribute("BernoulliPr", DoubleValue(newProbability));
-                    bernoulliClient->SetAttribute("OptionalTidPr", DoubleValue(1-newProbability));
-
-                    // // Logging (optional for debugging purposes)
-                    // NS_LOG_INFO("Updated BernoulliPr for client on node " << node->GetId() << 
-                    //              " to " << newProbability);
-                }
+        }
+        // all devices got the same CWs from contentionWindowSetup
+        if (!edca.txops[ac].empty())
+        {
+            for (uint8_t linkId = 0; linkId < nLinks; ++linkId)
+            {
+                edca.applied[{ac, linkId}] = {edca.txops[ac].front()->GetMinCw(linkId),
+                                              edca.txops[ac].front()->GetMaxCw(linkId)};
             }
         }
     }
+    return edca;
+}
+
+// Set the CWs of an AC on a link, as contentionWindowSetup does, on every device,
+// unless they are already applied
+void
+ApplyCw(EdcaTxops& edca, AcIndex ac, uint8_t linkId, uint64_t cwmin, uint8_t cwStage)
+{
+    uint32_t minCw = cwmin - 1;
+    uint32_t maxCw = cwmin * pow(2, cwStage) - 1;
+    auto& applied = edca.applied[{ac, linkId}];
+    if (applied.first == minCw && applied.second == maxCw)
+    {
+        return;
+    }
+    for (const auto& txop : edca.txops[ac])
+    {
+        txop->SetMinCw(minCw, linkId);
+        txop->SetMaxCw(maxCw, linkId);
+    }
+    applied = {minCw, maxCw};
+}
+
+// (Re)create the TX and RX stats helpers of a new scenario. They are kept across steps,
+// so their traces are connected once; each step is an epoch of the TX stats.
+void
+EnableStats(std::unique_ptr<WifiTxStatsHelper>& wifiTxStats,
+            std::unique_ptr<WifiPhyRxTraceHelper>& wifiStats,
+            const NetDeviceContainer& devices,
+            NodeContainer nodes,
+            bool keepRecords)
+{
+    wifiTxStats = std::make_unique<WifiTxStatsHelper>();
+    wifiTxStats->Enable(devices);
+    // keep the per-pkt records only when they are printed
+    wifiTxStats->SetOnlineMode(!keepRecords);
+    wifiStats = std::make_unique<WifiPhyRxTraceHelper>();
+    wifiStats->Enable(nodes);
 }
 
 std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
@@ -311,11 +449,17 @@ std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
         uint64_t &acBECwminLink2, uint8_t &acBECwStageLink2, 
         uint64_t &acBKCwminLink2, uint8_t &acBKCwStageLink2, 
         uint64_t &acVICwminLink2, uint8_t &acVICwStageLink2, 
-        uint64_t &acVOCwminLink2, uint8_t &acVOCwStageLink2) {
-    RngSeedManager::SetSeed(rngRun);
-    RngSeedManager::SetRun(rngRun);
+        uint64_t &acVOCwminLink2, uint8_t &acVOCwStageLink2,
+        Ptr<BernoulliTrafficParams> mldTrafficParams, bool fastStart, const CrnRuns& crn) {
+    // with common random numbers, the runs of the stream families replace rngRun
+    RngSeedManager::SetSeed(crn.m_enabled ? CRN_GLOBAL_RUN : rngRun);
+    RngSeedManager::SetRun(crn.m_enabled ? CRN_GLOBAL_RUN : rngRun);
+    // as in a new process, so that the streams assigned automatically (e.g. those of the
+    // clients without CRN) do not depend on the episodes built before this one
+    RngSeedManager::ResetNextStreamIndex();
 
     uint32_t randomStream = rngRun;
+    int64_t trafficStream = crn.m_enabled ? CrnStream(CRN_TRAFFIC, crn.m_trafficRun) : 0;
 
     auto mldAcLink1 = static_cast<AcIndex>(mldAcLink1Int);
     auto mldAcLink2 = static_cast<AcIndex>(mldAcLink2Int);
@@ -344,7 +488,7 @@ std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
 
     // Don't drop MPDUs due to long stay in queue
     // Config::SetDefault("ns3::WifiMacQueue::MaxDelay", TimeValue(Seconds(2 * simulationTime)));
-    Config::SetDefault("ns3::WifiMacQueue::MaxDelay", TimeValue(Seconds(0.5)));
+    Config::SetDefault("ns3::WifiMacQueue::MaxDelay", TimeValue(Seconds(MAC_QUEUE_MAX_DELAY)));
 
     NodeContainer apNodeCon;
     NodeContainer mldNodeCon;
@@ -460,7 +604,14 @@ std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
     allNetDevices.Add(apDevCon);
     allNetDevices.Add(mldDevCon);
 
-    mldWifiHelp.AssignStreams(allNetDevices, randomStream);
+    if (crn.m_enabled)
+    {
+        AssignWifiCrnStreams(allNetDevices, crn);
+    }
+    else
+    {
+        mldWifiHelp.AssignStreams(allNetDevices, randomStream);
+    }
 
     // Enable TID-to-Link Mapping for AP and MLD STAs
     for (auto i = allNetDevices.Begin(); i != allNetDevices.End(); ++i)
@@ -522,7 +673,7 @@ std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
     std::string prefixStr = "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/";
 
     // set all aifsn to be 2 (so that all aifs equal to legacy difs)
-    std::list<uint64_t> aifsnList = {2, 2};
+    std::list<uint64_t> aifsnList = {EDCA_AIFSN, EDCA_AIFSN};
     Config::Set(prefixStr + "BE_Txop/Aifsns", AttributeContainerValue<UintegerValue>(aifsnList));
     Config::Set(prefixStr + "BK_Txop/Aifsns", AttributeContainerValue<UintegerValue>(aifsnList));
     Config::Set(prefixStr + "VI_Txop/Aifsns", AttributeContainerValue<UintegerValue>(aifsnList));
@@ -561,9 +712,11 @@ std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
     mobility.Install(allNodeCon);
 
     /* Setting applications */
-    // random start time
+    // random start time, or all clients start at 0 s in fast start mode (their packets are
+    // dropped until their STA is associated, a few ms later)
     Ptr<UniformRandomVariable> startTime = CreateObject<UniformRandomVariable>();
-    startTime->SetAttribute("Stream", IntegerValue(randomStream));
+    startTime->SetAttribute("Stream",
+                            IntegerValue(crn.m_enabled ? trafficStream++ : randomStream));
     startTime->SetAttribute("Min", DoubleValue(0.0));
     startTime->SetAttribute("Max", DoubleValue(1.0));
 
@@ -591,6 +744,13 @@ std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
                                mldPerNodeLambda, mldDetermIntervalNs,
                                true, 1 - mldProbLink1};
     }
+    // the MLD clients share their traffic parameters, which the RL loop updates
+    mldTrafficParams->m_bernoulliPr = mldPerNodeLambda;
+    mldTrafficParams->m_optionalTid = (mldAcLink2 != AC_UNDEF)
+                                          ? wifiAcList.at(mldAcLink2).GetHighTid()
+                                          : wifiAcList.at(mldAcLink1).GetLowTid();
+    mldTrafficParams->m_optionalTidPr = 1 - mldProbLink1;
+    mldTrafficParams->m_size = payloadSize;
     // next, setup clients according to the config
     for (uint32_t i = 0; i < nStaTotal; ++i)
     {
@@ -615,7 +775,8 @@ std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
                                                               payloadSize,
                                                               NanoSeconds(
                                                                   mapIt->second.m_determIntervalNs),
-                                                              Seconds(startTime->GetValue()),
+                                                              fastStart ? Seconds(0)
+                                                                        : Seconds(startTime->GetValue()),
                                                               mapIt->second.m_link1Ac,
                                                               mapIt->second.m_split,
                                                               mapIt->second.m_link2Ac,
@@ -627,14 +788,21 @@ std::tuple<NetDeviceContainer, NodeContainer , NodeContainer> Setup(
             sockAddr.SetSingleDevice(clientDevice->GetIfIndex());
             sockAddr.SetPhysicalAddress(serverDevice->GetAddress());
             sockAddr.SetProtocol(1);
-            clientNode->AddApplication(GetBernoulliClient(sockAddr,
-                                                          payloadSize,
-                                                          mapIt->second.m_lambda,
-                                                          Seconds(startTime->GetValue()),
-                                                          mapIt->second.m_link1Ac,
-                                                          mapIt->second.m_split,
-                                                          mapIt->second.m_link2Ac,
-                                                          mapIt->second.m_prob));
+            auto client = GetBernoulliClient(sockAddr,
+                                             payloadSize,
+                                             mapIt->second.m_lambda,
+                                             fastStart ? Seconds(0)
+                                                       : Seconds(startTime->GetValue()),
+                                             mapIt->second.m_link1Ac,
+                                             mapIt->second.m_split,
+                                             mapIt->second.m_link2Ac,
+                                             mapIt->second.m_prob,
+                                             mldTrafficParams);
+            if (crn.m_enabled)
+            {
+                trafficStream += client->AssignStreams(trafficStream);
+            }
+            clientNode->AddApplication(client);
             break;
         }
         default: {
@@ -652,10 +820,275 @@ void EventCallback (std::string context, Time time)
 }
 
 
+/**
+ * Get the value of a statistic if Python subscribed to it, NaN otherwise
+ */
+double
+Subscribed(uint64_t mask, uint64_t bit, double value)
+{
+    return (mask & bit) ? value : std::numeric_limits<double>::quiet_NaN();
+}
+
+/**
+ * Apply X to the name of each statistic of a step, as named in EnvStruct without
+ * its env_ prefix
+ */
+#define APB_STEP_STATS(X)                                                                        \
+    X(mldSuccPrLink1) X(mldSuccPrLink2) X(mldSuccPrTotal)                                       \
+    X(mldThptLink1) X(mldThptLink2) X(mldThptTotal)                                             \
+    X(mldMeanQueDelayLink1) X(mldMeanQueDelayLink2) X(mldMeanQueDelayTotal)                     \
+    X(mldMeanAccDelayLink1) X(mldMeanAccDelayLink2) X(mldMeanAccDelayTotal)                     \
+    X(mldMeanE2eDelayLink1) X(mldMeanE2eDelayLink2) X(mldMeanE2eDelayTotal)                     \
+    X(mldSecondRawMomentAccDelayLink1) X(mldSecondRawMomentAccDelayLink2)                       \
+    X(mldSecondRawMomentAccDelayTotal)                                                          \
+    X(mldSecondCentralMomentAccDelayLink1) X(mldSecondCentralMomentAccDelayLink2)               \
+    X(mldSecondCentralMomentAccDelayTotal)                                                      \
+    X(mldP95AccDelayLink1) X(mldP95AccDelayLink2) X(mldP95AccDelayTotal)                        \
+    X(mldP95E2eDelayLink1) X(mldP95E2eDelayLink2) X(mldP95E2eDelayTotal)                        \
+    X(mldP99AccDelayLink1) X(mldP99AccDelayLink2) X(mldP99AccDelayTotal)                        \
+    X(mldP99E2eDelayLink1) X(mldP99E2eDelayLink2) X(mldP99E2eDelayTotal)
+
+/**
+ * Canonical text of what an action sets for its step, for the keys of the step cache
+ */
+std::string
+StepCacheActionKey(const ActStruct& act)
+{
+    std::ostringstream key;
+    key << std::hexfloat << "cwStage1=" << +act.act_acBECwStageLink1
+        << ",cwmin1=" << act.act_acBECwminLink1 << ",cwmin2=" << act.act_acBECwminLink2
+        << ",step=" << act.act_simulationTime << ",lambda=" << act.act_mldPerNodeLambda
+        << ",steps=" << act.act_totalSteps << ",prob1=" << act.act_mldProbLink1;
+    return key.str();
+}
+
+/**
+ * Print the per node and link TX statistics of the step
+ */
+void
+PrintTxStats(const WifiTxStatsWindow& window)
+{
+    auto finalResults = WifiTxStatsHelper::GetStatistics(window);
+    const auto& successInfo = window.m_successMap;
+
+    // total and mean delay calculation per node and link
+    std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, std::vector<double> > >
+        enqueueTimeMap;
+    std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, std::vector<double> > >
+        dequeueTimeMap;
+    std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, std::vector<double> > >
+        holTimeMap;
+    for (const auto& nodeMap : successInfo)
+    {
+        for (const auto& linkMap : nodeMap.second)
+        {
+            for (const auto& record : linkMap.second)
+            {
+                enqueueTimeMap[nodeMap.first][linkMap.first].emplace_back(record.m_enqueueMs);
+                dequeueTimeMap[nodeMap.first][linkMap.first].emplace_back(record.m_dequeueMs);
+            }
+            for (uint32_t i = 0; i < enqueueTimeMap[nodeMap.first][linkMap.first].size(); ++i)
+            {
+                if (i == 0)
+                {
+                    // This value is false (some data packet may be already in queue
+                    // because our stats did not start at 0 second), and will be removed later
+                    holTimeMap[nodeMap.first][linkMap.first].emplace_back(
+                        enqueueTimeMap[nodeMap.first][linkMap.first][i]);
+                }
+                else
+                {
+                    holTimeMap[nodeMap.first][linkMap.first].emplace_back(
+                        std::max(enqueueTimeMap[nodeMap.first][linkMap.first][i],
+                                dequeueTimeMap[nodeMap.first][linkMap.first][i - 1]));
+                }
+            }
+            // remove the first element
+            enqueueTimeMap[nodeMap.first][linkMap.first].erase(
+                enqueueTimeMap[nodeMap.first][linkMap.first].begin());
+            dequeueTimeMap[nodeMap.first][linkMap.first].erase(
+                dequeueTimeMap[nodeMap.first][linkMap.first].begin());
+            holTimeMap[nodeMap.first][linkMap.first].erase(
+                holTimeMap[nodeMap.first][linkMap.first].begin());
+        }
+    }
+    std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, double> >
+        totalQueuingDelayPerNodeLink;
+    std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, double> >
+        meanQueuingDelayPerNodeLink;
+    std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, double> >
+        totalAccessDelayPerNodeLink;
+    std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, double> >
+        meanAccessDelayPerNodeLink;
+    for (const auto& nodeMap : successInfo)
+    {
+        for (const auto& linkMap : nodeMap.second)
+        {
+            for (uint32_t i = 0; i < enqueueTimeMap[nodeMap.first][linkMap.first].size(); ++i)
+            {
+                totalQueuingDelayPerNodeLink[nodeMap.first][linkMap.first] += holTimeMap[nodeMap.
+                    first][linkMap.first][i] - enqueueTimeMap[nodeMap.first][
+                    linkMap.first][i];
+                totalAccessDelayPerNodeLink[nodeMap.first][linkMap.first] += dequeueTimeMap[nodeMap.
+                    first][linkMap.first][i] - holTimeMap[nodeMap.first][linkMap.
+                    first][i];
+            }
+            meanQueuingDelayPerNodeLink[nodeMap.first][linkMap.first] =
+                totalQueuingDelayPerNodeLink[nodeMap.first][linkMap.first] / (finalResults.
+                    m_numSuccessPerNodeLink[nodeMap.first][linkMap.first] - 1);
+            meanAccessDelayPerNodeLink[nodeMap.first][linkMap.first] =
+                totalAccessDelayPerNodeLink[nodeMap.first][linkMap.first] / (finalResults.
+                    m_numSuccessPerNodeLink[nodeMap.first][linkMap.first] - 1);
+        }
+    }
+
+    std::cout << "TX Stats:\n";
+    std::cout << "Node_ID\tLink_ID\t#Success\n";
+    for (const auto& nodeMap : finalResults.m_numSuccessPerNodeLink)
+    {
+        for (const auto& linkMap : nodeMap.second)
+        {
+            std::cout << nodeMap.first << "\t\t"
+                << +linkMap.first << "\t\t"
+                << linkMap.second << "\n";
+        }
+    }
+    std::cout << "Node_ID\tLink_ID\tMean_Queuing_Delay\n";
+    for (const auto& nodeMap : meanQueuingDelayPerNodeLink)
+    {
+        for (const auto& linkMap : nodeMap.second)
+        {
+            std::cout << nodeMap.first << "\t\t"
+                << +linkMap.first << "\t\t"
+                << linkMap.second << "\n";
+        }
+    }
+    std::cout << "Node_ID\tLink_ID\tMean_Access_Delay\n";
+    for (const auto& nodeMap : meanAccessDelayPerNodeLink)
+    {
+        for (const auto& linkMap : nodeMap.second)
+        {
+            std::cout << nodeMap.first << "\t\t"
+                << +linkMap.first << "\t\t"
+                << linkMap.second << "\n";
+        }
+    }
+    std::cout << "Summary:"
+        << "\n1. Successful pkts: " << finalResults.m_numSuccess
+        << "\n2. Successful and retransmitted pkts: " << finalResults.m_numRetransmitted
+        << "\n3. Avg retransmissions per successful pkt: " << finalResults.m_avgFailures
+        << "\n4. Failed pkts: " << finalResults.m_numFinalFailed
+        << "\n";
+}
+
+/**
+ * NumPy description of EnvStruct, so that recorded trajectories have named fields
+ */
+std::string
+EnvStructNumpyDescr()
+{
+    return NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSuccPrLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSuccPrLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSuccPrTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldThptLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldThptLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldThptTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanQueDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanQueDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanQueDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanAccDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanAccDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanAccDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanE2eDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanE2eDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldMeanE2eDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSecondRawMomentAccDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSecondRawMomentAccDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSecondRawMomentAccDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSecondCentralMomentAccDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSecondCentralMomentAccDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldSecondCentralMomentAccDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP95AccDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP95AccDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP95AccDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP95E2eDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP95E2eDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP95E2eDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP99AccDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP99AccDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP99AccDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP99E2eDelayLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP99E2eDelayLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldP99E2eDelayTotal) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_rngRun) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_simulationTime) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_payloadSize) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mcs) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mcs2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_channelWidth) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_channelWidth2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_nMldSta) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldPerNodeLambda) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldProbLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldAcLink1Int) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_mldAcLink2Int) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acBECwminLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acBECwStageLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acBKCwminLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acBKCwStageLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acVICwminLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acVICwStageLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acVOCwminLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acVOCwStageLink1) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acBECwminLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acBECwStageLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acBKCwminLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acBKCwStageLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acVICwminLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acVICwStageLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acVOCwminLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_acVOCwStageLink2) +
+           NS3AI_TRAJECTORY_FIELD(EnvStruct, env_stepNumber);
+}
+
+/**
+ * NumPy description of ActStruct
+ */
+std::string
+ActStructNumpyDescr()
+{
+    return NS3AI_TRAJECTORY_FIELD(ActStruct, act_done_simulation) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_end_experiment) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_acBECwStageLink1) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_acBECwminLink1) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_acBECwminLink2) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_simulationTime) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_mldPerNodeLambda) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_totalSteps) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_mldProbLink1) +
+           NS3AI_TRAJECTORY_FIELD(ActStruct, act_obsMask);
+}
+
+/**
+ * Configuration of a link of the surrogate model, for the AC used on the link
+ * \param cws the (CWmin, stage) of each AC on the link, in AcIndex order
+ */
+MloSurrogateLinkConfig
+SurrogateLinkConfig(int mcs,
+                    int channelWidth,
+                    uint8_t acInt,
+                    const std::array<std::pair<uint64_t, uint8_t>, 4>& cws)
+{
+    // the AIFSN is the same for every AC, as set up for the simulation
+    NS_ABORT_MSG_IF(acInt >= cws.size(), "Invalid AC " << +acInt);
+    return {mcs, channelWidth, cws[acInt].first, cws[acInt].second, EDCA_AIFSN};
+}
+
 int RunSimulation(int argc, char *argv[]) {
 
     std::ofstream g_fileSummary;
-    g_fileSummary.open("wifi-mld.dat", std::ofstream::app);
+    std::string outputFile{"wifi-mld.dat"};
+    std::string resultsFile;
     bool printTxStats{false};
     bool printTxStatsSingleLine{false};
     // bool printRxStats{false};
@@ -772,13 +1205,110 @@ int RunSimulation(int argc, char *argv[]) {
     cmd.AddValue("acVOCwminLink2", "Initial CW for AC_VO on link 2", acVOCwminLink2);
     uint8_t acVOCwStageLink2 = 6;
     cmd.AddValue("acVOCwStageLink2", "Cutoff Stage for AC_VO on link 2", acVOCwStageLink2);
+    bool fastStart{false};
+    cmd.AddValue("fastStart",
+                 "Start all clients at 0 s instead of uniformly in [0, 1] s, so that traffic "
+                 "starts as soon as the STAs are associated",
+                 fastStart);
+    bool crn{false};
+    cmd.AddValue("crn",
+                 "Common random numbers: draw the arrivals, the MAC backoffs and the PHY "
+                 "errors from separate stream families, set by trafficRun, backoffRun and "
+                 "errorRun, so that policies compared with equal runs see the same "
+                 "realizations of each",
+                 crn);
+    uint32_t trafficRun{0};
+    cmd.AddValue("trafficRun", "Run of the arrivals with --crn (0: rngRun)", trafficRun);
+    uint32_t backoffRun{0};
+    cmd.AddValue("backoffRun", "Run of the MAC backoffs with --crn (0: rngRun)", backoffRun);
+    uint32_t errorRun{0};
+    cmd.AddValue("errorRun", "Run of the PHY errors with --crn (0: rngRun)", errorRun);
+    bool forkServer{false};
+    cmd.AddValue("forkServer",
+                 "Build and warm up the scenario once, then run each episode in a forked copy "
+                 "of it instead of rebuilding it; the actions that end an episode must then "
+                 "keep the scenario parameters of the command line",
+                 forkServer);
+    double forkWarmup = 1.0;
+    cmd.AddValue("forkWarmup",
+                 "Time simulated before the fork server forks episodes, in seconds "
+                 "(association and start of all clients, a few ms with fastStart)",
+                 forkWarmup);
+    std::string backend{"ns3"};
+    cmd.AddValue("backend",
+                 "Source of the statistics of each step: ns3 (simulation) or surrogate "
+                 "(analytical model of the links, see MloSurrogateModel; no percentiles)",
+                 backend);
+    std::string stepCacheDir;
+    cmd.AddValue("stepCache",
+                 "Directory of the on-disk cache of the statistics of each step, by scenario, "
+                 "seed and actions since the start of the episode; it can be shared by "
+                 "concurrent runs, and must be emptied when the simulation code changes "
+                 "(empty: no cache)",
+                 stepCacheDir);
+    bool profile{false};
+    cmd.AddValue("profile",
+                 "Print the wall-clock profile of the steps at the end of the run: time in "
+                 "each phase, events simulated, and time waiting for Python",
+                 profile);
+    std::string profileShm;
+    cmd.AddValue("profileShm",
+                 "Name of a shared memory object, such as /apb-profile, where the step profile "
+                 "is kept up to date for Python (see ns3ai_step_profile.py; empty: none)",
+                 profileShm);
+    std::string eventProfile;
+    cmd.AddValue("eventProfile",
+                 "Profile the wall-clock time of the events by type and node, and write the "
+                 "report to <prefix>.txt and the folded stacks to <prefix>.folded at each "
+                 "rebuild and at the end of the run; the episodes of the fork server exit "
+                 "without writing theirs (empty: no profiling)",
+                 eventProfile);
+    std::string trajectoryFile = "";
+    cmd.AddValue("trajectoryFile",
+                 "File where (EnvStruct, ActStruct, reward, done) records are appended "
+                 "for offline RL (empty: not recorded)",
+                 trajectoryFile);
 
     uint64_t totalSteps = 10;
     double simulationTime = totalSteps * stepSize;
 
 
 
+    cmd.AddValue("outputFile",
+                 "File the summary line of the run is appended to",
+                 outputFile);
+    cmd.AddValue("resultsFile",
+                 "Results file the summary of each step is appended to, in binary columnar "
+                 "form (empty: not written)",
+                 resultsFile);
     cmd.Parse(argc, argv);
+    NS_ABORT_MSG_IF(backend != "ns3" && backend != "surrogate", "Unknown backend " << backend);
+    bool surrogate = (backend == "surrogate");
+    NS_ABORT_MSG_IF(surrogate && forkServer, "The surrogate backend has nothing to fork");
+    if (!eventProfile.empty())
+    {
+        EventProfilerSimulatorImpl::Enable(eventProfile);
+    }
+    MloSurrogateModel surrogateModel;
+    CrnRuns crnRuns;
+    crnRuns.m_enabled = crn;
+    crnRuns.m_trafficRun = (trafficRun != 0 ? trafficRun : rngRun);
+    crnRuns.m_backoffRun = (backoffRun != 0 ? backoffRun : rngRun);
+    crnRuns.m_errorRun = (errorRun != 0 ? errorRun : rngRun);
+    NS_ABORT_MSG_IF(surrogate && !stepCacheDir.empty(),
+                    "The surrogate backend is faster than the step cache");
+    std::unique_ptr<StepCache> stepCache;
+    if (!stepCacheDir.empty())
+    {
+        stepCache = std::make_unique<StepCache>(stepCacheDir);
+    }
+    g_fileSummary.open(outputFile, std::ofstream::app);
+    // typed, columnar copy of the summary lines (see experiments/utils/results_store.py)
+    std::unique_ptr<ResultsStoreWriter> results;
+    if (!resultsFile.empty())
+    {
+        results = std::make_unique<ResultsStoreWriter>(resultsFile);
+    }
 
     auto interface = Ns3AiMsgInterface::Get();
     interface->SetIsMemoryCreator(false);
@@ -794,82 +1324,183 @@ int RunSimulation(int argc, char *argv[]) {
     // std::uniform_int_distribution<int> distrib(1, 10);
 
 
-    auto [allNetDevices, allNodeCon, mldNodeCon] = Setup(
-        unlimitedAmpdu, maxMpdusInAmpdu, useRts, bssRadius, frequency, frequency2, gi, apTxPower, staTxPower, nLinks,
-        rngRun, simulationTime, payloadSize, mcs, mcs2, channelWidth, channelWidth2, nMldSta, mldPerNodeLambda, mldProbLink1, mldAcLink1Int, mldAcLink2Int,
-        acBECwminLink1, acBECwStageLink1, 
-        acBKCwminLink1, acBKCwStageLink1, 
-        acVICwminLink1, acVICwStageLink1, 
-        acVOCwminLink1, acVOCwStageLink1, 
-        acBECwminLink2, acBECwStageLink2, 
-        acBKCwminLink2, acBKCwStageLink2, 
-        acVICwminLink2, acVICwStageLink2, 
-        acVOCwminLink2, acVOCwStageLink2);
-        
+    // wall-clock profile of the steps: time spent in each phase of a step, events
+    // simulated and waits for Python; the setup of the scenario goes to the next step
+    Ns3AiStepProfiler profiler;
+    const uint32_t profStep = profiler.AddMetric("step", Ns3AiStepProfiler::NANOSECONDS);
+    const uint32_t profRecvWait = profiler.AddMetric("recv_wait", Ns3AiStepProfiler::NANOSECONDS);
+    const uint32_t profSendWait = profiler.AddMetric("send_wait", Ns3AiStepProfiler::NANOSECONDS);
+    const uint32_t profSetup = profiler.AddMetric("setup", Ns3AiStepProfiler::NANOSECONDS);
+    const uint32_t profCwConfig = profiler.AddMetric("cw_config", Ns3AiStepProfiler::NANOSECONDS);
+    const uint32_t profSimRun = profiler.AddMetric("sim_run", Ns3AiStepProfiler::NANOSECONDS);
+    const uint32_t profSimEvents = profiler.AddMetric("sim_events", Ns3AiStepProfiler::COUNT);
+    const uint32_t profStats = profiler.AddMetric("stats", Ns3AiStepProfiler::NANOSECONDS);
+    const uint32_t profCache = profiler.AddMetric("cache", Ns3AiStepProfiler::NANOSECONDS);
+    const uint32_t profReport = profiler.AddMetric("report", Ns3AiStepProfiler::NANOSECONDS);
+    if (profile || !profileShm.empty())
+    {
+        profiler.Enable(profileShm);
+    }
+    uint64_t profStart = profiler.Now();
+
+    Ptr<BernoulliTrafficParams> mldTrafficParams = Create<BernoulliTrafficParams>();
+    NetDeviceContainer allNetDevices;
+    NodeContainer allNodeCon;
+    NodeContainer mldNodeCon;
+    if (!surrogate)
+    {
+        std::tie(allNetDevices, allNodeCon, mldNodeCon) = Setup(
+            unlimitedAmpdu, maxMpdusInAmpdu, useRts, bssRadius, frequency, frequency2, gi, apTxPower, staTxPower, nLinks,
+            rngRun, simulationTime, payloadSize, mcs, mcs2, channelWidth, channelWidth2, nMldSta, mldPerNodeLambda, mldProbLink1, mldAcLink1Int, mldAcLink2Int,
+            acBECwminLink1, acBECwStageLink1, 
+            acBKCwminLink1, acBKCwStageLink1, 
+            acVICwminLink1, acVICwStageLink1, 
+            acVOCwminLink1, acVOCwStageLink1, 
+            acBECwminLink2, acBECwStageLink2, 
+            acBKCwminLink2, acBKCwStageLink2, 
+            acVICwminLink2, acVICwStageLink2, 
+            acVOCwminLink2, acVOCwStageLink2,
+            mldTrafficParams, fastStart, crnRuns);
+    }
+
+    profiler.AddTimeSince(profSetup, profStart);
+
+    // everything the statistics of an episode depend on besides its actions: the
+    // Setup() inputs, and the warm up of the fork server, which episodes start from
+    auto scenarioKey = [&]() {
+        std::ostringstream key;
+        key << std::hexfloat << "apb-step-cache-2,env=" << sizeof(EnvStruct)
+            << ",unlimitedAmpdu=" << unlimitedAmpdu << ",maxMpdusInAmpdu=" << +maxMpdusInAmpdu
+            << ",useRts=" << useRts << ",bssRadius=" << bssRadius << ",frequency=" << frequency
+            << ",frequency2=" << frequency2 << ",gi=" << gi << ",apTxPower=" << apTxPower
+            << ",staTxPower=" << staTxPower << ",nLinks=" << +nLinks << ",rngRun=" << rngRun
+            << ",simulationTime=" << simulationTime << ",payloadSize=" << payloadSize
+            << ",mcs=" << mcs << ",mcs2=" << mcs2 << ",channelWidth=" << channelWidth
+            << ",channelWidth2=" << channelWidth2 << ",nMldSta=" << nMldSta
+            << ",mldPerNodeLambda=" << mldPerNodeLambda << ",mldProbLink1=" << mldProbLink1
+            << ",mldAcLink1Int=" << +mldAcLink1Int << ",mldAcLink2Int=" << +mldAcLink2Int
+            << ",cwsLink1=" << acBECwminLink1 << "/" << +acBECwStageLink1 << ","
+            << acBKCwminLink1 << "/" << +acBKCwStageLink1 << "," << acVICwminLink1 << "/"
+            << +acVICwStageLink1 << "," << acVOCwminLink1 << "/" << +acVOCwStageLink1
+            << ",cwsLink2=" << acBECwminLink2 << "/" << +acBECwStageLink2 << ","
+            << acBKCwminLink2 << "/" << +acBKCwStageLink2 << "," << acVICwminLink2 << "/"
+            << +acVICwStageLink2 << "," << acVOCwminLink2 << "/" << +acVOCwStageLink2
+            << ",fastStart=" << fastStart;
+        if (crnRuns.m_enabled)
+        {
+            key << ",crn=" << crnRuns.m_trafficRun << "/" << crnRuns.m_backoffRun << "/"
+                << crnRuns.m_errorRun;
+        }
+        if (forkServer)
+        {
+            key << ",forkWarmup=" << forkWarmup;
+        }
+        return key.str();
+    };
+    std::string episodeKey = stepCache ? scenarioKey() : "";
+
 
 
     // Simulator::Stop(Seconds(stepSize));
     // Simulator::Run();
 
+    // In fork server mode, this process keeps the warmed-up scenario and runs
+    // each episode in a copy-on-write child. A child exits when its episode is
+    // done; the next one starts from the action that ended it, which is still
+    // in the segment since Python waits for the next state.
+    bool resumeEpisode = false;
+    // the parameters of an action that Setup() uses, which a rebuild would apply
+    auto setupParams = [&]() {
+        return std::make_tuple(simulationTime,
+                               mldPerNodeLambda,
+                               mldProbLink1,
+                               acBECwminLink1,
+                               acBECwStageLink1,
+                               acBECwminLink2);
+    };
+    const auto warmSetupParams = setupParams();
+    if (forkServer)
+    {
+        profStart = profiler.Now();
+        Simulator::Stop(Seconds(forkWarmup));
+        Simulator::Run();
+        profiler.AddTimeSince(profSetup, profStart);
+        g_fileSummary.flush();
+        std::cout.flush();
+        while (true)
+        {
+            pid_t child = fork();
+            NS_ABORT_MSG_IF(child < 0, "Cannot fork an episode: " << std::strerror(errno));
+            if (child == 0)
+            {
+                break;
+            }
+            int status = 0;
+            while (waitpid(child, &status, 0) < 0 && errno == EINTR)
+            {
+            }
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != FORK_EPISODE_DONE)
+            {
+                // end of the experiment (the child closed the interface), or failure
+                _exit(WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE);
+            }
+            resumeEpisode = true;
+        }
+    }
+
+    // Each record holds a state, the throughput as reward, and the action Python
+    // chose on that state. It is written when the action arrives, which also
+    // tells whether the state ended the episode.
+    // Opened after forking, as the writer thread does not survive fork().
+    Ns3AiTrajectoryRecorder trajectory;
+    if (!trajectoryFile.empty())
+    {
+        trajectory.Open(trajectoryFile,
+                        sizeof(EnvStruct),
+                        sizeof(ActStruct),
+                        EnvStructNumpyDescr(),
+                        ActStructNumpyDescr(),
+                        true);
+    }
+    uint32_t trajectoryEpisode = trajectory.GetNextEpisode();
+    uint32_t trajectoryStep = 0;
+    bool trajectoryPending = false;
+    EnvStruct lastEnv{};
 
     bool loop = true;
     
 
     uint8_t stepNumber= 0;
-
-    while (loop)
+    uint64_t obsMask = OBS_ALL;
+    // two links, as set by contentionWindowSetup
+    EdcaTxops edcaTxops = ResolveEdcaTxops(allNetDevices, 2);
+    std::unique_ptr<WifiTxStatsHelper> wifiTxStats;
+    std::unique_ptr<WifiPhyRxTraceHelper> wifiStats;
+    if (!surrogate)
     {
+        EnableStats(wifiTxStats, wifiStats, allNetDevices, allNodeCon, printTxStats);
+    }
 
-        // std::cout << "simulationTime: " << simulationTime << std::endl << std::flush;
-
-        msgInterface->CppRecvBegin();
-        bool end_experiment = msgInterface->GetPy2CppStruct()->act_end_experiment;
-        bool done_simulation = msgInterface->GetPy2CppStruct()->act_done_simulation;
-        acBECwStageLink1 = msgInterface->GetPy2CppStruct()->act_acBECwStageLink1;
-        acBECwminLink1 = msgInterface->GetPy2CppStruct()->act_acBECwminLink1;
-        acBECwminLink2 = msgInterface->GetPy2CppStruct()->act_acBECwminLink2;
-
-        mldPerNodeLambda = msgInterface->GetPy2CppStruct()-> act_mldPerNodeLambda;
-        stepSize = msgInterface->GetPy2CppStruct()-> act_simulationTime;
-        totalSteps =  msgInterface->GetPy2CppStruct()-> act_totalSteps;
-        mldProbLink1 = msgInterface->GetPy2CppStruct()-> act_mldProbLink1;
-
-        msgInterface->CppRecvEnd();
+    // the parameters an action sets for its step
+    auto applyAction = [&](const ActStruct& action) {
+        acBECwStageLink1 = action.act_acBECwStageLink1;
+        acBECwminLink1 = action.act_acBECwminLink1;
+        acBECwminLink2 = action.act_acBECwminLink2;
+        mldPerNodeLambda = action.act_mldPerNodeLambda;
+        stepSize = action.act_simulationTime;
+        totalSteps = action.act_totalSteps;
+        mldProbLink1 = action.act_mldProbLink1;
         simulationTime = stepSize * totalSteps;
+    };
 
-        if (end_experiment){
-            loop = false;
-            break;
-        }
-        else if (done_simulation){
-            // std::cout << "Done Triggered!" << std::endl << std::flush;
-            Simulator::Destroy();
-
-            std::tie(allNetDevices, allNodeCon, mldNodeCon) = Setup(
-                unlimitedAmpdu, maxMpdusInAmpdu, useRts, bssRadius, frequency, frequency2, gi, apTxPower, staTxPower, nLinks,
-                rngRun, simulationTime, payloadSize, mcs, mcs2, channelWidth, channelWidth2, nMldSta, mldPerNodeLambda, mldProbLink1, mldAcLink1Int, mldAcLink2Int,
-                acBECwminLink1, acBECwStageLink1, 
-                acBKCwminLink1, acBKCwStageLink1, 
-                acVICwminLink1, acVICwStageLink1, 
-                acVOCwminLink1, acVOCwStageLink1, 
-                acBECwminLink2, acBECwStageLink2, 
-                acBKCwminLink2, acBKCwStageLink2, 
-                acVICwminLink2, acVICwStageLink2, 
-                acVOCwminLink2, acVOCwStageLink2);
+    // rebuild the scenario with the current parameters, for a new episode
+    auto rebuild = [&]() {
+        uint64_t start = profiler.Now();
+        Simulator::Destroy();
 
-            stepNumber= 0;
-
-            // WifiTxStatsHelper wifiTxStats;
-            // WifiPhyRxTraceHelper wifiStats;
-            // wifiTxStats.Enable(allNetDevices);
-
-            // wifiStats.Enable(allNodeCon);
-
-            // Simulator::Stop(Seconds(5));
-            // Simulator::Run();
-        }
-
-        contentionWindowSetup(
+        std::tie(allNetDevices, allNodeCon, mldNodeCon) = Setup(
+            unlimitedAmpdu, maxMpdusInAmpdu, useRts, bssRadius, frequency, frequency2, gi, apTxPower, staTxPower, nLinks,
+            rngRun, simulationTime, payloadSize, mcs, mcs2, channelWidth, channelWidth2, nMldSta, mldPerNodeLambda, mldProbLink1, mldAcLink1Int, mldAcLink2Int,
             acBECwminLink1, acBECwStageLink1, 
             acBKCwminLink1, acBKCwStageLink1, 
             acVICwminLink1, acVICwStageLink1, 
@@ -877,315 +1508,539 @@ int RunSimulation(int argc, char *argv[]) {
             acBECwminLink2, acBECwStageLink2, 
             acBKCwminLink2, acBKCwStageLink2, 
             acVICwminLink2, acVICwStageLink2, 
-            acVOCwminLink2, acVOCwStageLink2
-
-        );
-
-        UpdateBernoulliClientProbability(mldNodeCon, mldProbLink1);
-
-        // std::cout << "Now: " << Simulator::Now() << std::endl << std::flush;
-        // std::cout << "stepSize: " << stepSize << std::endl << std::flush;
-
-        WifiTxStatsHelper wifiTxStats;
-        WifiPhyRxTraceHelper wifiStats;
-        wifiTxStats.Enable(allNetDevices);
-        wifiStats.Enable(allNodeCon);
-
-        wifiTxStats.Start(Seconds(0.05));
-        wifiTxStats.Stop(Seconds(stepSize));
-
+            acVOCwminLink2, acVOCwStageLink2,
+            mldTrafficParams, fastStart, crnRuns);
+        edcaTxops = ResolveEdcaTxops(allNetDevices, 2);
+        EnableStats(wifiTxStats, wifiStats, allNetDevices, allNodeCon, printTxStats);
+        profiler.AddTimeSince(profSetup, start);
+    };
+
+    // simulate a step with the current parameters
+    auto simulateStep = [&]() {
+        uint64_t start = profiler.Now();
+        // only the CWs that changed since the last step are set
+        ApplyCw(edcaTxops, AC_BE, 0, acBECwminLink1, acBECwStageLink1);
+        ApplyCw(edcaTxops, AC_BK, 0, acBKCwminLink1, acBKCwStageLink1);
+        ApplyCw(edcaTxops, AC_VI, 0, acVICwminLink1, acVICwStageLink1);
+        ApplyCw(edcaTxops, AC_VO, 0, acVOCwminLink1, acVOCwStageLink1);
+        ApplyCw(edcaTxops, AC_BE, 1, acBECwminLink2, acBECwStageLink2);
+        ApplyCw(edcaTxops, AC_BK, 1, acBKCwminLink2, acBKCwStageLink2);
+        ApplyCw(edcaTxops, AC_VI, 1, acVICwminLink2, acVICwStageLink2);
+        ApplyCw(edcaTxops, AC_VO, 1, acVOCwminLink2, acVOCwStageLink2);
+
+        // picked up by every MLD client at its next packet
+        mldTrafficParams->m_bernoulliPr = mldPerNodeLambda;
+        mldTrafficParams->m_optionalTidPr = 1 - mldProbLink1;
+        profiler.AddTimeSince(profCwConfig, start);
+
+        wifiTxStats->Start(Seconds(0.05));
+        wifiTxStats->Stop(Seconds(stepSize));
 
         // RX stats
-        wifiStats.Start(Seconds(0.05));
-        wifiStats.Stop(Seconds(stepSize));
+        wifiStats->Start(Seconds(0.05));
+        wifiStats->Stop(Seconds(stepSize));
 
         // LogComponentEnable("Simulator", LOG_LEVEL_INFO);
         // Config::Connect ("/NodeList/*/$ns3::ApplicationList/*/Rx", MakeCallback(&EventCallback));
 
-
-
-        // if (printRxStats)
-        // {
-        //     Simulator::Schedule(Seconds(5 + simulationTime), &CheckStats);
-        // }
-
         // mldPhyHelp.EnablePcap("single-bss-coex", allNetDevices);
         // AsciiTraceHelper asciiTrace;
         // mldPhyHelp.EnableAsciiAll(asciiTrace.CreateFileStream("single-bss-coex.tr"));
 
+        start = profiler.Now();
+        uint64_t events = Simulator::GetEventCount();
         Simulator::Stop(Seconds(stepSize));
         Simulator::Run();
+        profiler.AddTimeSince(profSimRun, start);
+        profiler.Add(profSimEvents, Simulator::GetEventCount() - events);
+    };
+
+    // With the step cache, the simulator only runs the steps missing from the
+    // cache. The steps served from it since the last simulated one are kept, and
+    // simulated before the next missing one to bring the scenario to its state;
+    // so is the rebuild of the scenario for a new episode.
+    std::string stepHistory; // hash of the actions since the start of the episode
+    std::vector<ActStruct> pendingActions;
+    std::optional<ActStruct> deferredRebuild;
 
-        // std::cout << "Now (After): " << Simulator::Now() << std::endl << std::flush;
-
+    while (loop)
+    {
 
+        // std::cout << "simulationTime: " << simulationTime << std::endl << std::flush;
 
-        auto finalResults = wifiTxStats.GetStatistics();
-        auto successInfo = wifiTxStats.GetSuccessInfoMap();
+        uint64_t stepStart = profiler.Now();
+        if (!resumeEpisode)
+        {
+            uint64_t waitNs = msgInterface->GetCppRecvWait().m_waitNs;
+            msgInterface->CppRecvBegin();
+            profiler.Add(profRecvWait, msgInterface->GetCppRecvWait().m_waitNs - waitNs);
+        }
+        ActStruct act = *msgInterface->GetPy2CppStruct();
+        if (!resumeEpisode)
+        {
+            msgInterface->CppRecvEnd();
+        }
+        bool end_experiment = act.act_end_experiment;
+        bool done_simulation = act.act_done_simulation;
+        applyAction(act);
+        if (act.act_obsMask != 0)
+        {
+            obsMask = act.act_obsMask;
+        }
 
-        // total and mean delay calculation per node and link
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, std::vector<double> > >
-            enqueueTimeMap;
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, std::vector<double> > >
-            dequeueTimeMap;
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, std::vector<double> > >
-            holTimeMap;
-        for (const auto& nodeMap : successInfo)
+        if (trajectoryPending)
         {
-            for (const auto& linkMap : nodeMap.second)
-            {
-                for (const auto& record : linkMap.second)
-                {
-                    enqueueTimeMap[nodeMap.first][linkMap.first].emplace_back(record.m_enqueueMs);
-                    dequeueTimeMap[nodeMap.first][linkMap.first].emplace_back(record.m_dequeueMs);
-                }
-                for (uint32_t i = 0; i < enqueueTimeMap[nodeMap.first][linkMap.first].size(); ++i)
-                {
-                    if (i == 0)
-                    {
-                        // This value is false (some data packet may be already in queue
-                        // because our stats did not start at 0 second), and will be removed later
-                        holTimeMap[nodeMap.first][linkMap.first].emplace_back(
-                            enqueueTimeMap[nodeMap.first][linkMap.first][i]);
-                    }
-                    else
-                    {
-                        holTimeMap[nodeMap.first][linkMap.first].emplace_back(
-                            std::max(enqueueTimeMap[nodeMap.first][linkMap.first][i],
-                                    dequeueTimeMap[nodeMap.first][linkMap.first][i - 1]));
-                    }
-                }
-                // remove the first element
-                enqueueTimeMap[nodeMap.first][linkMap.first].erase(
-                    enqueueTimeMap[nodeMap.first][linkMap.first].begin());
-                dequeueTimeMap[nodeMap.first][linkMap.first].erase(
-                    dequeueTimeMap[nodeMap.first][linkMap.first].begin());
-                holTimeMap[nodeMap.first][linkMap.first].erase(
-                    holTimeMap[nodeMap.first][linkMap.first].begin());
-            }
+            trajectory.Record(trajectoryEpisode,
+                              trajectoryStep++,
+                              lastEnv,
+                              act,
+                              lastEnv.env_mldThptTotal,
+                              done_simulation || end_experiment);
+            trajectoryPending = false;
         }
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, double> >
-            totalQueuingDelayPerNodeLink;
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, double> >
-            meanQueuingDelayPerNodeLink;
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, double> >
-            totalAccessDelayPerNodeLink;
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, double> >
-            meanAccessDelayPerNodeLink;
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, std::vector<double> > >
-            accessDelaysPerNodeLink;
-        std::map<uint32_t /* Node ID */, std::map<uint8_t /* Link ID */, std::vector<double> > >
-            e2eDelaysPerNodeLink;
-        for (const auto& nodeMap : successInfo)
+        if (done_simulation && trajectoryStep > 0)
         {
-            for (const auto& linkMap : nodeMap.second)
-            {
-                for (uint32_t i = 0; i < enqueueTimeMap[nodeMap.first][linkMap.first].size(); ++i)
-                {
-                    totalQueuingDelayPerNodeLink[nodeMap.first][linkMap.first] += holTimeMap[nodeMap.
-                        first][linkMap.first][i] - enqueueTimeMap[nodeMap.first][
-                        linkMap.first][i];
-                    totalAccessDelayPerNodeLink[nodeMap.first][linkMap.first] += dequeueTimeMap[nodeMap.
-                        first][linkMap.first][i] - holTimeMap[nodeMap.first][linkMap.
-                        first][i];
-                    accessDelaysPerNodeLink[nodeMap.first][linkMap.first].emplace_back(
-                        dequeueTimeMap[nodeMap.first][linkMap.first][i]
-                        - holTimeMap[nodeMap.first][linkMap.first][i]);
-                    e2eDelaysPerNodeLink[nodeMap.first][linkMap.first].emplace_back(
-                        dequeueTimeMap[nodeMap.first][linkMap.first][i]
-                        - enqueueTimeMap[nodeMap.first][linkMap.first][i]);
-                }
-                meanQueuingDelayPerNodeLink[nodeMap.first][linkMap.first] =
-                    totalQueuingDelayPerNodeLink[nodeMap.first][linkMap.first] / (finalResults.
-                        m_numSuccessPerNodeLink[nodeMap.first][linkMap.first] - 1);
-                meanAccessDelayPerNodeLink[nodeMap.first][linkMap.first] =
-                    totalAccessDelayPerNodeLink[nodeMap.first][linkMap.first] / (finalResults.
-                        m_numSuccessPerNodeLink[nodeMap.first][linkMap.first] - 1);
-            }
+            trajectoryEpisode++;
+            trajectoryStep = 0;
         }
 
-        if (printTxStats)
+        if (end_experiment){
+            loop = false;
+            break;
+        }
+        else if (done_simulation && resumeEpisode)
         {
-            std::cout << "TX Stats:\n";
-            std::cout << "Node_ID\tLink_ID\t#Success\n";
-            for (const auto& nodeMap : finalResults.m_numSuccessPerNodeLink)
-            {
-                for (const auto& linkMap : nodeMap.second)
-                {
-                    std::cout << nodeMap.first << "\t\t"
-                        << +linkMap.first << "\t\t"
-                        << linkMap.second << "\n";
-                }
-            }
-            std::cout << "Node_ID\tLink_ID\tMean_Queuing_Delay\n";
-            for (const auto& nodeMap : meanQueuingDelayPerNodeLink)
+            // a fork server child, already in the warm state, which is only the state a
+            // rebuild would reach if the action keeps the parameters it was built with
+            NS_ABORT_MSG_IF(setupParams() != warmSetupParams,
+                            "With --forkServer, the action ending an episode must keep the "
+                            "simulationTime, mldPerNodeLambda, mldProbLink1 and contention "
+                            "windows of the command line");
+            resumeEpisode = false;
+        }
+        else if (done_simulation && forkServer)
+        {
+            g_fileSummary.close();
+            results.reset();
+            trajectory.Close();
+            std::cout.flush();
+            _exit(FORK_EPISODE_DONE);
+        }
+        else if (done_simulation && surrogate)
+        {
+            // nothing to rebuild, the model has no state
+            stepNumber = 0;
+        }
+        else if (done_simulation){
+            // std::cout << "Done Triggered!" << std::endl << std::flush;
+            if (stepCache)
             {
-                for (const auto& linkMap : nodeMap.second)
-                {
-                    std::cout << nodeMap.first << "\t\t"
-                        << +linkMap.first << "\t\t"
-                        << linkMap.second << "\n";
-                }
+                // deferred to the first step missing from the cache
+                episodeKey = scenarioKey();
+                deferredRebuild = act;
             }
-            std::cout << "Node_ID\tLink_ID\tMean_Access_Delay\n";
-            for (const auto& nodeMap : meanAccessDelayPerNodeLink)
+            else
             {
-                for (const auto& linkMap : nodeMap.second)
-                {
-                    std::cout << nodeMap.first << "\t\t"
-                        << +linkMap.first << "\t\t"
-                        << linkMap.second << "\n";
-                }
+                rebuild();
             }
-            std::cout << "Summary:"
-                << "\n1. Successful pkts: " << finalResults.m_numSuccess
-                << "\n2. Successful and retransmitted pkts: " << finalResults.m_numRetransmitted
-                << "\n3. Avg retransmissions per successful pkt: " << finalResults.m_avgFailures
-                << "\n4. Failed pkts: " << finalResults.m_numFinalFailed
-                << "\n";
+
+            stepNumber= 0;
+
+            // WifiTxStatsHelper wifiTxStats;
+            // WifiPhyRxTraceHelper wifiStats;
+            // wifiTxStats.Enable(allNetDevices);
+
+            // wifiStats.Enable(allNodeCon);
+
+            // Simulator::Stop(Seconds(5));
+            // Simulator::Run();
         }
 
-        // MLD's per link and total successful tx pr
-        std::map<uint8_t /* Link ID */, uint64_t> numMldSuccessPerLink;
-        std::map<uint8_t /* Link ID */, uint64_t> numMldAttemptsPerLink;
-        uint64_t numMldSuccessTotal{0};
-        uint64_t numMldAttemptsTotal{0};
-        for (uint32_t i = 1; i < 1 + nMldSta; ++i)
+        // Only compute and report what Python subscribed to; the summary and results files
+        // and the step cache get every statistic of the step
+        uint64_t mask = obsMask;
+
+        // A step is served from the cache when the same scenario, seed and actions
+        // were already simulated, by this run or another one
+        bool cacheHit = false;
+        std::string stepKey;
+        EnvStruct cachedStats;
+        if (stepCache)
         {
-            const auto& linkMap = successInfo[i];
-            for (const auto& records : linkMap)
+            if (done_simulation)
             {
-                for (const auto& pkt : records.second)
-                {
-                    numMldSuccessPerLink[records.first] += 1;
-                    numMldAttemptsPerLink[records.first] += 1 + pkt.m_failures;
-                    numMldSuccessTotal += 1;
-                    numMldAttemptsTotal += 1 + pkt.m_failures;
-                }
+                stepHistory.clear();
+                pendingActions.clear();
             }
+            stepHistory = StepCache::Hash(stepHistory + "|" + StepCacheActionKey(act));
+            stepKey = episodeKey + "|" + stepHistory;
+            uint64_t start = profiler.Now();
+            cacheHit = stepCache->Lookup(stepKey, cachedStats);
+            profiler.AddTimeSince(profCache, start);
         }
 
-
-        // std::cout << "numMldAttemptsTotal: " << numMldAttemptsTotal << std::endl << std::flush;
-        // std::cout << "numMldSuccessTotal: " << numMldSuccessTotal << std::endl << std::flush;
-        // std::cout << "\n" << std::flush;
-
-
-        double mldSuccPrTotal = static_cast<long double>(numMldSuccessTotal) / numMldAttemptsTotal;
-        double mldSuccPrLink1 = static_cast<long double>(numMldSuccessPerLink[0]) /
-                                numMldAttemptsPerLink[0];
-        double mldSuccPrLink2 = static_cast<long double>(numMldSuccessPerLink[1]) /
-                                numMldAttemptsPerLink[1];
-
-        // throughput of MLD
-        double mldThptTotal = static_cast<long double>(numMldSuccessTotal) * payloadSize * 8 /
-                            simulationTime /
-                            1000000;
-        double mldThptLink1 = static_cast<long double>(numMldSuccessPerLink[0]) * payloadSize * 8 /
-                            simulationTime /
-                            1000000;
-        double mldThptLink2 = static_cast<long double>(numMldSuccessPerLink[1]) * payloadSize * 8 /
-                            simulationTime /
-                            1000000;
-
-        // mean delays of MLD
-        std::map<uint8_t /* Link ID */, long double> mldQueDelayPerLinkTotal;
-        long double mldQueDelayTotal{0};
-        std::map<uint8_t /* Link ID */, long double> mldAccDelayPerLinkTotal;
-        long double mldAccDelayTotal{0};
-        for (uint32_t i = 1; i < 1 + nMldSta; ++i)
+        // statistics of the step, simulated, cached or given by the surrogate model
+        double mldSuccPrLink1, mldSuccPrLink2, mldSuccPrTotal;
+        double mldThptLink1, mldThptLink2, mldThptTotal;
+        double mldMeanQueDelayLink1, mldMeanQueDelayLink2, mldMeanQueDelayTotal;
+        double mldMeanAccDelayLink1, mldMeanAccDelayLink2, mldMeanAccDelayTotal;
+        double mldMeanE2eDelayLink1, mldMeanE2eDelayLink2, mldMeanE2eDelayTotal;
+        double mldSecondRawMomentAccDelayLink1, mldSecondRawMomentAccDelayLink2;
+        double mldSecondRawMomentAccDelayTotal;
+        double mldSecondCentralMomentAccDelayLink1, mldSecondCentralMomentAccDelayLink2;
+        double mldSecondCentralMomentAccDelayTotal;
+        double mldP95AccDelayLink1, mldP95AccDelayLink2, mldP95AccDelayTotal;
+        double mldP95E2eDelayLink1, mldP95E2eDelayLink2, mldP95E2eDelayTotal;
+        double mldP99AccDelayLink1, mldP99AccDelayLink2, mldP99AccDelayTotal;
+        double mldP99E2eDelayLink1, mldP99E2eDelayLink2, mldP99E2eDelayTotal;
+        if (surrogate)
+        {
+            MloSurrogateConfig surrogateConfig;
+            surrogateConfig.m_nMldSta = nMldSta;
+            surrogateConfig.m_mldPerNodeLambda = mldPerNodeLambda;
+            surrogateConfig.m_mldProbLink1 = mldProbLink1;
+            surrogateConfig.m_payloadSize = payloadSize;
+            surrogateConfig.m_duration = stepSize;
+            // persistent retransmissions and an unbounded queue, as set up for the simulation
+            surrogateConfig.m_retryLimit = MloSurrogateConfig::UNLIMITED_RETRIES;
+            surrogateConfig.m_maxQueueSize = std::numeric_limits<uint32_t>::max();
+            surrogateConfig.m_maxQueueDelay = MAC_QUEUE_MAX_DELAY;
+            // (CWmin, stage) of each AC on each link, in AcIndex order
+            std::array<std::pair<uint64_t, uint8_t>, 4> cwsLink1 = {
+                {{acBECwminLink1, acBECwStageLink1},
+                 {acBKCwminLink1, acBKCwStageLink1},
+                 {acVICwminLink1, acVICwStageLink1},
+                 {acVOCwminLink1, acVOCwStageLink1}}};
+            std::array<std::pair<uint64_t, uint8_t>, 4> cwsLink2 = {
+                {{acBECwminLink2, acBECwStageLink2},
+                 {acBKCwminLink2, acBKCwStageLink2},
+                 {acVICwminLink2, acVICwStageLink2},
+                 {acVOCwminLink2, acVOCwStageLink2}}};
+            surrogateConfig.m_links[0] =
+                SurrogateLinkConfig(mcs, channelWidth, mldAcLink1Int, cwsLink1);
+            surrogateConfig.m_links[1] =
+                SurrogateLinkConfig(mcs2, channelWidth2, mldAcLink2Int, cwsLink2);
+            const auto& link = surrogateModel.Solve(surrogateConfig);
+
+            // the totals weigh the links by their successful pkts, as the simulated ones;
+            // the throughput is computed as for the simulation, from the pkts of the step
+            double successRateTotal = link[0].m_successRate + link[1].m_successRate;
+            auto total = [&](double valueLink1, double valueLink2) {
+                return (link[0].m_successRate * valueLink1 + link[1].m_successRate * valueLink2) /
+                       successRateTotal;
+            };
+            mldSuccPrLink1 = link[0].m_succPr;
+            mldSuccPrLink2 = link[1].m_succPr;
+            mldSuccPrTotal = successRateTotal / (link[0].m_successRate / link[0].m_succPr +
+                                                 link[1].m_successRate / link[1].m_succPr);
+            mldThptLink1 = link[0].m_successRate * stepSize * payloadSize * 8 / simulationTime /
+                           1000000;
+            mldThptLink2 = link[1].m_successRate * stepSize * payloadSize * 8 / simulationTime /
+                           1000000;
+            mldThptTotal = mldThptLink1 + mldThptLink2;
+            mldMeanQueDelayLink1 = link[0].m_meanQueDelayMs;
+            mldMeanQueDelayLink2 = link[1].m_meanQueDelayMs;
+            mldMeanQueDelayTotal = total(mldMeanQueDelayLink1, mldMeanQueDelayLink2);
+            mldMeanAccDelayLink1 = link[0].m_meanAccDelayMs;
+            mldMeanAccDelayLink2 = link[1].m_meanAccDelayMs;
+            mldMeanAccDelayTotal = total(mldMeanAccDelayLink1, mldMeanAccDelayLink2);
+            mldMeanE2eDelayLink1 = mldMeanQueDelayLink1 + mldMeanAccDelayLink1;
+            mldMeanE2eDelayLink2 = mldMeanQueDelayLink2 + mldMeanAccDelayLink2;
+            mldMeanE2eDelayTotal = mldMeanQueDelayTotal + mldMeanAccDelayTotal;
+            mldSecondRawMomentAccDelayLink1 = link[0].m_secondRawMomentAccDelayMs2;
+            mldSecondRawMomentAccDelayLink2 = link[1].m_secondRawMomentAccDelayMs2;
+            mldSecondRawMomentAccDelayTotal =
+                total(mldSecondRawMomentAccDelayLink1, mldSecondRawMomentAccDelayLink2);
+            // within-link variances, as the simulated total
+            mldSecondCentralMomentAccDelayLink1 = link[0].m_secondCentralMomentAccDelayMs2;
+            mldSecondCentralMomentAccDelayLink2 = link[1].m_secondCentralMomentAccDelayMs2;
+            mldSecondCentralMomentAccDelayTotal =
+                total(mldSecondCentralMomentAccDelayLink1, mldSecondCentralMomentAccDelayLink2);
+            // the model only gives the first two moments of the delays
+            mldP95AccDelayLink1 = mldP95AccDelayLink2 = mldP95AccDelayTotal =
+                std::numeric_limits<double>::quiet_NaN();
+            mldP95E2eDelayLink1 = mldP95E2eDelayLink2 = mldP95E2eDelayTotal =
+                std::numeric_limits<double>::quiet_NaN();
+            mldP99AccDelayLink1 = mldP99AccDelayLink2 = mldP99AccDelayTotal =
+                std::numeric_limits<double>::quiet_NaN();
+            mldP99E2eDelayLink1 = mldP99E2eDelayLink2 = mldP99E2eDelayTotal =
+                std::numeric_limits<double>::quiet_NaN();
+        }
+        else if (cacheHit)
+        {
+#define APB_LOAD_STAT(name) name = cachedStats.env_##name;
+            APB_STEP_STATS(APB_LOAD_STAT)
+#undef APB_LOAD_STAT
+            pendingActions.push_back(act);
+        }
+        else
         {
-            const auto& queLinkMap = totalQueuingDelayPerNodeLink[i];
-            for (const auto& item : queLinkMap)
+            if (deferredRebuild)
             {
-                mldQueDelayPerLinkTotal[item.first] += item.second;
-                mldQueDelayTotal += item.second;
+                applyAction(*deferredRebuild);
+                rebuild();
+                deferredRebuild.reset();
             }
-            const auto& accLinkMap = totalAccessDelayPerNodeLink[i];
-            for (const auto& item : accLinkMap)
+            // catch up on the steps served from the cache
+            for (const auto& pending : pendingActions)
             {
-                mldAccDelayPerLinkTotal[item.first] += item.second;
-                mldAccDelayTotal += item.second;
+                applyAction(pending);
+                simulateStep();
+                wifiTxStats->AdvanceEpoch();
+                wifiStats->Reset();
             }
-        }
-        double mldMeanQueDelayTotal = mldQueDelayTotal / numMldSuccessTotal;
-        double mldMeanQueDelayLink1 = mldQueDelayPerLinkTotal[0] / numMldSuccessPerLink[0];
-        double mldMeanQueDelayLink2 = mldQueDelayPerLinkTotal[1] / numMldSuccessPerLink[1];
-        double mldMeanAccDelayTotal = mldAccDelayTotal / numMldSuccessTotal;
-        double mldMeanAccDelayLink1 = mldAccDelayPerLinkTotal[0] / numMldSuccessPerLink[0];
-        double mldMeanAccDelayLink2 = mldAccDelayPerLinkTotal[1] / numMldSuccessPerLink[1];
-        // Second raw moment of access delay: mean of (D_a)^2
-        // Second central moment (variance) of access delay: mean of (D_a - mean)^2
-        std::map<uint8_t /* Link ID */, long double> mldAccDelaySquarePerLinkTotal;
-        long double mldAccDelaySquareTotal{0};
-        std::map<uint8_t /* Link ID */, long double> mldAccDelayCentralSquarePerLinkTotal;
-        long double mldAccDelayCentralSquareTotal{0};
-        for (uint32_t i = 1; i < 1 + nMldSta; ++i)
-        {
-            const auto& accLinkMap = accessDelaysPerNodeLink[i];
-            for (const auto& linkAccVec : accLinkMap)
+            pendingActions.clear();
+            applyAction(act);
+
+            // std::cout << "Now: " << Simulator::Now() << std::endl << std::flush;
+            // std::cout << "stepSize: " << stepSize << std::endl << std::flush;
+
+            simulateStep();
+            uint64_t statsStart = profiler.Now();
+
+            // std::cout << "Now (After): " << Simulator::Now() << std::endl << std::flush;
+
+            // the results of this step; the pkts in flight are carried to the next one
+            const auto& txStatsEpoch = wifiTxStats->AdvanceEpoch();
+
+            if (printTxStats)
+            {
+                PrintTxStats(txStatsEpoch);
+            }
+
+            const auto& accumulators = txStatsEpoch.m_accumulatorMap;
+
+            // MLD's per link and total successful tx, attempts and delays, from the running
+            // per node/link statistics of the TX stats sink. The access delay variances of
+            // the nodes are merged per link (Chan et al.), around the mean delay of the link.
+            std::map<uint8_t /* Link ID */, uint64_t> numMldSuccessPerLink;
+            std::map<uint8_t /* Link ID */, uint64_t> numMldAttemptsPerLink;
+            uint64_t numMldSuccessTotal{0};
+            uint64_t numMldAttemptsTotal{0};
+            std::map<uint8_t /* Link ID */, long double> mldQueDelayPerLinkTotal;
+            long double mldQueDelayTotal{0};
+            std::map<uint8_t /* Link ID */, long double> mldAccDelayPerLinkTotal;
+            long double mldAccDelayTotal{0};
+            std::map<uint8_t /* Link ID */, long double> mldAccDelaySquarePerLinkTotal;
+            long double mldAccDelaySquareTotal{0};
+            std::map<uint8_t /* Link ID */, WifiTxDelayAccumulator> mldAccDelayPerLink;
+            // only the accumulators behind the subscribed statistics are updated, unless
+            // every statistic is written to the summary or results file or may be needed by
+            // a later lookup of the step in the cache; the counts are always summed, as the
+            // denominators of every statistic
+            bool allStats = stepCache || results || printTxStatsSingleLine;
+            bool sumQueDelay =
+                allStats || (mask & (OBS_MEAN_QUE_DELAY_ALL | OBS_MEAN_E2E_DELAY_ALL));
+            bool sumAccDelay =
+                allStats || (mask & (OBS_MEAN_ACC_DELAY_ALL | OBS_MEAN_E2E_DELAY_ALL));
+            bool sumAccDelaySquare = allStats || (mask & OBS_SECOND_RAW_MOMENT_ACC_DELAY_ALL);
+            bool mergeAccDelayM2 = allStats || (mask & OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_ALL);
+            bool mergeSketches =
+                allStats ||
+                (mask & (OBS_P95_ACC_DELAY_ALL | OBS_P95_E2E_DELAY_ALL | OBS_P99_ACC_DELAY_ALL |
+                         OBS_P99_E2E_DELAY_ALL));
+            WifiTxDelayAccumulator mldDelaySketchTotal;
+            for (uint32_t i = 1; i < 1 + nMldSta; ++i)
             {
-                const auto& accVec = linkAccVec.second;
-                auto mldMeanAccDelayLink = (linkAccVec.first == 0)
-                                            ? mldMeanAccDelayLink1
-                                            : mldMeanAccDelayLink2;
-                for (const auto& item : accVec)
+                auto nodeIt = accumulators.find(i);
+                if (nodeIt == accumulators.end())
                 {
-                    mldAccDelaySquarePerLinkTotal[linkAccVec.first] += item * item;
-                    mldAccDelaySquareTotal += item * item;
-                    mldAccDelayCentralSquarePerLinkTotal[linkAccVec.first] +=
-                        (item - mldMeanAccDelayLink) * (item - mldMeanAccDelayLink);
-                    mldAccDelayCentralSquareTotal +=
-                        (item - mldMeanAccDelayLink) * (item - mldMeanAccDelayLink);
+                    continue;
+                }
+                for (const auto& [linkId, acc] : nodeIt->second)
+                {
+                    numMldSuccessPerLink[linkId] += acc.m_numSuccess;
+                    numMldSuccessTotal += acc.m_numSuccess;
+                    numMldAttemptsPerLink[linkId] += acc.m_numAttempts;
+                    numMldAttemptsTotal += acc.m_numAttempts;
+                    if (sumQueDelay)
+                    {
+                        mldQueDelayPerLinkTotal[linkId] += acc.m_queDelaySumMs;
+                        mldQueDelayTotal += acc.m_queDelaySumMs;
+                    }
+                    if (sumAccDelay)
+                    {
+                        mldAccDelayPerLinkTotal[linkId] += acc.m_accDelaySumMs;
+                        mldAccDelayTotal += acc.m_accDelaySumMs;
+                    }
+                    if (sumAccDelaySquare)
+                    {
+                        mldAccDelaySquarePerLinkTotal[linkId] += acc.m_accDelaySquareSumMs2;
+                        mldAccDelaySquareTotal += acc.m_accDelaySquareSumMs2;
+                    }
+                    if (acc.m_numDelaySamples == 0 || !(mergeSketches || mergeAccDelayM2))
+                    {
+                        continue;
+                    }
+                    auto& link = mldAccDelayPerLink[linkId];
+                    if (mergeSketches)
+                    {
+                        link.m_accDelaySketch.Merge(acc.m_accDelaySketch);
+                        link.m_e2eDelaySketch.Merge(acc.m_e2eDelaySketch);
+                        mldDelaySketchTotal.m_accDelaySketch.Merge(acc.m_accDelaySketch);
+                        mldDelaySketchTotal.m_e2eDelaySketch.Merge(acc.m_e2eDelaySketch);
+                    }
+                    if (!mergeAccDelayM2)
+                    {
+                        continue;
+                    }
+                    uint64_t n = link.m_numDelaySamples + acc.m_numDelaySamples;
+                    double delta = acc.m_accDelayMeanMs - link.m_accDelayMeanMs;
+                    double weight = static_cast<double>(link.m_numDelaySamples) *
+                                    acc.m_numDelaySamples / n;
+                    link.m_accDelayM2 += acc.m_accDelayM2 + delta * delta * weight;
+                    link.m_accDelayMeanMs += delta * acc.m_numDelaySamples / n;
+                    link.m_numDelaySamples = n;
                 }
             }
+
+            mldSuccPrTotal = static_cast<long double>(numMldSuccessTotal) / numMldAttemptsTotal;
+            mldSuccPrLink1 = static_cast<long double>(numMldSuccessPerLink[0]) /
+                             numMldAttemptsPerLink[0];
+            mldSuccPrLink2 = static_cast<long double>(numMldSuccessPerLink[1]) /
+                             numMldAttemptsPerLink[1];
+
+            // throughput of MLD
+            mldThptTotal = static_cast<long double>(numMldSuccessTotal) * payloadSize * 8 /
+                           simulationTime / 1000000;
+            mldThptLink1 = static_cast<long double>(numMldSuccessPerLink[0]) * payloadSize * 8 /
+                           simulationTime / 1000000;
+            mldThptLink2 = static_cast<long double>(numMldSuccessPerLink[1]) * payloadSize * 8 /
+                           simulationTime / 1000000;
+
+            // mean delays of MLD
+            mldMeanQueDelayTotal = mldQueDelayTotal / numMldSuccessTotal;
+            mldMeanQueDelayLink1 = mldQueDelayPerLinkTotal[0] / numMldSuccessPerLink[0];
+            mldMeanQueDelayLink2 = mldQueDelayPerLinkTotal[1] / numMldSuccessPerLink[1];
+            mldMeanAccDelayTotal = mldAccDelayTotal / numMldSuccessTotal;
+            mldMeanAccDelayLink1 = mldAccDelayPerLinkTotal[0] / numMldSuccessPerLink[0];
+            mldMeanAccDelayLink2 = mldAccDelayPerLinkTotal[1] / numMldSuccessPerLink[1];
+            // Second raw moment of access delay: mean of (D_a)^2
+            // Second central moment (variance) of access delay: mean of (D_a - mean)^2
+            mldSecondRawMomentAccDelayTotal = mldAccDelaySquareTotal / numMldSuccessTotal;
+            mldSecondRawMomentAccDelayLink1 =
+                mldAccDelaySquarePerLinkTotal[0] / numMldSuccessPerLink[0];
+            mldSecondRawMomentAccDelayLink2 =
+                mldAccDelaySquarePerLinkTotal[1] / numMldSuccessPerLink[1];
+            // the total is within-link: the delays of each link around the mean of that link
+            mldSecondCentralMomentAccDelayTotal =
+                (mldAccDelayPerLink[0].m_accDelayM2 + mldAccDelayPerLink[1].m_accDelayM2) /
+                numMldSuccessTotal;
+            mldSecondCentralMomentAccDelayLink1 =
+                mldAccDelayPerLink[0].m_accDelayM2 / numMldSuccessPerLink[0];
+            mldSecondCentralMomentAccDelayLink2 =
+                mldAccDelayPerLink[1].m_accDelayM2 / numMldSuccessPerLink[1];
+            mldMeanE2eDelayTotal = mldMeanQueDelayTotal + mldMeanAccDelayTotal;
+            mldMeanE2eDelayLink1 = mldMeanQueDelayLink1 + mldMeanAccDelayLink1;
+            mldMeanE2eDelayLink2 = mldMeanQueDelayLink2 + mldMeanAccDelayLink2;
+            // tail delays of MLD, NaN when the sketches are not merged
+            mldP95AccDelayLink1 = mldAccDelayPerLink[0].m_accDelaySketch.GetQuantile(0.95);
+            mldP95AccDelayLink2 = mldAccDelayPerLink[1].m_accDelaySketch.GetQuantile(0.95);
+            mldP95AccDelayTotal = mldDelaySketchTotal.m_accDelaySketch.GetQuantile(0.95);
+            mldP95E2eDelayLink1 = mldAccDelayPerLink[0].m_e2eDelaySketch.GetQuantile(0.95);
+            mldP95E2eDelayLink2 = mldAccDelayPerLink[1].m_e2eDelaySketch.GetQuantile(0.95);
+            mldP95E2eDelayTotal = mldDelaySketchTotal.m_e2eDelaySketch.GetQuantile(0.95);
+            mldP99AccDelayLink1 = mldAccDelayPerLink[0].m_accDelaySketch.GetQuantile(0.99);
+            mldP99AccDelayLink2 = mldAccDelayPerLink[1].m_accDelaySketch.GetQuantile(0.99);
+            mldP99AccDelayTotal = mldDelaySketchTotal.m_accDelaySketch.GetQuantile(0.99);
+            mldP99E2eDelayLink1 = mldAccDelayPerLink[0].m_e2eDelaySketch.GetQuantile(0.99);
+            mldP99E2eDelayLink2 = mldAccDelayPerLink[1].m_e2eDelaySketch.GetQuantile(0.99);
+            mldP99E2eDelayTotal = mldDelaySketchTotal.m_e2eDelaySketch.GetQuantile(0.99);
+
+            profiler.AddTimeSince(profStats, statsStart);
+
+            if (stepCache)
+            {
+                uint64_t start = profiler.Now();
+                EnvStruct computedStats{};
+#define APB_SAVE_STAT(name) computedStats.env_##name = name;
+                APB_STEP_STATS(APB_SAVE_STAT)
+#undef APB_SAVE_STAT
+                stepCache->Store(stepKey, computedStats);
+                profiler.AddTimeSince(profCache, start);
+            }
         }
-        double mldSecondRawMomentAccDelayTotal = mldAccDelaySquareTotal / numMldSuccessTotal;
-        double mldSecondRawMomentAccDelayLink1 =
-            mldAccDelaySquarePerLinkTotal[0] / numMldSuccessPerLink[0];
-        double mldSecondRawMomentAccDelayLink2 =
-            mldAccDelaySquarePerLinkTotal[1] / numMldSuccessPerLink[1];
-        double mldSecondCentralMomentAccDelayTotal = mldAccDelayCentralSquareTotal / numMldSuccessTotal;
-        double mldSecondCentralMomentAccDelayLink1 =
-            mldAccDelayCentralSquarePerLinkTotal[0] / numMldSuccessPerLink[0];
-        double mldSecondCentralMomentAccDelayLink2 =
-            mldAccDelayCentralSquarePerLinkTotal[1] / numMldSuccessPerLink[1];
-        double mldMeanE2eDelayTotal = mldMeanQueDelayTotal + mldMeanAccDelayTotal;
-        double mldMeanE2eDelayLink1 = mldMeanQueDelayLink1 + mldMeanAccDelayLink1;
-        double mldMeanE2eDelayLink2 = mldMeanQueDelayLink2 + mldMeanAccDelayLink2;
 
         stepNumber++;
 
         // std::cout << "Simulation Time 2: " << simulationTime << std::endl << std::flush;
 
+        uint64_t waitNs = msgInterface->GetCppSendWait().m_waitNs;
         msgInterface->CppSendBegin();
+        profiler.Add(profSendWait, msgInterface->GetCppSendWait().m_waitNs - waitNs);
+        uint64_t reportStart = profiler.Now();
         // std::cout << "sent: " << std::flush;
         // uint32_t temp_a = distrib(gen);
         // uint32_t temp_b = distrib(gen);
         // std::cout << temp_a << "," << temp_b << ";;" << std::flush;
         // msgInterface->GetCpp2PyStruct()->env_a = temp_a;
         // msgInterface->GetCpp2PyStruct()->env_b = temp_b;
-        msgInterface->GetCpp2PyStruct()->env_mldThptTotal = mldThptTotal;
-        msgInterface->GetCpp2PyStruct()->env_mldSuccPrLink1 = mldSuccPrLink1;
-        msgInterface->GetCpp2PyStruct()->env_mldSuccPrLink2 = mldSuccPrLink2;
-        msgInterface->GetCpp2PyStruct()->env_mldSuccPrTotal = mldSuccPrTotal;
-        msgInterface->GetCpp2PyStruct()->env_mldThptLink1 = mldThptLink1;
-        msgInterface->GetCpp2PyStruct()->env_mldThptLink2 = mldThptLink2;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanQueDelayLink1 = mldMeanQueDelayLink1;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanQueDelayLink2 = mldMeanQueDelayLink2;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanQueDelayTotal = mldMeanQueDelayTotal;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanAccDelayLink1 = mldMeanAccDelayLink1;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanAccDelayLink2 = mldMeanAccDelayLink2;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanAccDelayTotal = mldMeanAccDelayTotal;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanE2eDelayLink1 = mldMeanE2eDelayLink1;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanE2eDelayLink2 = mldMeanE2eDelayLink2;
-        msgInterface->GetCpp2PyStruct()->env_mldMeanE2eDelayTotal = mldMeanE2eDelayTotal;
-        msgInterface->GetCpp2PyStruct()->env_mldSecondRawMomentAccDelayLink1 = mldSecondRawMomentAccDelayLink1;
-        msgInterface->GetCpp2PyStruct()->env_mldSecondRawMomentAccDelayLink2 = mldSecondRawMomentAccDelayLink2;
-        msgInterface->GetCpp2PyStruct()->env_mldSecondRawMomentAccDelayTotal = mldSecondRawMomentAccDelayTotal;
-        msgInterface->GetCpp2PyStruct()->env_mldSecondCentralMomentAccDelayLink1 = mldSecondCentralMomentAccDelayLink1;
-        msgInterface->GetCpp2PyStruct()->env_mldSecondCentralMomentAccDelayLink2 = mldSecondCentralMomentAccDelayLink2;
-        msgInterface->GetCpp2PyStruct()->env_mldSecondCentralMomentAccDelayTotal = mldSecondCentralMomentAccDelayTotal;
+        msgInterface->GetCpp2PyStruct()->env_mldThptTotal =
+            Subscribed(mask, OBS_THPT_TOTAL, mldThptTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldSuccPrLink1 =
+            Subscribed(mask, OBS_SUCC_PR_LINK1, mldSuccPrLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldSuccPrLink2 =
+            Subscribed(mask, OBS_SUCC_PR_LINK2, mldSuccPrLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldSuccPrTotal =
+            Subscribed(mask, OBS_SUCC_PR_TOTAL, mldSuccPrTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldThptLink1 =
+            Subscribed(mask, OBS_THPT_LINK1, mldThptLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldThptLink2 =
+            Subscribed(mask, OBS_THPT_LINK2, mldThptLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanQueDelayLink1 =
+            Subscribed(mask, OBS_MEAN_QUE_DELAY_LINK1, mldMeanQueDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanQueDelayLink2 =
+            Subscribed(mask, OBS_MEAN_QUE_DELAY_LINK2, mldMeanQueDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanQueDelayTotal =
+            Subscribed(mask, OBS_MEAN_QUE_DELAY_TOTAL, mldMeanQueDelayTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanAccDelayLink1 =
+            Subscribed(mask, OBS_MEAN_ACC_DELAY_LINK1, mldMeanAccDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanAccDelayLink2 =
+            Subscribed(mask, OBS_MEAN_ACC_DELAY_LINK2, mldMeanAccDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanAccDelayTotal =
+            Subscribed(mask, OBS_MEAN_ACC_DELAY_TOTAL, mldMeanAccDelayTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanE2eDelayLink1 =
+            Subscribed(mask, OBS_MEAN_E2E_DELAY_LINK1, mldMeanE2eDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanE2eDelayLink2 =
+            Subscribed(mask, OBS_MEAN_E2E_DELAY_LINK2, mldMeanE2eDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldMeanE2eDelayTotal =
+            Subscribed(mask, OBS_MEAN_E2E_DELAY_TOTAL, mldMeanE2eDelayTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldSecondRawMomentAccDelayLink1 =
+            Subscribed(mask, OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK1, mldSecondRawMomentAccDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldSecondRawMomentAccDelayLink2 =
+            Subscribed(mask, OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK2, mldSecondRawMomentAccDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldSecondRawMomentAccDelayTotal =
+            Subscribed(mask, OBS_SECOND_RAW_MOMENT_ACC_DELAY_TOTAL, mldSecondRawMomentAccDelayTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldSecondCentralMomentAccDelayLink1 =
+            Subscribed(mask, OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK1, mldSecondCentralMomentAccDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldSecondCentralMomentAccDelayLink2 =
+            Subscribed(mask, OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK2, mldSecondCentralMomentAccDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldSecondCentralMomentAccDelayTotal =
+            Subscribed(mask, OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_TOTAL, mldSecondCentralMomentAccDelayTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldP95AccDelayLink1 =
+            Subscribed(mask, OBS_P95_ACC_DELAY_LINK1, mldP95AccDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldP95AccDelayLink2 =
+            Subscribed(mask, OBS_P95_ACC_DELAY_LINK2, mldP95AccDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldP95AccDelayTotal =
+            Subscribed(mask, OBS_P95_ACC_DELAY_TOTAL, mldP95AccDelayTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldP95E2eDelayLink1 =
+            Subscribed(mask, OBS_P95_E2E_DELAY_LINK1, mldP95E2eDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldP95E2eDelayLink2 =
+            Subscribed(mask, OBS_P95_E2E_DELAY_LINK2, mldP95E2eDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldP95E2eDelayTotal =
+            Subscribed(mask, OBS_P95_E2E_DELAY_TOTAL, mldP95E2eDelayTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldP99AccDelayLink1 =
+            Subscribed(mask, OBS_P99_ACC_DELAY_LINK1, mldP99AccDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldP99AccDelayLink2 =
+            Subscribed(mask, OBS_P99_ACC_DELAY_LINK2, mldP99AccDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldP99AccDelayTotal =
+            Subscribed(mask, OBS_P99_ACC_DELAY_TOTAL, mldP99AccDelayTotal);
+        msgInterface->GetCpp2PyStruct()->env_mldP99E2eDelayLink1 =
+            Subscribed(mask, OBS_P99_E2E_DELAY_LINK1, mldP99E2eDelayLink1);
+        msgInterface->GetCpp2PyStruct()->env_mldP99E2eDelayLink2 =
+            Subscribed(mask, OBS_P99_E2E_DELAY_LINK2, mldP99E2eDelayLink2);
+        msgInterface->GetCpp2PyStruct()->env_mldP99E2eDelayTotal =
+            Subscribed(mask, OBS_P99_E2E_DELAY_TOTAL, mldP99E2eDelayTotal);
         msgInterface->GetCpp2PyStruct()->env_rngRun = rngRun;
         msgInterface->GetCpp2PyStruct()->env_simulationTime = simulationTime;
         msgInterface->GetCpp2PyStruct()->env_payloadSize = payloadSize;
@@ -1215,6 +2070,11 @@ int RunSimulation(int argc, char *argv[]) {
         msgInterface->GetCpp2PyStruct()->env_acVOCwminLink2 = acVOCwminLink2;
         msgInterface->GetCpp2PyStruct()->env_acVOCwStageLink2 = acVOCwStageLink2;
         msgInterface->GetCpp2PyStruct()->env_stepNumber = stepNumber;
+        if (trajectory.IsOpen())
+        {
+            lastEnv = *msgInterface->GetCpp2PyStruct();
+            trajectoryPending = true;
+        }
         msgInterface->CppSendEnd();
 
 
@@ -1249,13 +2109,95 @@ int RunSimulation(int argc, char *argv[]) {
                 << acVICwminLink2 << "," << +acVICwStageLink2 << ","
                 << acVOCwminLink2 << "," << +acVOCwStageLink2 << "\n";
         }
+        if (results)
+        {
+            results->Append("stepNumber", stepNumber);
+            results->Append("mldSuccPrLink1", mldSuccPrLink1);
+            results->Append("mldSuccPrLink2", mldSuccPrLink2);
+            results->Append("mldSuccPrTotal", mldSuccPrTotal);
+            results->Append("mldThptLink1", mldThptLink1);
+            results->Append("mldThptLink2", mldThptLink2);
+            results->Append("mldThptTotal", mldThptTotal);
+            results->Append("mldMeanQueDelayLink1", mldMeanQueDelayLink1);
+            results->Append("mldMeanQueDelayLink2", mldMeanQueDelayLink2);
+            results->Append("mldMeanQueDelayTotal", mldMeanQueDelayTotal);
+            results->Append("mldMeanAccDelayLink1", mldMeanAccDelayLink1);
+            results->Append("mldMeanAccDelayLink2", mldMeanAccDelayLink2);
+            results->Append("mldMeanAccDelayTotal", mldMeanAccDelayTotal);
+            results->Append("mldMeanE2eDelayLink1", mldMeanE2eDelayLink1);
+            results->Append("mldMeanE2eDelayLink2", mldMeanE2eDelayLink2);
+            results->Append("mldMeanE2eDelayTotal", mldMeanE2eDelayTotal);
+            results->Append("mldSecondRawMomentAccDelayLink1", mldSecondRawMomentAccDelayLink1);
+            results->Append("mldSecondRawMomentAccDelayLink2", mldSecondRawMomentAccDelayLink2);
+            results->Append("mldSecondRawMomentAccDelayTotal", mldSecondRawMomentAccDelayTotal);
+            results->Append("mldSecondCentralMomentAccDelayLink1", mldSecondCentralMomentAccDelayLink1);
+            results->Append("mldSecondCentralMomentAccDelayLink2", mldSecondCentralMomentAccDelayLink2);
+            results->Append("mldSecondCentralMomentAccDelayTotal", mldSecondCentralMomentAccDelayTotal);
+            results->Append("mldP95AccDelayLink1", mldP95AccDelayLink1);
+            results->Append("mldP95AccDelayLink2", mldP95AccDelayLink2);
+            results->Append("mldP95AccDelayTotal", mldP95AccDelayTotal);
+            results->Append("mldP95E2eDelayLink1", mldP95E2eDelayLink1);
+            results->Append("mldP95E2eDelayLink2", mldP95E2eDelayLink2);
+            results->Append("mldP95E2eDelayTotal", mldP95E2eDelayTotal);
+            results->Append("mldP99AccDelayLink1", mldP99AccDelayLink1);
+            results->Append("mldP99AccDelayLink2", mldP99AccDelayLink2);
+            results->Append("mldP99AccDelayTotal", mldP99AccDelayTotal);
+            results->Append("mldP99E2eDelayLink1", mldP99E2eDelayLink1);
+            results->Append("mldP99E2eDelayLink2", mldP99E2eDelayLink2);
+            results->Append("mldP99E2eDelayTotal", mldP99E2eDelayTotal);
+            results->Append("rngRun", rngRun);
+            results->Append("simulationTime", simulationTime);
+            results->Append("payloadSize", payloadSize);
+            results->Append("mcs", mcs);
+            results->Append("mcs2", mcs2);
+            results->Append("channelWidth", channelWidth);
+            results->Append("channelWidth2", channelWidth2);
+            results->Append("nMldSta", nMldSta);
+            results->Append("mldPerNodeLambda", mldPerNodeLambda);
+            results->Append("mldProbLink1", mldProbLink1);
+            results->Append("mldAcLink1Int", mldAcLink1Int);
+            results->Append("mldAcLink2Int", mldAcLink2Int);
+            results->Append("acBECwminLink1", acBECwminLink1);
+            results->Append("acBECwStageLink1", acBECwStageLink1);
+            results->Append("acBKCwminLink1", acBKCwminLink1);
+            results->Append("acBKCwStageLink1", acBKCwStageLink1);
+            results->Append("acVICwminLink1", acVICwminLink1);
+            results->Append("acVICwStageLink1", acVICwStageLink1);
+            results->Append("acVOCwminLink1", acVOCwminLink1);
+            results->Append("acVOCwStageLink1", acVOCwStageLink1);
+            results->Append("acBECwminLink2", acBECwminLink2);
+            results->Append("acBECwStageLink2", acBECwStageLink2);
+            results->Append("acBKCwminLink2", acBKCwminLink2);
+            results->Append("acBKCwStageLink2", acBKCwStageLink2);
+            results->Append("acVICwminLink2", acVICwminLink2);
+            results->Append("acVICwStageLink2", acVICwStageLink2);
+            results->Append("acVOCwminLink2", acVOCwminLink2);
+            results->Append("acVOCwStageLink2", acVOCwStageLink2);
+            results->EndRow();
+        }
 
-        wifiTxStats.Reset();
-        wifiStats.Reset();
+        if (wifiStats)
+        {
+            wifiStats->Reset();
+        }
+        profiler.AddTimeSince(profReport, reportStart);
+        profiler.AddTimeSince(profStep, stepStart);
+        profiler.EndStep();
 
 
+    }
+    if (profile)
+    {
+        profiler.Print(std::cout);
+    }
+    if (stepCache)
+    {
+        NS_LOG_INFO("Step cache: " << stepCache->GetNumHits() << " hits, "
+                                   << stepCache->GetNumMisses() << " misses");
     }
     g_fileSummary.close();
+    results.reset();
+    trajectory.Close();
 
     Simulator::Destroy();
     return 0;
@@ -47,6 +47,18 @@ struct EnvStruct
     double env_mldSecondCentralMomentAccDelayLink1;
     double env_mldSecondCentralMomentAccDelayLink2;
     double env_mldSecondCentralMomentAccDelayTotal;
+    double env_mldP95AccDelayLink1;
+    double env_mldP95AccDelayLink2;
+    double env_mldP95AccDelayTotal;
+    double env_mldP95E2eDelayLink1;
+    double env_mldP95E2eDelayLink2;
+    double env_mldP95E2eDelayTotal;
+    double env_mldP99AccDelayLink1;
+    double env_mldP99AccDelayLink2;
+    double env_mldP99AccDelayTotal;
+    double env_mldP99E2eDelayLink1;
+    double env_mldP99E2eDelayLink2;
+    double env_mldP99E2eDelayTotal;
     uint32_t env_rngRun;
     double env_simulationTime;
     uint32_t env_payloadSize;
@@ -90,7 +102,76 @@ struct ActStruct
     double act_mldPerNodeLambda;
     uint64_t act_totalSteps;
     double act_mldProbLink1;
+    uint64_t act_obsMask; //!< statistics to send (EnvObsMaskBit), 0 keeps the last mask
+};
 
+/**
+ * Bits of ActStruct::act_obsMask, one per statistic of EnvStruct. The
+ * statistics that are not subscribed are sent as NaN, and the per-node
+ * accumulators behind them (delay sums, access delay variances and delay
+ * sketches) are not merged, unless the step cache, the results file or the
+ * single-line summary needs every statistic. Python sends the mask once (any
+ * later nonzero mask replaces it, see apb_obs.obs_mask); until then, every
+ * statistic is sent.
+ */
+enum EnvObsMaskBit : uint64_t
+{
+    OBS_SUCC_PR_LINK1 = 1ULL << 0,
+    OBS_SUCC_PR_LINK2 = 1ULL << 1,
+    OBS_SUCC_PR_TOTAL = 1ULL << 2,
+    OBS_SUCC_PR_ALL = OBS_SUCC_PR_LINK1 | OBS_SUCC_PR_LINK2 | OBS_SUCC_PR_TOTAL,
+    OBS_THPT_LINK1 = 1ULL << 3,
+    OBS_THPT_LINK2 = 1ULL << 4,
+    OBS_THPT_TOTAL = 1ULL << 5,
+    OBS_THPT_ALL = OBS_THPT_LINK1 | OBS_THPT_LINK2 | OBS_THPT_TOTAL,
+    OBS_MEAN_QUE_DELAY_LINK1 = 1ULL << 6,
+    OBS_MEAN_QUE_DELAY_LINK2 = 1ULL << 7,
+    OBS_MEAN_QUE_DELAY_TOTAL = 1ULL << 8,
+    OBS_MEAN_QUE_DELAY_ALL =
+        OBS_MEAN_QUE_DELAY_LINK1 | OBS_MEAN_QUE_DELAY_LINK2 | OBS_MEAN_QUE_DELAY_TOTAL,
+    OBS_MEAN_ACC_DELAY_LINK1 = 1ULL << 9,
+    OBS_MEAN_ACC_DELAY_LINK2 = 1ULL << 10,
+    OBS_MEAN_ACC_DELAY_TOTAL = 1ULL << 11,
+    OBS_MEAN_ACC_DELAY_ALL =
+        OBS_MEAN_ACC_DELAY_LINK1 | OBS_MEAN_ACC_DELAY_LINK2 | OBS_MEAN_ACC_DELAY_TOTAL,
+    OBS_MEAN_E2E_DELAY_LINK1 = 1ULL << 12,
+    OBS_MEAN_E2E_DELAY_LINK2 = 1ULL << 13,
+    OBS_MEAN_E2E_DELAY_TOTAL = 1ULL << 14,
+    OBS_MEAN_E2E_DELAY_ALL =
+        OBS_MEAN_E2E_DELAY_LINK1 | OBS_MEAN_E2E_DELAY_LINK2 | OBS_MEAN_E2E_DELAY_TOTAL,
+    OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK1 = 1ULL << 15,
+    OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK2 = 1ULL << 16,
+    OBS_SECOND_RAW_MOMENT_ACC_DELAY_TOTAL = 1ULL << 17,
+    OBS_SECOND_RAW_MOMENT_ACC_DELAY_ALL = OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK1 |
+                                          OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK2 |
+                                          OBS_SECOND_RAW_MOMENT_ACC_DELAY_TOTAL,
+    OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK1 = 1ULL << 18,
+    OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK2 = 1ULL << 19,
+    OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_TOTAL = 1ULL << 20,
+    OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_ALL = OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK1 |
+                                              OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK2 |
+                                              OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_TOTAL,
+    OBS_P95_ACC_DELAY_LINK1 = 1ULL << 21,
+    OBS_P95_ACC_DELAY_LINK2 = 1ULL << 22,
+    OBS_P95_ACC_DELAY_TOTAL = 1ULL << 23,
+    OBS_P95_ACC_DELAY_ALL =
+        OBS_P95_ACC_DELAY_LINK1 | OBS_P95_ACC_DELAY_LINK2 | OBS_P95_ACC_DELAY_TOTAL,
+    OBS_P95_E2E_DELAY_LINK1 = 1ULL << 24,
+    OBS_P95_E2E_DELAY_LINK2 = 1ULL << 25,
+    OBS_P95_E2E_DELAY_TOTAL = 1ULL << 26,
+    OBS_P95_E2E_DELAY_ALL =
+        OBS_P95_E2E_DELAY_LINK1 | OBS_P95_E2E_DELAY_LINK2 | OBS_P95_E2E_DELAY_TOTAL,
+    OBS_P99_ACC_DELAY_LINK1 = 1ULL << 27,
+    OBS_P99_ACC_DELAY_LINK2 = 1ULL << 28,
+    OBS_P99_ACC_DELAY_TOTAL = 1ULL << 29,
+    OBS_P99_ACC_DELAY_ALL =
+        OBS_P99_ACC_DELAY_LINK1 | OBS_P99_ACC_DELAY_LINK2 | OBS_P99_ACC_DELAY_TOTAL,
+    OBS_P99_E2E_DELAY_LINK1 = 1ULL << 30,
+    OBS_P99_E2E_DELAY_LINK2 = 1ULL << 31,
+    OBS_P99_E2E_DELAY_TOTAL = 1ULL << 32,
+    OBS_P99_E2E_DELAY_ALL =
+        OBS_P99_E2E_DELAY_LINK1 | OBS_P99_E2E_DELAY_LINK2 | OBS_P99_E2E_DELAY_TOTAL,
+    OBS_ALL = (1ULL << 33) - 1,
 };
 
 #endif // APB_H
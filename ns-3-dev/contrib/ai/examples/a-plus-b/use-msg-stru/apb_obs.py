@@ -0,0 +1,30 @@
+import re
+
+import ns3ai_apb_py_stru as py_binding
+
+
+def obs_bit(name):
+    """EnvObsMaskBit of an EnvStruct statistic, e.g. mldP95AccDelayLink1 -> OBS_P95_ACC_DELAY_LINK1.
+
+    Returns 0 for the fields that are not statistics (the scenario inputs are always sent).
+    """
+    if not name.startswith('mld'):
+        return 0
+    bit = 'OBS_' + re.sub(r'(?<!^)(?=[A-Z])', '_', name[len('mld'):]).upper()
+    return getattr(py_binding, bit, 0)
+
+
+def obs_mask(names):
+    """act_obsMask subscribing to the statistics among names; the others are sent as NaN.
+
+    The simulation only merges the per-node accumulators behind the subscribed statistics
+    (unless the results file, the step cache or the single-line summary needs all of them),
+    so a small mask also makes the steps cheaper.
+
+    Subscribe to every field the agent reads: a mask of 0 keeps the last one, which is
+    all the statistics until a nonzero mask has been sent.
+    """
+    mask = 0
+    for name in names:
+        mask |= obs_bit(name)
+    return mask or py_binding.OBS_ALL
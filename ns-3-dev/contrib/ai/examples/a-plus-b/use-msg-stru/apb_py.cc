@@ -51,6 +51,18 @@ PYBIND11_MODULE(ns3ai_apb_py_stru, m)
         .def_readwrite("mldSecondCentralMomentAccDelayLink1", &EnvStruct::env_mldSecondCentralMomentAccDelayLink1)
         .def_readwrite("mldSecondCentralMomentAccDelayLink2", &EnvStruct::env_mldSecondCentralMomentAccDelayLink2)
         .def_readwrite("mldSecondCentralMomentAccDelayTotal", &EnvStruct::env_mldSecondCentralMomentAccDelayTotal)
+        .def_readwrite("mldP95AccDelayLink1", &EnvStruct::env_mldP95AccDelayLink1)
+        .def_readwrite("mldP95AccDelayLink2", &EnvStruct::env_mldP95AccDelayLink2)
+        .def_readwrite("mldP95AccDelayTotal", &EnvStruct::env_mldP95AccDelayTotal)
+        .def_readwrite("mldP95E2eDelayLink1", &EnvStruct::env_mldP95E2eDelayLink1)
+        .def_readwrite("mldP95E2eDelayLink2", &EnvStruct::env_mldP95E2eDelayLink2)
+        .def_readwrite("mldP95E2eDelayTotal", &EnvStruct::env_mldP95E2eDelayTotal)
+        .def_readwrite("mldP99AccDelayLink1", &EnvStruct::env_mldP99AccDelayLink1)
+        .def_readwrite("mldP99AccDelayLink2", &EnvStruct::env_mldP99AccDelayLink2)
+        .def_readwrite("mldP99AccDelayTotal", &EnvStruct::env_mldP99AccDelayTotal)
+        .def_readwrite("mldP99E2eDelayLink1", &EnvStruct::env_mldP99E2eDelayLink1)
+        .def_readwrite("mldP99E2eDelayLink2", &EnvStruct::env_mldP99E2eDelayLink2)
+        .def_readwrite("mldP99E2eDelayTotal", &EnvStruct::env_mldP99E2eDelayTotal)
         .def_readwrite("rngRun", &EnvStruct::env_rngRun)
         .def_readwrite("simulationTime", &EnvStruct::env_simulationTime)
         .def_readwrite("payloadSize", &EnvStruct::env_payloadSize)
@@ -91,8 +103,60 @@ PYBIND11_MODULE(ns3ai_apb_py_stru, m)
         .def_readwrite("simulationTime", &ActStruct::act_simulationTime)
         .def_readwrite("mldPerNodeLambda", &ActStruct::act_mldPerNodeLambda)
         .def_readwrite("totalSteps", &ActStruct::act_totalSteps)
-        .def_readwrite("mldProbLink1", &ActStruct::act_mldProbLink1);
-        
+        .def_readwrite("mldProbLink1", &ActStruct::act_mldProbLink1)
+        .def_readwrite("obsMask", &ActStruct::act_obsMask);
+
+    // bits of PyActStruct.obsMask
+    m.attr("OBS_SUCC_PR_LINK1") = static_cast<uint64_t>(OBS_SUCC_PR_LINK1);
+    m.attr("OBS_SUCC_PR_LINK2") = static_cast<uint64_t>(OBS_SUCC_PR_LINK2);
+    m.attr("OBS_SUCC_PR_TOTAL") = static_cast<uint64_t>(OBS_SUCC_PR_TOTAL);
+    m.attr("OBS_SUCC_PR_ALL") = static_cast<uint64_t>(OBS_SUCC_PR_ALL);
+    m.attr("OBS_THPT_LINK1") = static_cast<uint64_t>(OBS_THPT_LINK1);
+    m.attr("OBS_THPT_LINK2") = static_cast<uint64_t>(OBS_THPT_LINK2);
+    m.attr("OBS_THPT_TOTAL") = static_cast<uint64_t>(OBS_THPT_TOTAL);
+    m.attr("OBS_THPT_ALL") = static_cast<uint64_t>(OBS_THPT_ALL);
+    m.attr("OBS_MEAN_QUE_DELAY_LINK1") = static_cast<uint64_t>(OBS_MEAN_QUE_DELAY_LINK1);
+    m.attr("OBS_MEAN_QUE_DELAY_LINK2") = static_cast<uint64_t>(OBS_MEAN_QUE_DELAY_LINK2);
+    m.attr("OBS_MEAN_QUE_DELAY_TOTAL") = static_cast<uint64_t>(OBS_MEAN_QUE_DELAY_TOTAL);
+    m.attr("OBS_MEAN_QUE_DELAY_ALL") = static_cast<uint64_t>(OBS_MEAN_QUE_DELAY_ALL);
+    m.attr("OBS_MEAN_ACC_DELAY_LINK1") = static_cast<uint64_t>(OBS_MEAN_ACC_DELAY_LINK1);
+    m.attr("OBS_MEAN_ACC_DELAY_LINK2") = static_cast<uint64_t>(OBS_MEAN_ACC_DELAY_LINK2);
+    m.attr("OBS_MEAN_ACC_DELAY_TOTAL") = static_cast<uint64_t>(OBS_MEAN_ACC_DELAY_TOTAL);
+    m.attr("OBS_MEAN_ACC_DELAY_ALL") = static_cast<uint64_t>(OBS_MEAN_ACC_DELAY_ALL);
+    m.attr("OBS_MEAN_E2E_DELAY_LINK1") = static_cast<uint64_t>(OBS_MEAN_E2E_DELAY_LINK1);
+    m.attr("OBS_MEAN_E2E_DELAY_LINK2") = static_cast<uint64_t>(OBS_MEAN_E2E_DELAY_LINK2);
+    m.attr("OBS_MEAN_E2E_DELAY_TOTAL") = static_cast<uint64_t>(OBS_MEAN_E2E_DELAY_TOTAL);
+    m.attr("OBS_MEAN_E2E_DELAY_ALL") = static_cast<uint64_t>(OBS_MEAN_E2E_DELAY_ALL);
+    m.attr("OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK1") = static_cast<uint64_t>(OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK1);
+    m.attr("OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK2") = static_cast<uint64_t>(OBS_SECOND_RAW_MOMENT_ACC_DELAY_LINK2);
+    m.attr("OBS_SECOND_RAW_MOMENT_ACC_DELAY_TOTAL") = static_cast<uint64_t>(OBS_SECOND_RAW_MOMENT_ACC_DELAY_TOTAL);
+    m.attr("OBS_SECOND_RAW_MOMENT_ACC_DELAY_ALL") = static_cast<uint64_t>(OBS_SECOND_RAW_MOMENT_ACC_DELAY_ALL);
+    m.attr("OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK1") = static_cast<uint64_t>(OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK1);
+    m.attr("OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK2") = static_cast<uint64_t>(OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_LINK2);
+    m.attr("OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_TOTAL") = static_cast<uint64_t>(OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_TOTAL);
+    m.attr("OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_ALL") = static_cast<uint64_t>(OBS_SECOND_CENTRAL_MOMENT_ACC_DELAY_ALL);
+    m.attr("OBS_P95_ACC_DELAY_LINK1") = static_cast<uint64_t>(OBS_P95_ACC_DELAY_LINK1);
+    m.attr("OBS_P95_ACC_DELAY_LINK2") = static_cast<uint64_t>(OBS_P95_ACC_DELAY_LINK2);
+    m.attr("OBS_P95_ACC_DELAY_TOTAL") = static_cast<uint64_t>(OBS_P95_ACC_DELAY_TOTAL);
+    m.attr("OBS_P95_ACC_DELAY_ALL") = static_cast<uint64_t>(OBS_P95_ACC_DELAY_ALL);
+    m.attr("OBS_P95_E2E_DELAY_LINK1") = static_cast<uint64_t>(OBS_P95_E2E_DELAY_LINK1);
+    m.attr("OBS_P95_E2E_DELAY_LINK2") = static_cast<uint64_t>(OBS_P95_E2E_DELAY_LINK2);
+    m.attr("OBS_P95_E2E_DELAY_TOTAL") = static_cast<uint64_t>(OBS_P95_E2E_DELAY_TOTAL);
+    m.attr("OBS_P95_E2E_DELAY_ALL") = static_cast<uint64_t>(OBS_P95_E2E_DELAY_ALL);
+    m.attr("OBS_P99_ACC_DELAY_LINK1") = static_cast<uint64_t>(OBS_P99_ACC_DELAY_LINK1);
+    m.attr("OBS_P99_ACC_DELAY_LINK2") = static_cast<uint64_t>(OBS_P99_ACC_DELAY_LINK2);
+    m.attr("OBS_P99_ACC_DELAY_TOTAL") = static_cast<uint64_t>(OBS_P99_ACC_DELAY_TOTAL);
+    m.attr("OBS_P99_ACC_DELAY_ALL") = static_cast<uint64_t>(OBS_P99_ACC_DELAY_ALL);
+    m.attr("OBS_P99_E2E_DELAY_LINK1") = static_cast<uint64_t>(OBS_P99_E2E_DELAY_LINK1);
+    m.attr("OBS_P99_E2E_DELAY_LINK2") = static_cast<uint64_t>(OBS_P99_E2E_DELAY_LINK2);
+    m.attr("OBS_P99_E2E_DELAY_TOTAL") = static_cast<uint64_t>(OBS_P99_E2E_DELAY_TOTAL);
+    m.attr("OBS_P99_E2E_DELAY_ALL") = static_cast<uint64_t>(OBS_P99_E2E_DELAY_ALL);
+    m.attr("OBS_ALL") = static_cast<uint64_t>(OBS_ALL);
+
+    py::class_<ns3::Ns3AiMsgWaitStats>(m, "Ns3AiMsgWaitStats")
+        .def_readonly("m_calls", &ns3::Ns3AiMsgWaitStats::m_calls)
+        .def_readonly("m_waits", &ns3::Ns3AiMsgWaitStats::m_waits)
+        .def_readonly("m_waitNs", &ns3::Ns3AiMsgWaitStats::m_waitNs);
 
     py::class_<ns3::Ns3AiMsgInterfaceImpl<EnvStruct, ActStruct>>(m, "Ns3AiMsgInterfaceImpl")
         .def(py::init<bool,
@@ -108,6 +172,12 @@ PYBIND11_MODULE(ns3ai_apb_py_stru, m)
         .def("PySendBegin", &ns3::Ns3AiMsgInterfaceImpl<EnvStruct, ActStruct>::PySendBegin)
         .def("PySendEnd", &ns3::Ns3AiMsgInterfaceImpl<EnvStruct, ActStruct>::PySendEnd)
         .def("PyGetFinished", &ns3::Ns3AiMsgInterfaceImpl<EnvStruct, ActStruct>::PyGetFinished)
+        .def("GetPySendWait",
+             &ns3::Ns3AiMsgInterfaceImpl<EnvStruct, ActStruct>::GetPySendWait,
+             py::return_value_policy::reference)
+        .def("GetPyRecvWait",
+             &ns3::Ns3AiMsgInterfaceImpl<EnvStruct, ActStruct>::GetPyRecvWait,
+             py::return_value_policy::reference)
         .def("GetCpp2PyStruct",
              &ns3::Ns3AiMsgInterfaceImpl<EnvStruct, ActStruct>::GetCpp2PyStruct,
              py::return_value_policy::reference)
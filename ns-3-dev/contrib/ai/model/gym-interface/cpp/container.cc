@@ -21,8 +21,12 @@
 
 #include "container.h"
 
+#include "spaces.h"
+
 #include <ns3/log.h>
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -163,6 +167,24 @@ OpenGymDataContainer::CreateFromDataContainerPbMsg(ns3_ai_gym::DataContainer& da
 
         actDataContainer = dictData;
     }
+    else if (dataContainerPbMsg.type() == ns3_ai_gym::FlatDict)
+    {
+        Ptr<OpenGymFlatDictContainer> dictData = CreateObject<OpenGymFlatDictContainer>();
+
+        ns3_ai_gym::FlatDictDataContainer flatDictContainerPbMsg;
+        dataContainerPbMsg.data().UnpackTo(&flatDictContainerPbMsg);
+
+        int n =
+            std::min(flatDictContainerPbMsg.keyid_size(), flatDictContainerPbMsg.element_size());
+        for (int i = 0; i < n; ++i)
+        {
+            Ptr<OpenGymDataContainer> subData = OpenGymDataContainer::CreateFromDataContainerPbMsg(
+                *flatDictContainerPbMsg.mutable_element(i));
+            dictData->Add(flatDictContainerPbMsg.keyid(i), subData);
+        }
+
+        actDataContainer = dictData;
+    }
     return actDataContainer;
 }
 
@@ -433,4 +455,120 @@ OpenGymDictContainer::Print(std::ostream& where) const
     where << ")";
 }
 
+TypeId
+OpenGymFlatDictContainer::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::OpenGymFlatDictContainer")
+                            .SetParent<OpenGymDataContainer>()
+                            .SetGroupName("OpenGym")
+                            .AddConstructor<OpenGymFlatDictContainer>();
+    return tid;
+}
+
+OpenGymFlatDictContainer::OpenGymFlatDictContainer()
+{
+    // NS_LOG_FUNCTION (this);
+}
+
+OpenGymFlatDictContainer::~OpenGymFlatDictContainer()
+{
+    // NS_LOG_FUNCTION (this);
+}
+
+void
+OpenGymFlatDictContainer::DoDispose()
+{
+    // NS_LOG_FUNCTION (this);
+    m_dict.clear();
+}
+
+void
+OpenGymFlatDictContainer::DoInitialize()
+{
+    // NS_LOG_FUNCTION (this);
+}
+
+ns3_ai_gym::DataContainer
+OpenGymFlatDictContainer::GetDataContainerPbMsg()
+{
+    ns3_ai_gym::DataContainer dataContainerPbMsg;
+    dataContainerPbMsg.set_type(ns3_ai_gym::FlatDict);
+
+    ns3_ai_gym::FlatDictDataContainer flatDictContainerPbMsg;
+    flatDictContainerPbMsg.mutable_keyid()->Reserve(m_dict.size());
+    flatDictContainerPbMsg.mutable_element()->Reserve(m_dict.size());
+    for (const auto& [keyId, subData] : m_dict)
+    {
+        flatDictContainerPbMsg.add_keyid(keyId);
+        *flatDictContainerPbMsg.add_element() = subData->GetDataContainerPbMsg();
+    }
+
+    dataContainerPbMsg.mutable_data()->PackFrom(flatDictContainerPbMsg);
+    return dataContainerPbMsg;
+}
+
+bool
+OpenGymFlatDictContainer::Add(std::string key, Ptr<OpenGymDataContainer> data)
+{
+    return Add(OpenGymFlatDictSpace::InternKey(key), data);
+}
+
+bool
+OpenGymFlatDictContainer::Add(uint32_t keyId, Ptr<OpenGymDataContainer> data)
+{
+    NS_LOG_FUNCTION(this << keyId);
+    // keys are usually added in increasing order
+    if (m_dict.empty() || m_dict.back().first < keyId)
+    {
+        m_dict.emplace_back(keyId, data);
+        return true;
+    }
+    auto it = std::lower_bound(m_dict.begin(),
+                               m_dict.end(),
+                               keyId,
+                               [](const auto& entry, uint32_t id) { return entry.first < id; });
+    if (it->first == keyId)
+    {
+        return false;
+    }
+    m_dict.emplace(it, keyId, data);
+    return true;
+}
+
+Ptr<OpenGymDataContainer>
+OpenGymFlatDictContainer::Get(std::string key)
+{
+    return Get(OpenGymFlatDictSpace::InternKey(key));
+}
+
+Ptr<OpenGymDataContainer>
+OpenGymFlatDictContainer::Get(uint32_t keyId)
+{
+    auto it = std::lower_bound(m_dict.begin(),
+                               m_dict.end(),
+                               keyId,
+                               [](const auto& entry, uint32_t id) { return entry.first < id; });
+    if (it != m_dict.end() && it->first == keyId)
+    {
+        return it->second;
+    }
+    return nullptr;
+}
+
+void
+OpenGymFlatDictContainer::Print(std::ostream& where) const
+{
+    where << "FlatDict(";
+    for (auto it = m_dict.cbegin(); it != m_dict.cend(); ++it)
+    {
+        if (it != m_dict.cbegin())
+        {
+            where << ", ";
+        }
+        where << OpenGymFlatDictSpace::GetKeyName(it->first) << "=";
+        it->second->Print(where);
+    }
+    where << ")";
+}
+
 } // namespace ns3
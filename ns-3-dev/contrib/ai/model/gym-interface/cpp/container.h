@@ -353,6 +353,46 @@ class OpenGymDictContainer : public OpenGymDataContainer
     std::map<std::string, Ptr<OpenGymDataContainer>> m_dict;
 };
 
+/**
+ * \brief Dict container with keys interned to integer IDs.
+ *
+ * Data of an OpenGymFlatDictSpace. The values are kept in a vector sorted by
+ * key ID and the message only carries the key IDs, so serialization is linear
+ * and involves no string. Keys are best interned once, with
+ * OpenGymFlatDictSpace::InternKey, and added by ID on every step.
+ */
+class OpenGymFlatDictContainer : public OpenGymDataContainer
+{
+  public:
+    OpenGymFlatDictContainer();
+    ~OpenGymFlatDictContainer() override;
+
+    static TypeId GetTypeId();
+
+    ns3_ai_gym::DataContainer GetDataContainerPbMsg() override;
+
+    void Print(std::ostream& where) const override;
+
+    friend std::ostream& operator<<(std::ostream& os,
+                                    const Ptr<OpenGymFlatDictContainer> container)
+    {
+        container->Print(os);
+        return os;
+    }
+
+    bool Add(std::string key, Ptr<OpenGymDataContainer> value);
+    bool Add(uint32_t keyId, Ptr<OpenGymDataContainer> value);
+    Ptr<OpenGymDataContainer> Get(std::string key);
+    Ptr<OpenGymDataContainer> Get(uint32_t keyId);
+
+  protected:
+    // Inherited
+    void DoInitialize() override;
+    void DoDispose() override;
+
+    std::vector<std::pair<uint32_t, Ptr<OpenGymDataContainer>>> m_dict; //!< sorted by key ID
+};
+
 } // end of namespace ns3
 
 #endif /* OPENGYM_CONTAINER_H */
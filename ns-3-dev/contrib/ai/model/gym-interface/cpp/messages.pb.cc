@@ -92,6 +92,22 @@ struct DictSpaceDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 DictSpaceDefaultTypeInternal _DictSpace_default_instance_;
+PROTOBUF_CONSTEXPR FlatDictSpace::FlatDictSpace(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.keyid_)*/{}
+  , /*decltype(_impl_._keyid_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.key_)*/{}
+  , /*decltype(_impl_.element_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct FlatDictSpaceDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR FlatDictSpaceDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~FlatDictSpaceDefaultTypeInternal() {}
+  union {
+    FlatDictSpace _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 FlatDictSpaceDefaultTypeInternal _FlatDictSpace_default_instance_;
 PROTOBUF_CONSTEXPR DataContainer::DataContainer(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
@@ -167,10 +183,26 @@ struct DictDataContainerDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 DictDataContainerDefaultTypeInternal _DictDataContainer_default_instance_;
+PROTOBUF_CONSTEXPR FlatDictDataContainer::FlatDictDataContainer(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.keyid_)*/{}
+  , /*decltype(_impl_._keyid_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.element_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct FlatDictDataContainerDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR FlatDictDataContainerDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~FlatDictDataContainerDefaultTypeInternal() {}
+  union {
+    FlatDictDataContainer _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 FlatDictDataContainerDefaultTypeInternal _FlatDictDataContainer_default_instance_;
 PROTOBUF_CONSTEXPR SimInitMsg::SimInitMsg(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.obsspace_)*/nullptr
   , /*decltype(_impl_.actspace_)*/nullptr
+  , /*decltype(_impl_.resetsupported_)*/false
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct SimInitMsgDefaultTypeInternal {
   PROTOBUF_CONSTEXPR SimInitMsgDefaultTypeInternal()
@@ -216,6 +248,7 @@ PROTOBUF_CONSTEXPR EnvActMsg::EnvActMsg(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.actdata_)*/nullptr
   , /*decltype(_impl_.stopsimreq_)*/false
+  , /*decltype(_impl_.resetsimreq_)*/false
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct EnvActMsgDefaultTypeInternal {
   PROTOBUF_CONSTEXPR EnvActMsgDefaultTypeInternal()
@@ -227,7 +260,7 @@ struct EnvActMsgDefaultTypeInternal {
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 EnvActMsgDefaultTypeInternal _EnvActMsg_default_instance_;
 }  // namespace ns3_ai_gym
-static ::_pb::Metadata file_level_metadata_messages_2eproto[14];
+static ::_pb::Metadata file_level_metadata_messages_2eproto[16];
 static const ::_pb::EnumDescriptor* file_level_enum_descriptors_messages_2eproto[4];
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_messages_2eproto = nullptr;
 
@@ -273,6 +306,15 @@ const uint32_t TableStruct_messages_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::DictSpace, _impl_.element_),
   ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::FlatDictSpace, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::FlatDictSpace, _impl_.keyid_),
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::FlatDictSpace, _impl_.key_),
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::FlatDictSpace, _impl_.element_),
+  ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::DataContainer, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
@@ -315,6 +357,14 @@ const uint32_t TableStruct_messages_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::DictDataContainer, _impl_.element_),
   ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::FlatDictDataContainer, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::FlatDictDataContainer, _impl_.keyid_),
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::FlatDictDataContainer, _impl_.element_),
+  ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::SimInitMsg, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
@@ -322,6 +372,7 @@ const uint32_t TableStruct_messages_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::SimInitMsg, _impl_.obsspace_),
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::SimInitMsg, _impl_.actspace_),
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::SimInitMsg, _impl_.resetsupported_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::SimInitAck, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -349,6 +400,7 @@ const uint32_t TableStruct_messages_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::EnvActMsg, _impl_.actdata_),
   PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::EnvActMsg, _impl_.stopsimreq_),
+  PROTOBUF_FIELD_OFFSET(::ns3_ai_gym::EnvActMsg, _impl_.resetsimreq_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, -1, sizeof(::ns3_ai_gym::SpaceDescription)},
@@ -356,15 +408,17 @@ static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protode
   { 16, -1, -1, sizeof(::ns3_ai_gym::BoxSpace)},
   { 26, -1, -1, sizeof(::ns3_ai_gym::TupleSpace)},
   { 33, -1, -1, sizeof(::ns3_ai_gym::DictSpace)},
-  { 40, -1, -1, sizeof(::ns3_ai_gym::DataContainer)},
-  { 49, -1, -1, sizeof(::ns3_ai_gym::DiscreteDataContainer)},
-  { 56, -1, -1, sizeof(::ns3_ai_gym::BoxDataContainer)},
-  { 68, -1, -1, sizeof(::ns3_ai_gym::TupleDataContainer)},
-  { 75, -1, -1, sizeof(::ns3_ai_gym::DictDataContainer)},
-  { 82, -1, -1, sizeof(::ns3_ai_gym::SimInitMsg)},
-  { 90, -1, -1, sizeof(::ns3_ai_gym::SimInitAck)},
-  { 98, -1, -1, sizeof(::ns3_ai_gym::EnvStateMsg)},
-  { 109, -1, -1, sizeof(::ns3_ai_gym::EnvActMsg)},
+  { 40, -1, -1, sizeof(::ns3_ai_gym::FlatDictSpace)},
+  { 49, -1, -1, sizeof(::ns3_ai_gym::DataContainer)},
+  { 58, -1, -1, sizeof(::ns3_ai_gym::DiscreteDataContainer)},
+  { 65, -1, -1, sizeof(::ns3_ai_gym::BoxDataContainer)},
+  { 77, -1, -1, sizeof(::ns3_ai_gym::TupleDataContainer)},
+  { 84, -1, -1, sizeof(::ns3_ai_gym::DictDataContainer)},
+  { 91, -1, -1, sizeof(::ns3_ai_gym::FlatDictDataContainer)},
+  { 99, -1, -1, sizeof(::ns3_ai_gym::SimInitMsg)},
+  { 108, -1, -1, sizeof(::ns3_ai_gym::SimInitAck)},
+  { 116, -1, -1, sizeof(::ns3_ai_gym::EnvStateMsg)},
+  { 127, -1, -1, sizeof(::ns3_ai_gym::EnvActMsg)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -373,11 +427,13 @@ static const ::_pb::Message* const file_default_instances[] = {
   &::ns3_ai_gym::_BoxSpace_default_instance_._instance,
   &::ns3_ai_gym::_TupleSpace_default_instance_._instance,
   &::ns3_ai_gym::_DictSpace_default_instance_._instance,
+  &::ns3_ai_gym::_FlatDictSpace_default_instance_._instance,
   &::ns3_ai_gym::_DataContainer_default_instance_._instance,
   &::ns3_ai_gym::_DiscreteDataContainer_default_instance_._instance,
   &::ns3_ai_gym::_BoxDataContainer_default_instance_._instance,
   &::ns3_ai_gym::_TupleDataContainer_default_instance_._instance,
   &::ns3_ai_gym::_DictDataContainer_default_instance_._instance,
+  &::ns3_ai_gym::_FlatDictDataContainer_default_instance_._instance,
   &::ns3_ai_gym::_SimInitMsg_default_instance_._instance,
   &::ns3_ai_gym::_SimInitAck_default_instance_._instance,
   &::ns3_ai_gym::_EnvStateMsg_default_instance_._instance,
@@ -395,44 +451,50 @@ const char descriptor_table_protodef_messages_2eproto[] PROTOBUF_SECTION_VARIABL
   ";\n\nTupleSpace\022-\n\007element\030\001 \003(\0132\034.ns3_ai_"
   "gym.SpaceDescription\":\n\tDictSpace\022-\n\007ele"
   "ment\030\001 \003(\0132\034.ns3_ai_gym.SpaceDescription"
-  "\"f\n\rDataContainer\022#\n\004type\030\001 \001(\0162\025.ns3_ai"
-  "_gym.SpaceType\022\"\n\004data\030\002 \001(\0132\024.google.pr"
-  "otobuf.Any\022\014\n\004name\030\003 \001(\t\"%\n\025DiscreteData"
-  "Container\022\014\n\004data\030\001 \001(\005\"\215\001\n\020BoxDataConta"
-  "iner\022 \n\005dtype\030\001 \001(\0162\021.ns3_ai_gym.Dtype\022\r"
-  "\n\005shape\030\002 \003(\r\022\017\n\007intData\030\003 \003(\005\022\020\n\010uintDa"
-  "ta\030\004 \003(\r\022\021\n\tfloatData\030\005 \003(\002\022\022\n\ndoubleDat"
-  "a\030\006 \003(\001\"@\n\022TupleDataContainer\022*\n\007element"
-  "\030\001 \003(\0132\031.ns3_ai_gym.DataContainer\"\?\n\021Dic"
-  "tDataContainer\022*\n\007element\030\001 \003(\0132\031.ns3_ai"
-  "_gym.DataContainer\"l\n\nSimInitMsg\022.\n\010obsS"
-  "pace\030\001 \001(\0132\034.ns3_ai_gym.SpaceDescription"
-  "\022.\n\010actSpace\030\002 \001(\0132\034.ns3_ai_gym.SpaceDes"
-  "cription\".\n\nSimInitAck\022\014\n\004done\030\001 \001(\010\022\022\n\n"
-  "stopSimReq\030\002 \001(\010\"\306\001\n\013EnvStateMsg\022*\n\007obsD"
-  "ata\030\001 \001(\0132\031.ns3_ai_gym.DataContainer\022\016\n\006"
-  "reward\030\002 \001(\002\022\022\n\nisGameOver\030\003 \001(\010\022.\n\006reas"
-  "on\030\004 \001(\0162\036.ns3_ai_gym.EnvStateMsg.Reason"
-  "\022\014\n\004info\030\005 \001(\t\")\n\006Reason\022\021\n\rSimulationEn"
-  "d\020\000\022\014\n\010GameOver\020\001\"K\n\tEnvActMsg\022*\n\007actDat"
-  "a\030\001 \001(\0132\031.ns3_ai_gym.DataContainer\022\022\n\nst"
-  "opSimReq\030\002 \001(\010*\234\001\n\007MsgType\022\013\n\007Unknown\020\000\022"
-  "\010\n\004Init\020\001\022\017\n\013ActionSpace\020\002\022\024\n\020Observatio"
-  "nSpace\020\003\022\016\n\nIsGameOver\020\004\022\017\n\013Observation\020"
-  "\005\022\n\n\006Reward\020\006\022\r\n\tExtraInfo\020\007\022\n\n\006Action\020\010"
-  "\022\013\n\007StopEnv\020\t*H\n\tSpaceType\022\017\n\013NoSpaceTyp"
-  "e\020\000\022\014\n\010Discrete\020\001\022\007\n\003Box\020\002\022\t\n\005Tuple\020\003\022\010\n"
-  "\004Dict\020\004*>\n\005Dtype\022\013\n\007NoDType\020\000\022\007\n\003INT\020\001\022\010"
-  "\n\004UINT\020\002\022\t\n\005FLOAT\020\003\022\n\n\006DOUBLE\020\004b\006proto3"
+  "\"Z\n\rFlatDictSpace\022\r\n\005keyId\030\001 \003(\r\022\013\n\003key\030"
+  "\002 \003(\t\022-\n\007element\030\003 \003(\0132\034.ns3_ai_gym.Spac"
+  "eDescription\"f\n\rDataContainer\022#\n\004type\030\001 "
+  "\001(\0162\025.ns3_ai_gym.SpaceType\022\"\n\004data\030\002 \001(\013"
+  "2\024.google.protobuf.Any\022\014\n\004name\030\003 \001(\t\"%\n\025"
+  "DiscreteDataContainer\022\014\n\004data\030\001 \001(\005\"\215\001\n\020"
+  "BoxDataContainer\022 \n\005dtype\030\001 \001(\0162\021.ns3_ai"
+  "_gym.Dtype\022\r\n\005shape\030\002 \003(\r\022\017\n\007intData\030\003 \003"
+  "(\005\022\020\n\010uintData\030\004 \003(\r\022\021\n\tfloatData\030\005 \003(\002\022"
+  "\022\n\ndoubleData\030\006 \003(\001\"@\n\022TupleDataContaine"
+  "r\022*\n\007element\030\001 \003(\0132\031.ns3_ai_gym.DataCont"
+  "ainer\"\?\n\021DictDataContainer\022*\n\007element\030\001 "
+  "\003(\0132\031.ns3_ai_gym.DataContainer\"R\n\025FlatDi"
+  "ctDataContainer\022\r\n\005keyId\030\001 \003(\r\022*\n\007elemen"
+  "t\030\002 \003(\0132\031.ns3_ai_gym.DataContainer\"\204\001\n\nS"
+  "imInitMsg\022.\n\010obsSpace\030\001 \001(\0132\034.ns3_ai_gym"
+  ".SpaceDescription\022.\n\010actSpace\030\002 \001(\0132\034.ns"
+  "3_ai_gym.SpaceDescription\022\026\n\016resetSuppor"
+  "ted\030\003 \001(\010\".\n\nSimInitAck\022\014\n\004done\030\001 \001(\010\022\022\n"
+  "\nstopSimReq\030\002 \001(\010\"\306\001\n\013EnvStateMsg\022*\n\007obs"
+  "Data\030\001 \001(\0132\031.ns3_ai_gym.DataContainer\022\016\n"
+  "\006reward\030\002 \001(\002\022\022\n\nisGameOver\030\003 \001(\010\022.\n\006rea"
+  "son\030\004 \001(\0162\036.ns3_ai_gym.EnvStateMsg.Reaso"
+  "n\022\014\n\004info\030\005 \001(\t\")\n\006Reason\022\021\n\rSimulationE"
+  "nd\020\000\022\014\n\010GameOver\020\001\"`\n\tEnvActMsg\022*\n\007actDa"
+  "ta\030\001 \001(\0132\031.ns3_ai_gym.DataContainer\022\022\n\ns"
+  "topSimReq\030\002 \001(\010\022\023\n\013resetSimReq\030\003 \001(\010*\234\001\n"
+  "\007MsgType\022\013\n\007Unknown\020\000\022\010\n\004Init\020\001\022\017\n\013Actio"
+  "nSpace\020\002\022\024\n\020ObservationSpace\020\003\022\016\n\nIsGame"
+  "Over\020\004\022\017\n\013Observation\020\005\022\n\n\006Reward\020\006\022\r\n\tE"
+  "xtraInfo\020\007\022\n\n\006Action\020\010\022\013\n\007StopEnv\020\t*V\n\tS"
+  "paceType\022\017\n\013NoSpaceType\020\000\022\014\n\010Discrete\020\001\022"
+  "\007\n\003Box\020\002\022\t\n\005Tuple\020\003\022\010\n\004Dict\020\004\022\014\n\010FlatDic"
+  "t\020\005*>\n\005Dtype\022\013\n\007NoDType\020\000\022\007\n\003INT\020\001\022\010\n\004UI"
+  "NT\020\002\022\t\n\005FLOAT\020\003\022\n\n\006DOUBLE\020\004b\006proto3"
   ;
 static const ::_pbi::DescriptorTable* const descriptor_table_messages_2eproto_deps[1] = {
   &::descriptor_table_google_2fprotobuf_2fany_2eproto,
 };
 static ::_pbi::once_flag descriptor_table_messages_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_messages_2eproto = {
-    false, false, 1559, descriptor_table_protodef_messages_2eproto,
+    false, false, 1795, descriptor_table_protodef_messages_2eproto,
     "messages.proto",
-    &descriptor_table_messages_2eproto_once, descriptor_table_messages_2eproto_deps, 1, 14,
+    &descriptor_table_messages_2eproto_once, descriptor_table_messages_2eproto_deps, 1, 16,
     schemas, file_default_instances, TableStruct_messages_2eproto::offsets,
     file_level_metadata_messages_2eproto, file_level_enum_descriptors_messages_2eproto,
     file_level_service_descriptors_messages_2eproto,
@@ -498,6 +560,7 @@ bool SpaceType_IsValid(int value) {
     case 2:
     case 3:
     case 4:
+    case 5:
       return true;
     default:
       return false;
@@ -1661,6 +1724,272 @@ void DictSpace::InternalSwap(DictSpace* other) {
 
 // ===================================================================
 
+class FlatDictSpace::_Internal {
+ public:
+};
+
+FlatDictSpace::FlatDictSpace(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:ns3_ai_gym.FlatDictSpace)
+}
+FlatDictSpace::FlatDictSpace(const FlatDictSpace& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  FlatDictSpace* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.keyid_){from._impl_.keyid_}
+    , /*decltype(_impl_._keyid_cached_byte_size_)*/{0}
+    , decltype(_impl_.key_){from._impl_.key_}
+    , decltype(_impl_.element_){from._impl_.element_}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:ns3_ai_gym.FlatDictSpace)
+}
+
+inline void FlatDictSpace::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.keyid_){arena}
+    , /*decltype(_impl_._keyid_cached_byte_size_)*/{0}
+    , decltype(_impl_.key_){arena}
+    , decltype(_impl_.element_){arena}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+FlatDictSpace::~FlatDictSpace() {
+  // @@protoc_insertion_point(destructor:ns3_ai_gym.FlatDictSpace)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void FlatDictSpace::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.keyid_.~RepeatedField();
+  _impl_.key_.~RepeatedPtrField();
+  _impl_.element_.~RepeatedPtrField();
+}
+
+void FlatDictSpace::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void FlatDictSpace::Clear() {
+// @@protoc_insertion_point(message_clear_start:ns3_ai_gym.FlatDictSpace)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.keyid_.Clear();
+  _impl_.key_.Clear();
+  _impl_.element_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* FlatDictSpace::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated uint32 keyId = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt32Parser(_internal_mutable_keyid(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 8) {
+          _internal_add_keyid(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated string key = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            auto str = _internal_add_key();
+            ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+            CHK_(ptr);
+            CHK_(::_pbi::VerifyUTF8(str, "ns3_ai_gym.FlatDictSpace.key"));
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .ns3_ai_gym.SpaceDescription element = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_element(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* FlatDictSpace::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:ns3_ai_gym.FlatDictSpace)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated uint32 keyId = 1;
+  {
+    int byte_size = _impl_._keyid_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt32Packed(
+          1, _internal_keyid(), byte_size, target);
+    }
+  }
+
+  // repeated string key = 2;
+  for (int i = 0, n = this->_internal_key_size(); i < n; i++) {
+    const auto& s = this->_internal_key(i);
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      s.data(), static_cast<int>(s.length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "ns3_ai_gym.FlatDictSpace.key");
+    target = stream->WriteString(2, s, target);
+  }
+
+  // repeated .ns3_ai_gym.SpaceDescription element = 3;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_element_size()); i < n; i++) {
+    const auto& repfield = this->_internal_element(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:ns3_ai_gym.FlatDictSpace)
+  return target;
+}
+
+size_t FlatDictSpace::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:ns3_ai_gym.FlatDictSpace)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated uint32 keyId = 1;
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt32Size(this->_impl_.keyid_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._keyid_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  // repeated string key = 2;
+  total_size += 1 *
+      ::PROTOBUF_NAMESPACE_ID::internal::FromIntSize(_impl_.key_.size());
+  for (int i = 0, n = _impl_.key_.size(); i < n; i++) {
+    total_size += ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      _impl_.key_.Get(i));
+  }
+
+  // repeated .ns3_ai_gym.SpaceDescription element = 3;
+  total_size += 1UL * this->_internal_element_size();
+  for (const auto& msg : this->_impl_.element_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData FlatDictSpace::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    FlatDictSpace::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*FlatDictSpace::GetClassData() const { return &_class_data_; }
+
+
+void FlatDictSpace::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<FlatDictSpace*>(&to_msg);
+  auto& from = static_cast<const FlatDictSpace&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:ns3_ai_gym.FlatDictSpace)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.keyid_.MergeFrom(from._impl_.keyid_);
+  _this->_impl_.key_.MergeFrom(from._impl_.key_);
+  _this->_impl_.element_.MergeFrom(from._impl_.element_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void FlatDictSpace::CopyFrom(const FlatDictSpace& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:ns3_ai_gym.FlatDictSpace)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool FlatDictSpace::IsInitialized() const {
+  return true;
+}
+
+void FlatDictSpace::InternalSwap(FlatDictSpace* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.keyid_.InternalSwap(&other->_impl_.keyid_);
+  _impl_.key_.InternalSwap(&other->_impl_.key_);
+  _impl_.element_.InternalSwap(&other->_impl_.element_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata FlatDictSpace::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
+      file_level_metadata_messages_2eproto[5]);
+}
+
+// ===================================================================
+
 class DataContainer::_Internal {
  public:
   static const ::PROTOBUF_NAMESPACE_ID::Any& data(const DataContainer* msg);
@@ -1941,7 +2270,7 @@ void DataContainer::InternalSwap(DataContainer* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata DataContainer::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[5]);
+      file_level_metadata_messages_2eproto[6]);
 }
 
 // ===================================================================
@@ -2119,7 +2448,7 @@ void DiscreteDataContainer::InternalSwap(DiscreteDataContainer* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata DiscreteDataContainer::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[6]);
+      file_level_metadata_messages_2eproto[7]);
 }
 
 // ===================================================================
@@ -2492,7 +2821,7 @@ void BoxDataContainer::InternalSwap(BoxDataContainer* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata BoxDataContainer::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[7]);
+      file_level_metadata_messages_2eproto[8]);
 }
 
 // ===================================================================
@@ -2677,7 +3006,7 @@ void TupleDataContainer::InternalSwap(TupleDataContainer* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata TupleDataContainer::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[8]);
+      file_level_metadata_messages_2eproto[9]);
 }
 
 // ===================================================================
@@ -2862,7 +3191,234 @@ void DictDataContainer::InternalSwap(DictDataContainer* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata DictDataContainer::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[9]);
+      file_level_metadata_messages_2eproto[10]);
+}
+
+// ===================================================================
+
+class FlatDictDataContainer::_Internal {
+ public:
+};
+
+FlatDictDataContainer::FlatDictDataContainer(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:ns3_ai_gym.FlatDictDataContainer)
+}
+FlatDictDataContainer::FlatDictDataContainer(const FlatDictDataContainer& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  FlatDictDataContainer* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.keyid_){from._impl_.keyid_}
+    , /*decltype(_impl_._keyid_cached_byte_size_)*/{0}
+    , decltype(_impl_.element_){from._impl_.element_}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:ns3_ai_gym.FlatDictDataContainer)
+}
+
+inline void FlatDictDataContainer::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.keyid_){arena}
+    , /*decltype(_impl_._keyid_cached_byte_size_)*/{0}
+    , decltype(_impl_.element_){arena}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+FlatDictDataContainer::~FlatDictDataContainer() {
+  // @@protoc_insertion_point(destructor:ns3_ai_gym.FlatDictDataContainer)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void FlatDictDataContainer::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.keyid_.~RepeatedField();
+  _impl_.element_.~RepeatedPtrField();
+}
+
+void FlatDictDataContainer::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void FlatDictDataContainer::Clear() {
+// @@protoc_insertion_point(message_clear_start:ns3_ai_gym.FlatDictDataContainer)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.keyid_.Clear();
+  _impl_.element_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* FlatDictDataContainer::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated uint32 keyId = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt32Parser(_internal_mutable_keyid(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 8) {
+          _internal_add_keyid(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .ns3_ai_gym.DataContainer element = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_element(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* FlatDictDataContainer::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:ns3_ai_gym.FlatDictDataContainer)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated uint32 keyId = 1;
+  {
+    int byte_size = _impl_._keyid_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt32Packed(
+          1, _internal_keyid(), byte_size, target);
+    }
+  }
+
+  // repeated .ns3_ai_gym.DataContainer element = 2;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_element_size()); i < n; i++) {
+    const auto& repfield = this->_internal_element(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(2, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:ns3_ai_gym.FlatDictDataContainer)
+  return target;
+}
+
+size_t FlatDictDataContainer::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:ns3_ai_gym.FlatDictDataContainer)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated uint32 keyId = 1;
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt32Size(this->_impl_.keyid_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._keyid_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  // repeated .ns3_ai_gym.DataContainer element = 2;
+  total_size += 1UL * this->_internal_element_size();
+  for (const auto& msg : this->_impl_.element_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData FlatDictDataContainer::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    FlatDictDataContainer::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*FlatDictDataContainer::GetClassData() const { return &_class_data_; }
+
+
+void FlatDictDataContainer::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<FlatDictDataContainer*>(&to_msg);
+  auto& from = static_cast<const FlatDictDataContainer&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:ns3_ai_gym.FlatDictDataContainer)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.keyid_.MergeFrom(from._impl_.keyid_);
+  _this->_impl_.element_.MergeFrom(from._impl_.element_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void FlatDictDataContainer::CopyFrom(const FlatDictDataContainer& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:ns3_ai_gym.FlatDictDataContainer)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool FlatDictDataContainer::IsInitialized() const {
+  return true;
+}
+
+void FlatDictDataContainer::InternalSwap(FlatDictDataContainer* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.keyid_.InternalSwap(&other->_impl_.keyid_);
+  _impl_.element_.InternalSwap(&other->_impl_.element_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata FlatDictDataContainer::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
+      file_level_metadata_messages_2eproto[11]);
 }
 
 // ===================================================================
@@ -2893,6 +3449,7 @@ SimInitMsg::SimInitMsg(const SimInitMsg& from)
   new (&_impl_) Impl_{
       decltype(_impl_.obsspace_){nullptr}
     , decltype(_impl_.actspace_){nullptr}
+    , decltype(_impl_.resetsupported_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -2902,6 +3459,7 @@ SimInitMsg::SimInitMsg(const SimInitMsg& from)
   if (from._internal_has_actspace()) {
     _this->_impl_.actspace_ = new ::ns3_ai_gym::SpaceDescription(*from._impl_.actspace_);
   }
+  _this->_impl_.resetsupported_ = from._impl_.resetsupported_;
   // @@protoc_insertion_point(copy_constructor:ns3_ai_gym.SimInitMsg)
 }
 
@@ -2912,6 +3470,7 @@ inline void SimInitMsg::SharedCtor(
   new (&_impl_) Impl_{
       decltype(_impl_.obsspace_){nullptr}
     , decltype(_impl_.actspace_){nullptr}
+    , decltype(_impl_.resetsupported_){false}
     , /*decltype(_impl_._cached_size_)*/{}
   };
 }
@@ -2949,6 +3508,7 @@ void SimInitMsg::Clear() {
     delete _impl_.actspace_;
   }
   _impl_.actspace_ = nullptr;
+  _impl_.resetsupported_ = false;
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -2974,6 +3534,14 @@ const char* SimInitMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ct
         } else
           goto handle_unusual;
         continue;
+      // bool resetSupported = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.resetsupported_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -3017,6 +3585,12 @@ uint8_t* SimInitMsg::_InternalSerialize(
         _Internal::actspace(this).GetCachedSize(), target, stream);
   }
 
+  // bool resetSupported = 3;
+  if (this->_internal_resetsupported() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(3, this->_internal_resetsupported(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -3047,6 +3621,11 @@ size_t SimInitMsg::ByteSizeLong() const {
         *_impl_.actspace_);
   }
 
+  // bool resetSupported = 3;
+  if (this->_internal_resetsupported() != 0) {
+    total_size += 1 + 1;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -3073,6 +3652,9 @@ void SimInitMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PRO
     _this->_internal_mutable_actspace()->::ns3_ai_gym::SpaceDescription::MergeFrom(
         from._internal_actspace());
   }
+  if (from._internal_resetsupported() != 0) {
+    _this->_internal_set_resetsupported(from._internal_resetsupported());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -3091,8 +3673,8 @@ void SimInitMsg::InternalSwap(SimInitMsg* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(SimInitMsg, _impl_.actspace_)
-      + sizeof(SimInitMsg::_impl_.actspace_)
+      PROTOBUF_FIELD_OFFSET(SimInitMsg, _impl_.resetsupported_)
+      + sizeof(SimInitMsg::_impl_.resetsupported_)
       - PROTOBUF_FIELD_OFFSET(SimInitMsg, _impl_.obsspace_)>(
           reinterpret_cast<char*>(&_impl_.obsspace_),
           reinterpret_cast<char*>(&other->_impl_.obsspace_));
@@ -3101,7 +3683,7 @@ void SimInitMsg::InternalSwap(SimInitMsg* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata SimInitMsg::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[10]);
+      file_level_metadata_messages_2eproto[12]);
 }
 
 // ===================================================================
@@ -3312,7 +3894,7 @@ void SimInitAck::InternalSwap(SimInitAck* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata SimInitAck::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[11]);
+      file_level_metadata_messages_2eproto[13]);
 }
 
 // ===================================================================
@@ -3655,7 +4237,7 @@ void EnvStateMsg::InternalSwap(EnvStateMsg* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata EnvStateMsg::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[12]);
+      file_level_metadata_messages_2eproto[14]);
 }
 
 // ===================================================================
@@ -3681,13 +4263,16 @@ EnvActMsg::EnvActMsg(const EnvActMsg& from)
   new (&_impl_) Impl_{
       decltype(_impl_.actdata_){nullptr}
     , decltype(_impl_.stopsimreq_){}
+    , decltype(_impl_.resetsimreq_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
   if (from._internal_has_actdata()) {
     _this->_impl_.actdata_ = new ::ns3_ai_gym::DataContainer(*from._impl_.actdata_);
   }
-  _this->_impl_.stopsimreq_ = from._impl_.stopsimreq_;
+  ::memcpy(&_impl_.stopsimreq_, &from._impl_.stopsimreq_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.resetsimreq_) -
+    reinterpret_cast<char*>(&_impl_.stopsimreq_)) + sizeof(_impl_.resetsimreq_));
   // @@protoc_insertion_point(copy_constructor:ns3_ai_gym.EnvActMsg)
 }
 
@@ -3698,6 +4283,7 @@ inline void EnvActMsg::SharedCtor(
   new (&_impl_) Impl_{
       decltype(_impl_.actdata_){nullptr}
     , decltype(_impl_.stopsimreq_){false}
+    , decltype(_impl_.resetsimreq_){false}
     , /*decltype(_impl_._cached_size_)*/{}
   };
 }
@@ -3730,7 +4316,9 @@ void EnvActMsg::Clear() {
     delete _impl_.actdata_;
   }
   _impl_.actdata_ = nullptr;
-  _impl_.stopsimreq_ = false;
+  ::memset(&_impl_.stopsimreq_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.resetsimreq_) -
+      reinterpret_cast<char*>(&_impl_.stopsimreq_)) + sizeof(_impl_.resetsimreq_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -3756,6 +4344,14 @@ const char* EnvActMsg::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx
         } else
           goto handle_unusual;
         continue;
+      // bool resetSimReq = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.resetsimreq_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -3798,6 +4394,12 @@ uint8_t* EnvActMsg::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteBoolToArray(2, this->_internal_stopsimreq(), target);
   }
 
+  // bool resetSimReq = 3;
+  if (this->_internal_resetsimreq() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(3, this->_internal_resetsimreq(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -3826,6 +4428,11 @@ size_t EnvActMsg::ByteSizeLong() const {
     total_size += 1 + 1;
   }
 
+  // bool resetSimReq = 3;
+  if (this->_internal_resetsimreq() != 0) {
+    total_size += 1 + 1;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -3851,6 +4458,9 @@ void EnvActMsg::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROT
   if (from._internal_stopsimreq() != 0) {
     _this->_internal_set_stopsimreq(from._internal_stopsimreq());
   }
+  if (from._internal_resetsimreq() != 0) {
+    _this->_internal_set_resetsimreq(from._internal_resetsimreq());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -3869,8 +4479,8 @@ void EnvActMsg::InternalSwap(EnvActMsg* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(EnvActMsg, _impl_.stopsimreq_)
-      + sizeof(EnvActMsg::_impl_.stopsimreq_)
+      PROTOBUF_FIELD_OFFSET(EnvActMsg, _impl_.resetsimreq_)
+      + sizeof(EnvActMsg::_impl_.resetsimreq_)
       - PROTOBUF_FIELD_OFFSET(EnvActMsg, _impl_.actdata_)>(
           reinterpret_cast<char*>(&_impl_.actdata_),
           reinterpret_cast<char*>(&other->_impl_.actdata_));
@@ -3879,7 +4489,7 @@ void EnvActMsg::InternalSwap(EnvActMsg* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata EnvActMsg::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_messages_2eproto_getter, &descriptor_table_messages_2eproto_once,
-      file_level_metadata_messages_2eproto[13]);
+      file_level_metadata_messages_2eproto[15]);
 }
 
 // @@protoc_insertion_point(namespace_scope)
@@ -3905,6 +4515,10 @@ template<> PROTOBUF_NOINLINE ::ns3_ai_gym::DictSpace*
 Arena::CreateMaybeMessage< ::ns3_ai_gym::DictSpace >(Arena* arena) {
   return Arena::CreateMessageInternal< ::ns3_ai_gym::DictSpace >(arena);
 }
+template<> PROTOBUF_NOINLINE ::ns3_ai_gym::FlatDictSpace*
+Arena::CreateMaybeMessage< ::ns3_ai_gym::FlatDictSpace >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::ns3_ai_gym::FlatDictSpace >(arena);
+}
 template<> PROTOBUF_NOINLINE ::ns3_ai_gym::DataContainer*
 Arena::CreateMaybeMessage< ::ns3_ai_gym::DataContainer >(Arena* arena) {
   return Arena::CreateMessageInternal< ::ns3_ai_gym::DataContainer >(arena);
@@ -3925,6 +4539,10 @@ template<> PROTOBUF_NOINLINE ::ns3_ai_gym::DictDataContainer*
 Arena::CreateMaybeMessage< ::ns3_ai_gym::DictDataContainer >(Arena* arena) {
   return Arena::CreateMessageInternal< ::ns3_ai_gym::DictDataContainer >(arena);
 }
+template<> PROTOBUF_NOINLINE ::ns3_ai_gym::FlatDictDataContainer*
+Arena::CreateMaybeMessage< ::ns3_ai_gym::FlatDictDataContainer >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::ns3_ai_gym::FlatDictDataContainer >(arena);
+}
 template<> PROTOBUF_NOINLINE ::ns3_ai_gym::SimInitMsg*
 Arena::CreateMaybeMessage< ::ns3_ai_gym::SimInitMsg >(Arena* arena) {
   return Arena::CreateMessageInternal< ::ns3_ai_gym::SimInitMsg >(arena);
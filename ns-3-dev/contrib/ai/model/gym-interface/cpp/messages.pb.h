@@ -74,6 +74,12 @@ extern EnvActMsgDefaultTypeInternal _EnvActMsg_default_instance_;
 class EnvStateMsg;
 struct EnvStateMsgDefaultTypeInternal;
 extern EnvStateMsgDefaultTypeInternal _EnvStateMsg_default_instance_;
+class FlatDictDataContainer;
+struct FlatDictDataContainerDefaultTypeInternal;
+extern FlatDictDataContainerDefaultTypeInternal _FlatDictDataContainer_default_instance_;
+class FlatDictSpace;
+struct FlatDictSpaceDefaultTypeInternal;
+extern FlatDictSpaceDefaultTypeInternal _FlatDictSpace_default_instance_;
 class SimInitAck;
 struct SimInitAckDefaultTypeInternal;
 extern SimInitAckDefaultTypeInternal _SimInitAck_default_instance_;
@@ -100,6 +106,8 @@ template<> ::ns3_ai_gym::DiscreteDataContainer* Arena::CreateMaybeMessage<::ns3_
 template<> ::ns3_ai_gym::DiscreteSpace* Arena::CreateMaybeMessage<::ns3_ai_gym::DiscreteSpace>(Arena*);
 template<> ::ns3_ai_gym::EnvActMsg* Arena::CreateMaybeMessage<::ns3_ai_gym::EnvActMsg>(Arena*);
 template<> ::ns3_ai_gym::EnvStateMsg* Arena::CreateMaybeMessage<::ns3_ai_gym::EnvStateMsg>(Arena*);
+template<> ::ns3_ai_gym::FlatDictDataContainer* Arena::CreateMaybeMessage<::ns3_ai_gym::FlatDictDataContainer>(Arena*);
+template<> ::ns3_ai_gym::FlatDictSpace* Arena::CreateMaybeMessage<::ns3_ai_gym::FlatDictSpace>(Arena*);
 template<> ::ns3_ai_gym::SimInitAck* Arena::CreateMaybeMessage<::ns3_ai_gym::SimInitAck>(Arena*);
 template<> ::ns3_ai_gym::SimInitMsg* Arena::CreateMaybeMessage<::ns3_ai_gym::SimInitMsg>(Arena*);
 template<> ::ns3_ai_gym::SpaceDescription* Arena::CreateMaybeMessage<::ns3_ai_gym::SpaceDescription>(Arena*);
@@ -172,12 +180,13 @@ enum SpaceType : int {
   Box = 2,
   Tuple = 3,
   Dict = 4,
+  FlatDict = 5,
   SpaceType_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
   SpaceType_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
 };
 bool SpaceType_IsValid(int value);
 constexpr SpaceType SpaceType_MIN = NoSpaceType;
-constexpr SpaceType SpaceType_MAX = Dict;
+constexpr SpaceType SpaceType_MAX = FlatDict;
 constexpr int SpaceType_ARRAYSIZE = SpaceType_MAX + 1;
 
 const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* SpaceType_descriptor();
@@ -1065,6 +1074,214 @@ class DictSpace final :
 };
 // -------------------------------------------------------------------
 
+class FlatDictSpace final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:ns3_ai_gym.FlatDictSpace) */ {
+ public:
+  inline FlatDictSpace() : FlatDictSpace(nullptr) {}
+  ~FlatDictSpace() override;
+  explicit PROTOBUF_CONSTEXPR FlatDictSpace(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  FlatDictSpace(const FlatDictSpace& from);
+  FlatDictSpace(FlatDictSpace&& from) noexcept
+    : FlatDictSpace() {
+    *this = ::std::move(from);
+  }
+
+  inline FlatDictSpace& operator=(const FlatDictSpace& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline FlatDictSpace& operator=(FlatDictSpace&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const FlatDictSpace& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const FlatDictSpace* internal_default_instance() {
+    return reinterpret_cast<const FlatDictSpace*>(
+               &_FlatDictSpace_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    5;
+
+  friend void swap(FlatDictSpace& a, FlatDictSpace& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(FlatDictSpace* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(FlatDictSpace* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  FlatDictSpace* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<FlatDictSpace>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const FlatDictSpace& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const FlatDictSpace& from) {
+    FlatDictSpace::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(FlatDictSpace* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "ns3_ai_gym.FlatDictSpace";
+  }
+  protected:
+  explicit FlatDictSpace(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kKeyIdFieldNumber = 1,
+    kKeyFieldNumber = 2,
+    kElementFieldNumber = 3,
+  };
+  // repeated uint32 keyId = 1;
+  int keyid_size() const;
+  private:
+  int _internal_keyid_size() const;
+  public:
+  void clear_keyid();
+  private:
+  uint32_t _internal_keyid(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_keyid() const;
+  void _internal_add_keyid(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_keyid();
+  public:
+  uint32_t keyid(int index) const;
+  void set_keyid(int index, uint32_t value);
+  void add_keyid(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      keyid() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_keyid();
+
+  // repeated string key = 2;
+  int key_size() const;
+  private:
+  int _internal_key_size() const;
+  public:
+  void clear_key();
+  const std::string& key(int index) const;
+  std::string* mutable_key(int index);
+  void set_key(int index, const std::string& value);
+  void set_key(int index, std::string&& value);
+  void set_key(int index, const char* value);
+  void set_key(int index, const char* value, size_t size);
+  std::string* add_key();
+  void add_key(const std::string& value);
+  void add_key(std::string&& value);
+  void add_key(const char* value);
+  void add_key(const char* value, size_t size);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& key() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_key();
+  private:
+  const std::string& _internal_key(int index) const;
+  std::string* _internal_add_key();
+  public:
+
+  // repeated .ns3_ai_gym.SpaceDescription element = 3;
+  int element_size() const;
+  private:
+  int _internal_element_size() const;
+  public:
+  void clear_element();
+  ::ns3_ai_gym::SpaceDescription* mutable_element(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::SpaceDescription >*
+      mutable_element();
+  private:
+  const ::ns3_ai_gym::SpaceDescription& _internal_element(int index) const;
+  ::ns3_ai_gym::SpaceDescription* _internal_add_element();
+  public:
+  const ::ns3_ai_gym::SpaceDescription& element(int index) const;
+  ::ns3_ai_gym::SpaceDescription* add_element();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::SpaceDescription >&
+      element() const;
+
+  // @@protoc_insertion_point(class_scope:ns3_ai_gym.FlatDictSpace)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > keyid_;
+    mutable std::atomic<int> _keyid_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> key_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::SpaceDescription > element_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_messages_2eproto;
+};
+// -------------------------------------------------------------------
+
 class DataContainer final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:ns3_ai_gym.DataContainer) */ {
  public:
@@ -1113,7 +1330,7 @@ class DataContainer final :
                &_DataContainer_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    5;
+    6;
 
   friend void swap(DataContainer& a, DataContainer& b) {
     a.Swap(&b);
@@ -1297,7 +1514,7 @@ class DiscreteDataContainer final :
                &_DiscreteDataContainer_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    6;
+    7;
 
   friend void swap(DiscreteDataContainer& a, DiscreteDataContainer& b) {
     a.Swap(&b);
@@ -1445,7 +1662,7 @@ class BoxDataContainer final :
                &_BoxDataContainer_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    7;
+    8;
 
   friend void swap(BoxDataContainer& a, BoxDataContainer& b) {
     a.Swap(&b);
@@ -1716,7 +1933,7 @@ class TupleDataContainer final :
                &_TupleDataContainer_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    8;
+    9;
 
   friend void swap(TupleDataContainer& a, TupleDataContainer& b) {
     a.Swap(&b);
@@ -1873,7 +2090,7 @@ class DictDataContainer final :
                &_DictDataContainer_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    9;
+    10;
 
   friend void swap(DictDataContainer& a, DictDataContainer& b) {
     a.Swap(&b);
@@ -1982,6 +2199,188 @@ class DictDataContainer final :
 };
 // -------------------------------------------------------------------
 
+class FlatDictDataContainer final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:ns3_ai_gym.FlatDictDataContainer) */ {
+ public:
+  inline FlatDictDataContainer() : FlatDictDataContainer(nullptr) {}
+  ~FlatDictDataContainer() override;
+  explicit PROTOBUF_CONSTEXPR FlatDictDataContainer(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  FlatDictDataContainer(const FlatDictDataContainer& from);
+  FlatDictDataContainer(FlatDictDataContainer&& from) noexcept
+    : FlatDictDataContainer() {
+    *this = ::std::move(from);
+  }
+
+  inline FlatDictDataContainer& operator=(const FlatDictDataContainer& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline FlatDictDataContainer& operator=(FlatDictDataContainer&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const FlatDictDataContainer& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const FlatDictDataContainer* internal_default_instance() {
+    return reinterpret_cast<const FlatDictDataContainer*>(
+               &_FlatDictDataContainer_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    11;
+
+  friend void swap(FlatDictDataContainer& a, FlatDictDataContainer& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(FlatDictDataContainer* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(FlatDictDataContainer* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  FlatDictDataContainer* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<FlatDictDataContainer>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const FlatDictDataContainer& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const FlatDictDataContainer& from) {
+    FlatDictDataContainer::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(FlatDictDataContainer* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "ns3_ai_gym.FlatDictDataContainer";
+  }
+  protected:
+  explicit FlatDictDataContainer(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kKeyIdFieldNumber = 1,
+    kElementFieldNumber = 2,
+  };
+  // repeated uint32 keyId = 1;
+  int keyid_size() const;
+  private:
+  int _internal_keyid_size() const;
+  public:
+  void clear_keyid();
+  private:
+  uint32_t _internal_keyid(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      _internal_keyid() const;
+  void _internal_add_keyid(uint32_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      _internal_mutable_keyid();
+  public:
+  uint32_t keyid(int index) const;
+  void set_keyid(int index, uint32_t value);
+  void add_keyid(uint32_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+      keyid() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+      mutable_keyid();
+
+  // repeated .ns3_ai_gym.DataContainer element = 2;
+  int element_size() const;
+  private:
+  int _internal_element_size() const;
+  public:
+  void clear_element();
+  ::ns3_ai_gym::DataContainer* mutable_element(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::DataContainer >*
+      mutable_element();
+  private:
+  const ::ns3_ai_gym::DataContainer& _internal_element(int index) const;
+  ::ns3_ai_gym::DataContainer* _internal_add_element();
+  public:
+  const ::ns3_ai_gym::DataContainer& element(int index) const;
+  ::ns3_ai_gym::DataContainer* add_element();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::DataContainer >&
+      element() const;
+
+  // @@protoc_insertion_point(class_scope:ns3_ai_gym.FlatDictDataContainer)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t > keyid_;
+    mutable std::atomic<int> _keyid_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::DataContainer > element_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_messages_2eproto;
+};
+// -------------------------------------------------------------------
+
 class SimInitMsg final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:ns3_ai_gym.SimInitMsg) */ {
  public:
@@ -2030,7 +2429,7 @@ class SimInitMsg final :
                &_SimInitMsg_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    10;
+    12;
 
   friend void swap(SimInitMsg& a, SimInitMsg& b) {
     a.Swap(&b);
@@ -2105,6 +2504,7 @@ class SimInitMsg final :
   enum : int {
     kObsSpaceFieldNumber = 1,
     kActSpaceFieldNumber = 2,
+    kResetSupportedFieldNumber = 3,
   };
   // .ns3_ai_gym.SpaceDescription obsSpace = 1;
   bool has_obsspace() const;
@@ -2142,6 +2542,15 @@ class SimInitMsg final :
       ::ns3_ai_gym::SpaceDescription* actspace);
   ::ns3_ai_gym::SpaceDescription* unsafe_arena_release_actspace();
 
+  // bool resetSupported = 3;
+  void clear_resetsupported();
+  bool resetsupported() const;
+  void set_resetsupported(bool value);
+  private:
+  bool _internal_resetsupported() const;
+  void _internal_set_resetsupported(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:ns3_ai_gym.SimInitMsg)
  private:
   class _Internal;
@@ -2152,6 +2561,7 @@ class SimInitMsg final :
   struct Impl_ {
     ::ns3_ai_gym::SpaceDescription* obsspace_;
     ::ns3_ai_gym::SpaceDescription* actspace_;
+    bool resetsupported_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -2207,7 +2617,7 @@ class SimInitAck final :
                &_SimInitAck_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    11;
+    13;
 
   friend void swap(SimInitAck& a, SimInitAck& b) {
     a.Swap(&b);
@@ -2366,7 +2776,7 @@ class EnvStateMsg final :
                &_EnvStateMsg_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    12;
+    14;
 
   friend void swap(EnvStateMsg& a, EnvStateMsg& b) {
     a.Swap(&b);
@@ -2602,7 +3012,7 @@ class EnvActMsg final :
                &_EnvActMsg_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    13;
+    15;
 
   friend void swap(EnvActMsg& a, EnvActMsg& b) {
     a.Swap(&b);
@@ -2677,6 +3087,7 @@ class EnvActMsg final :
   enum : int {
     kActDataFieldNumber = 1,
     kStopSimReqFieldNumber = 2,
+    kResetSimReqFieldNumber = 3,
   };
   // .ns3_ai_gym.DataContainer actData = 1;
   bool has_actdata() const;
@@ -2705,6 +3116,15 @@ class EnvActMsg final :
   void _internal_set_stopsimreq(bool value);
   public:
 
+  // bool resetSimReq = 3;
+  void clear_resetsimreq();
+  bool resetsimreq() const;
+  void set_resetsimreq(bool value);
+  private:
+  bool _internal_resetsimreq() const;
+  void _internal_set_resetsimreq(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:ns3_ai_gym.EnvActMsg)
  private:
   class _Internal;
@@ -2715,6 +3135,7 @@ class EnvActMsg final :
   struct Impl_ {
     ::ns3_ai_gym::DataContainer* actdata_;
     bool stopsimreq_;
+    bool resetsimreq_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -3111,6 +3532,172 @@ DictSpace::element() const {
 
 // -------------------------------------------------------------------
 
+// FlatDictSpace
+
+// repeated uint32 keyId = 1;
+inline int FlatDictSpace::_internal_keyid_size() const {
+  return _impl_.keyid_.size();
+}
+inline int FlatDictSpace::keyid_size() const {
+  return _internal_keyid_size();
+}
+inline void FlatDictSpace::clear_keyid() {
+  _impl_.keyid_.Clear();
+}
+inline uint32_t FlatDictSpace::_internal_keyid(int index) const {
+  return _impl_.keyid_.Get(index);
+}
+inline uint32_t FlatDictSpace::keyid(int index) const {
+  // @@protoc_insertion_point(field_get:ns3_ai_gym.FlatDictSpace.keyId)
+  return _internal_keyid(index);
+}
+inline void FlatDictSpace::set_keyid(int index, uint32_t value) {
+  _impl_.keyid_.Set(index, value);
+  // @@protoc_insertion_point(field_set:ns3_ai_gym.FlatDictSpace.keyId)
+}
+inline void FlatDictSpace::_internal_add_keyid(uint32_t value) {
+  _impl_.keyid_.Add(value);
+}
+inline void FlatDictSpace::add_keyid(uint32_t value) {
+  _internal_add_keyid(value);
+  // @@protoc_insertion_point(field_add:ns3_ai_gym.FlatDictSpace.keyId)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+FlatDictSpace::_internal_keyid() const {
+  return _impl_.keyid_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+FlatDictSpace::keyid() const {
+  // @@protoc_insertion_point(field_list:ns3_ai_gym.FlatDictSpace.keyId)
+  return _internal_keyid();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+FlatDictSpace::_internal_mutable_keyid() {
+  return &_impl_.keyid_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+FlatDictSpace::mutable_keyid() {
+  // @@protoc_insertion_point(field_mutable_list:ns3_ai_gym.FlatDictSpace.keyId)
+  return _internal_mutable_keyid();
+}
+
+// repeated string key = 2;
+inline int FlatDictSpace::_internal_key_size() const {
+  return _impl_.key_.size();
+}
+inline int FlatDictSpace::key_size() const {
+  return _internal_key_size();
+}
+inline void FlatDictSpace::clear_key() {
+  _impl_.key_.Clear();
+}
+inline std::string* FlatDictSpace::add_key() {
+  std::string* _s = _internal_add_key();
+  // @@protoc_insertion_point(field_add_mutable:ns3_ai_gym.FlatDictSpace.key)
+  return _s;
+}
+inline const std::string& FlatDictSpace::_internal_key(int index) const {
+  return _impl_.key_.Get(index);
+}
+inline const std::string& FlatDictSpace::key(int index) const {
+  // @@protoc_insertion_point(field_get:ns3_ai_gym.FlatDictSpace.key)
+  return _internal_key(index);
+}
+inline std::string* FlatDictSpace::mutable_key(int index) {
+  // @@protoc_insertion_point(field_mutable:ns3_ai_gym.FlatDictSpace.key)
+  return _impl_.key_.Mutable(index);
+}
+inline void FlatDictSpace::set_key(int index, const std::string& value) {
+  _impl_.key_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set:ns3_ai_gym.FlatDictSpace.key)
+}
+inline void FlatDictSpace::set_key(int index, std::string&& value) {
+  _impl_.key_.Mutable(index)->assign(std::move(value));
+  // @@protoc_insertion_point(field_set:ns3_ai_gym.FlatDictSpace.key)
+}
+inline void FlatDictSpace::set_key(int index, const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.key_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:ns3_ai_gym.FlatDictSpace.key)
+}
+inline void FlatDictSpace::set_key(int index, const char* value, size_t size) {
+  _impl_.key_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:ns3_ai_gym.FlatDictSpace.key)
+}
+inline std::string* FlatDictSpace::_internal_add_key() {
+  return _impl_.key_.Add();
+}
+inline void FlatDictSpace::add_key(const std::string& value) {
+  _impl_.key_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:ns3_ai_gym.FlatDictSpace.key)
+}
+inline void FlatDictSpace::add_key(std::string&& value) {
+  _impl_.key_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:ns3_ai_gym.FlatDictSpace.key)
+}
+inline void FlatDictSpace::add_key(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  _impl_.key_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:ns3_ai_gym.FlatDictSpace.key)
+}
+inline void FlatDictSpace::add_key(const char* value, size_t size) {
+  _impl_.key_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:ns3_ai_gym.FlatDictSpace.key)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>&
+FlatDictSpace::key() const {
+  // @@protoc_insertion_point(field_list:ns3_ai_gym.FlatDictSpace.key)
+  return _impl_.key_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>*
+FlatDictSpace::mutable_key() {
+  // @@protoc_insertion_point(field_mutable_list:ns3_ai_gym.FlatDictSpace.key)
+  return &_impl_.key_;
+}
+
+// repeated .ns3_ai_gym.SpaceDescription element = 3;
+inline int FlatDictSpace::_internal_element_size() const {
+  return _impl_.element_.size();
+}
+inline int FlatDictSpace::element_size() const {
+  return _internal_element_size();
+}
+inline void FlatDictSpace::clear_element() {
+  _impl_.element_.Clear();
+}
+inline ::ns3_ai_gym::SpaceDescription* FlatDictSpace::mutable_element(int index) {
+  // @@protoc_insertion_point(field_mutable:ns3_ai_gym.FlatDictSpace.element)
+  return _impl_.element_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::SpaceDescription >*
+FlatDictSpace::mutable_element() {
+  // @@protoc_insertion_point(field_mutable_list:ns3_ai_gym.FlatDictSpace.element)
+  return &_impl_.element_;
+}
+inline const ::ns3_ai_gym::SpaceDescription& FlatDictSpace::_internal_element(int index) const {
+  return _impl_.element_.Get(index);
+}
+inline const ::ns3_ai_gym::SpaceDescription& FlatDictSpace::element(int index) const {
+  // @@protoc_insertion_point(field_get:ns3_ai_gym.FlatDictSpace.element)
+  return _internal_element(index);
+}
+inline ::ns3_ai_gym::SpaceDescription* FlatDictSpace::_internal_add_element() {
+  return _impl_.element_.Add();
+}
+inline ::ns3_ai_gym::SpaceDescription* FlatDictSpace::add_element() {
+  ::ns3_ai_gym::SpaceDescription* _add = _internal_add_element();
+  // @@protoc_insertion_point(field_add:ns3_ai_gym.FlatDictSpace.element)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::SpaceDescription >&
+FlatDictSpace::element() const {
+  // @@protoc_insertion_point(field_list:ns3_ai_gym.FlatDictSpace.element)
+  return _impl_.element_;
+}
+
+// -------------------------------------------------------------------
+
 // DataContainer
 
 // .ns3_ai_gym.SpaceType type = 1;
@@ -3641,6 +4228,97 @@ DictDataContainer::element() const {
 
 // -------------------------------------------------------------------
 
+// FlatDictDataContainer
+
+// repeated uint32 keyId = 1;
+inline int FlatDictDataContainer::_internal_keyid_size() const {
+  return _impl_.keyid_.size();
+}
+inline int FlatDictDataContainer::keyid_size() const {
+  return _internal_keyid_size();
+}
+inline void FlatDictDataContainer::clear_keyid() {
+  _impl_.keyid_.Clear();
+}
+inline uint32_t FlatDictDataContainer::_internal_keyid(int index) const {
+  return _impl_.keyid_.Get(index);
+}
+inline uint32_t FlatDictDataContainer::keyid(int index) const {
+  // @@protoc_insertion_point(field_get:ns3_ai_gym.FlatDictDataContainer.keyId)
+  return _internal_keyid(index);
+}
+inline void FlatDictDataContainer::set_keyid(int index, uint32_t value) {
+  _impl_.keyid_.Set(index, value);
+  // @@protoc_insertion_point(field_set:ns3_ai_gym.FlatDictDataContainer.keyId)
+}
+inline void FlatDictDataContainer::_internal_add_keyid(uint32_t value) {
+  _impl_.keyid_.Add(value);
+}
+inline void FlatDictDataContainer::add_keyid(uint32_t value) {
+  _internal_add_keyid(value);
+  // @@protoc_insertion_point(field_add:ns3_ai_gym.FlatDictDataContainer.keyId)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+FlatDictDataContainer::_internal_keyid() const {
+  return _impl_.keyid_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >&
+FlatDictDataContainer::keyid() const {
+  // @@protoc_insertion_point(field_list:ns3_ai_gym.FlatDictDataContainer.keyId)
+  return _internal_keyid();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+FlatDictDataContainer::_internal_mutable_keyid() {
+  return &_impl_.keyid_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint32_t >*
+FlatDictDataContainer::mutable_keyid() {
+  // @@protoc_insertion_point(field_mutable_list:ns3_ai_gym.FlatDictDataContainer.keyId)
+  return _internal_mutable_keyid();
+}
+
+// repeated .ns3_ai_gym.DataContainer element = 2;
+inline int FlatDictDataContainer::_internal_element_size() const {
+  return _impl_.element_.size();
+}
+inline int FlatDictDataContainer::element_size() const {
+  return _internal_element_size();
+}
+inline void FlatDictDataContainer::clear_element() {
+  _impl_.element_.Clear();
+}
+inline ::ns3_ai_gym::DataContainer* FlatDictDataContainer::mutable_element(int index) {
+  // @@protoc_insertion_point(field_mutable:ns3_ai_gym.FlatDictDataContainer.element)
+  return _impl_.element_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::DataContainer >*
+FlatDictDataContainer::mutable_element() {
+  // @@protoc_insertion_point(field_mutable_list:ns3_ai_gym.FlatDictDataContainer.element)
+  return &_impl_.element_;
+}
+inline const ::ns3_ai_gym::DataContainer& FlatDictDataContainer::_internal_element(int index) const {
+  return _impl_.element_.Get(index);
+}
+inline const ::ns3_ai_gym::DataContainer& FlatDictDataContainer::element(int index) const {
+  // @@protoc_insertion_point(field_get:ns3_ai_gym.FlatDictDataContainer.element)
+  return _internal_element(index);
+}
+inline ::ns3_ai_gym::DataContainer* FlatDictDataContainer::_internal_add_element() {
+  return _impl_.element_.Add();
+}
+inline ::ns3_ai_gym::DataContainer* FlatDictDataContainer::add_element() {
+  ::ns3_ai_gym::DataContainer* _add = _internal_add_element();
+  // @@protoc_insertion_point(field_add:ns3_ai_gym.FlatDictDataContainer.element)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::ns3_ai_gym::DataContainer >&
+FlatDictDataContainer::element() const {
+  // @@protoc_insertion_point(field_list:ns3_ai_gym.FlatDictDataContainer.element)
+  return _impl_.element_;
+}
+
+// -------------------------------------------------------------------
+
 // SimInitMsg
 
 // .ns3_ai_gym.SpaceDescription obsSpace = 1;
@@ -3823,6 +4501,26 @@ inline void SimInitMsg::set_allocated_actspace(::ns3_ai_gym::SpaceDescription* a
   // @@protoc_insertion_point(field_set_allocated:ns3_ai_gym.SimInitMsg.actSpace)
 }
 
+// bool resetSupported = 3;
+inline void SimInitMsg::clear_resetsupported() {
+  _impl_.resetsupported_ = false;
+}
+inline bool SimInitMsg::_internal_resetsupported() const {
+  return _impl_.resetsupported_;
+}
+inline bool SimInitMsg::resetsupported() const {
+  // @@protoc_insertion_point(field_get:ns3_ai_gym.SimInitMsg.resetSupported)
+  return _internal_resetsupported();
+}
+inline void SimInitMsg::_internal_set_resetsupported(bool value) {
+  
+  _impl_.resetsupported_ = value;
+}
+inline void SimInitMsg::set_resetsupported(bool value) {
+  _internal_set_resetsupported(value);
+  // @@protoc_insertion_point(field_set:ns3_ai_gym.SimInitMsg.resetSupported)
+}
+
 // -------------------------------------------------------------------
 
 // SimInitAck
@@ -4185,6 +4883,26 @@ inline void EnvActMsg::set_stopsimreq(bool value) {
   // @@protoc_insertion_point(field_set:ns3_ai_gym.EnvActMsg.stopSimReq)
 }
 
+// bool resetSimReq = 3;
+inline void EnvActMsg::clear_resetsimreq() {
+  _impl_.resetsimreq_ = false;
+}
+inline bool EnvActMsg::_internal_resetsimreq() const {
+  return _impl_.resetsimreq_;
+}
+inline bool EnvActMsg::resetsimreq() const {
+  // @@protoc_insertion_point(field_get:ns3_ai_gym.EnvActMsg.resetSimReq)
+  return _internal_resetsimreq();
+}
+inline void EnvActMsg::_internal_set_resetsimreq(bool value) {
+  
+  _impl_.resetsimreq_ = value;
+}
+inline void EnvActMsg::set_resetsimreq(bool value) {
+  _internal_set_resetsimreq(value);
+  // @@protoc_insertion_point(field_set:ns3_ai_gym.EnvActMsg.resetSimReq)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -4214,6 +4932,10 @@ inline void EnvActMsg::set_stopsimreq(bool value) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -23,8 +23,10 @@
 
 #include "ns3-ai-gym-interface.h"
 
+#include <ns3/fatal-error.h>
 #include <ns3/log.h>
 #include <ns3/object.h>
+#include <ns3/simulator.h>
 
 namespace ns3
 {
@@ -84,6 +86,38 @@ OpenGymEnv::NotifySimulationEnd()
     }
 }
 
+void
+OpenGymEnv::ResetScenario()
+{
+    NS_FATAL_ERROR("ResetScenario must be implemented to reset episodes in place");
+}
+
+void
+OpenGymEnv::RunEpisodes()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_openGymInterface, "No OpenGym interface set");
+    m_openGymInterface->SetResetSupported(true);
+
+    while (true)
+    {
+        Simulator::Run();
+        if (!m_openGymInterface->IsResetRequested())
+        {
+            // episode ran to its end: Python either resets or stops
+            NotifySimulationEnd();
+            if (!m_openGymInterface->IsResetRequested())
+            {
+                break;
+            }
+        }
+        NS_LOG_DEBUG("Resetting the episode in place");
+        Simulator::Destroy();
+        m_openGymInterface->ResetEpisode();
+        ResetScenario();
+    }
+}
+
 void
 OpenGymEnv::DoInitialize()
 {
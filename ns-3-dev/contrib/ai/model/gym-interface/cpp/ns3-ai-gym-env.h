@@ -94,6 +94,23 @@ class OpenGymEnv : public Object
      */
     void NotifySimulationEnd();
 
+    /**
+     * Rebuild the scenario for a new episode. Called by RunEpisodes after the
+     * previous episode has been stopped and Simulator::Destroy has been
+     * called; it must recreate nodes, devices, applications and the events
+     * that call Notify, and reset the environment's own state.
+     */
+    virtual void ResetScenario();
+
+    /**
+     * Run the scenario (which must already be set up) and keep serving
+     * episodes in this process: each reset requested by Python stops the
+     * simulation, destroys it, calls ResetScenario and runs again, instead of
+     * exiting and having Python launch a new process. Returns when Python
+     * stops the environment or closes it after the last episode.
+     */
+    void RunEpisodes();
+
   protected:
     // Inherited
     void DoInitialize() override;
@@ -29,11 +29,18 @@
 #include "container.h"
 #include "messages.pb.h"
 #include "ns3-ai-gym-env.h"
+#include "obs-history.h"
 #include "spaces.h"
 
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
 #include <ns3/config.h>
 #include <ns3/log.h>
+#include <ns3/ns3-ai-trajectory-recorder.h>
 #include <ns3/simulator.h>
+#include <ns3/string.h>
+
+#include <algorithm>
 
 namespace ns3
 {
@@ -41,6 +48,65 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("OpenGymInterface");
 NS_OBJECT_ENSURE_REGISTERED(OpenGymInterface);
 
+namespace
+{
+
+/**
+ * Copy the values of a Box container of type T, if data is one
+ */
+template <typename T>
+bool
+GetBoxValues(Ptr<OpenGymDataContainer> data, std::vector<float>& values)
+{
+    Ptr<OpenGymBoxContainer<T>> box = DynamicCast<OpenGymBoxContainer<T>>(data);
+    if (!box)
+    {
+        return false;
+    }
+    std::vector<T> boxData = box->GetData();
+    std::copy_n(boxData.begin(), std::min(boxData.size(), values.size()), values.begin());
+    return true;
+}
+
+/**
+ * Flatten a Box container into values, which keeps its size. Anything else
+ * (e.g. no action) is recorded as zeros.
+ */
+void
+FlattenBox(Ptr<OpenGymDataContainer> data, std::vector<float>& values)
+{
+    std::fill(values.begin(), values.end(), 0);
+    if (!data)
+    {
+        return;
+    }
+    bool isBox = GetBoxValues<float>(data, values) || GetBoxValues<double>(data, values) ||
+                 GetBoxValues<uint32_t>(data, values) || GetBoxValues<int32_t>(data, values) ||
+                 GetBoxValues<uint64_t>(data, values) || GetBoxValues<int64_t>(data, values);
+    if (!isBox)
+    {
+        NS_LOG_WARN("Not a Box container, recorded as zeros");
+    }
+}
+
+/**
+ * Get the number of elements of a Box space
+ */
+uint32_t
+GetBoxSize(Ptr<OpenGymSpace> space)
+{
+    Ptr<OpenGymBoxSpace> box = DynamicCast<OpenGymBoxSpace>(space);
+    NS_ABORT_MSG_IF(!box, "Trajectories can only be recorded with Box spaces");
+    uint32_t size = 1;
+    for (auto dim : box->GetShape())
+    {
+        size *= dim;
+    }
+    return size;
+}
+
+} // namespace
+
 Ptr<OpenGymInterface>
 OpenGymInterface::Get()
 {
@@ -51,7 +117,16 @@ OpenGymInterface::Get()
 OpenGymInterface::OpenGymInterface()
     : m_simEnd(false),
       m_stopEnvRequested(false),
-      m_initSimMsgSent(false)
+      m_initSimMsgSent(false),
+      m_resetSupported(false),
+      m_resetRequested(false),
+      m_actionPending(false),
+      m_skippedNotifications(0),
+      m_trajectoryReward(0),
+      m_trajectoryPending(false),
+      m_trajectoryDone(false),
+      m_trajectoryEpisode(0),
+      m_trajectoryStep(0)
 {
     auto interface = Ns3AiMsgInterface::Get();
     interface->SetIsMemoryCreator(false);
@@ -69,7 +144,57 @@ OpenGymInterface::GetTypeId()
     static TypeId tid = TypeId("OpenGymInterface")
                             .SetParent<Object>()
                             .SetGroupName("OpenGym")
-                            .AddConstructor<OpenGymInterface>();
+                            .AddConstructor<OpenGymInterface>()
+                            .AddAttribute("AsyncMode",
+                                          "If true, Notify publishes the state and returns "
+                                          "without waiting for the action",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&OpenGymInterface::m_asyncMode),
+                                          MakeBooleanChecker())
+                            .AddAttribute("DecisionDelay",
+                                          "Modeled agent latency between publishing a state "
+                                          "and executing its action (asynchronous mode only)",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&OpenGymInterface::m_decisionDelay),
+                                          MakeTimeChecker(Seconds(0)))
+                            .AddAttribute("PollInterval",
+                                          "Simulation time between two checks for an action "
+                                          "that has not arrived after DecisionDelay "
+                                          "(asynchronous mode only)",
+                                          TimeValue(MicroSeconds(100)),
+                                          MakeTimeAccessor(&OpenGymInterface::m_pollInterval),
+                                          MakeTimeChecker(NanoSeconds(1)))
+                            .AddAttribute("TrajectoryFile",
+                                          "File where the observations, actions, rewards "
+                                          "and game over flags are recorded for offline RL "
+                                          "(empty: not recorded). Records are appended to "
+                                          "an existing file with the same spaces",
+                                          StringValue(""),
+                                          MakeStringAccessor(&OpenGymInterface::m_trajectoryFile),
+                                          MakeStringChecker())
+                            .AddAttribute("SegmentName",
+                                          "Name of the shared memory segment created by Python "
+                                          "(empty: message interface default). Lets several "
+                                          "simulations run side by side, e.g. through "
+                                          "NS_ATTRIBUTE_DEFAULT",
+                                          StringValue(""),
+                                          MakeStringAccessor(&OpenGymInterface::m_segmentName),
+                                          MakeStringChecker())
+                            .AddAttribute("Cpp2PyMsgName",
+                                          "Name of the C++ to Python message in the segment",
+                                          StringValue(""),
+                                          MakeStringAccessor(&OpenGymInterface::m_cpp2pyMsgName),
+                                          MakeStringChecker())
+                            .AddAttribute("Py2CppMsgName",
+                                          "Name of the Python to C++ message in the segment",
+                                          StringValue(""),
+                                          MakeStringAccessor(&OpenGymInterface::m_py2cppMsgName),
+                                          MakeStringChecker())
+                            .AddAttribute("LockableName",
+                                          "Name of the synchronization object in the segment",
+                                          StringValue(""),
+                                          MakeStringAccessor(&OpenGymInterface::m_lockableName),
+                                          MakeStringChecker());
     return tid;
 }
 
@@ -85,6 +210,10 @@ OpenGymInterface::Init()
 
     Ptr<OpenGymSpace> obsSpace = GetObservationSpace();
     Ptr<OpenGymSpace> actionSpace = GetActionSpace();
+    if (obsSpace && m_obsHistory)
+    {
+        obsSpace = m_obsHistory->TransformSpace(obsSpace);
+    }
 
     ns3_ai_gym::SimInitMsg simInitMsg;
     if (obsSpace)
@@ -99,6 +228,18 @@ OpenGymInterface::Init()
         spaceDesc = actionSpace->GetSpaceDescription();
         simInitMsg.mutable_actspace()->CopyFrom(spaceDesc);
     }
+    simInitMsg.set_resetsupported(m_resetSupported);
+
+    if (!m_trajectoryFile.empty())
+    {
+        OpenTrajectory(obsSpace, actionSpace);
+    }
+
+    // the segment is attached on first use, so the names must be set before
+    Ns3AiMsgInterface::Get()->SetNames(m_segmentName,
+                                       m_cpp2pyMsgName,
+                                       m_py2cppMsgName,
+                                       m_lockableName);
 
     // get the interface
     Ns3AiMsgInterfaceImpl<Ns3AiGymMsg, Ns3AiGymMsg>* msgInterface =
@@ -126,6 +267,10 @@ OpenGymInterface::Init()
     {
         NS_LOG_DEBUG("---Stop requested: " << stopSim);
         m_stopEnvRequested = true;
+        if (m_trajectory)
+        {
+            m_trajectory->Close();
+        }
         Simulator::Stop();
         Simulator::Destroy();
         std::exit(0);
@@ -139,15 +284,56 @@ OpenGymInterface::NotifyCurrentState()
     {
         Init();
     }
-    if (m_stopEnvRequested)
+    if (m_stopEnvRequested || m_resetRequested)
     {
         return;
     }
+    if (m_actionPending)
+    {
+        if (!m_simEnd)
+        {
+            // the previous decision is still in flight, only one state can be outstanding
+            m_skippedNotifications++;
+            NS_LOG_DEBUG("Action pending, skipping notification " << m_skippedNotifications);
+            return;
+        }
+        // simulation ended before the last action was applied: drain it
+        m_checkActionEvent.Cancel();
+        Ns3AiMsgInterfaceImpl<Ns3AiGymMsg, Ns3AiGymMsg>* msgInterface =
+            Ns3AiMsgInterface::Get()->GetInterface<Ns3AiGymMsg, Ns3AiGymMsg>();
+        ns3_ai_gym::EnvActMsg envActMsg;
+        msgInterface->CppRecvBegin();
+        envActMsg.ParseFromArray(msgInterface->GetPy2CppStruct()->buffer,
+                                 msgInterface->GetPy2CppStruct()->size);
+        msgInterface->CppRecvEnd();
+        m_actionPending = false;
+        if (m_resetSupported && envActMsg.resetsimreq())
+        {
+            // Python already moved on to the next episode
+            m_resetRequested = true;
+            return;
+        }
+    }
     // collect current env state
     Ptr<OpenGymDataContainer> obsDataContainer = GetObservation();
+    if (m_obsHistory)
+    {
+        obsDataContainer = m_obsHistory->Process(obsDataContainer);
+    }
     float reward = GetReward();
     bool isGameOver = IsGameOver();
     std::string extraInfo = GetExtraInfo();
+    if (m_trajectory && !m_trajectoryDone)
+    {
+        FlattenBox(obsDataContainer, m_trajectoryObs);
+        m_trajectoryReward = reward;
+        m_trajectoryPending = true;
+        if (isGameOver)
+        {
+            // no action follows the last observation
+            RecordTransition(nullptr, true);
+        }
+    }
     ns3_ai_gym::EnvStateMsg envStateMsg;
     // observation
     ns3_ai_gym::DataContainer obsDataContainerPbMsg;
@@ -188,6 +374,15 @@ OpenGymInterface::NotifyCurrentState()
 
     msgInterface->CppSendEnd();
 
+    if (m_asyncMode && !m_simEnd)
+    {
+        // keep running with the previous action, the new one is picked up later
+        m_actionPending = true;
+        m_checkActionEvent =
+            Simulator::Schedule(m_decisionDelay, &OpenGymInterface::CheckPendingActions, this);
+        return;
+    }
+
     // receive act msg from python
     ns3_ai_gym::EnvActMsg envActMsg;
     msgInterface->CppRecvBegin();
@@ -198,27 +393,112 @@ OpenGymInterface::NotifyCurrentState()
 
     if (m_simEnd)
     {
-        // if sim end only rx msg and quit
+        // if sim end only rx msg and quit, unless a new episode is requested
+        m_resetRequested = m_resetSupported && envActMsg.resetsimreq();
         return;
     }
 
+    ProcessEnvActMsg(envActMsg);
+}
+
+void
+OpenGymInterface::CheckPendingActions()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_actionPending);
+
+    Ns3AiMsgInterfaceImpl<Ns3AiGymMsg, Ns3AiGymMsg>* msgInterface =
+        Ns3AiMsgInterface::Get()->GetInterface<Ns3AiGymMsg, Ns3AiGymMsg>();
+
+    if (!msgInterface->CppTryRecvBegin())
+    {
+        // the agent is slower than the modeled decision delay
+        m_checkActionEvent =
+            Simulator::Schedule(m_pollInterval, &OpenGymInterface::CheckPendingActions, this);
+        return;
+    }
+
+    ns3_ai_gym::EnvActMsg envActMsg;
+    envActMsg.ParseFromArray(msgInterface->GetPy2CppStruct()->buffer,
+                             msgInterface->GetPy2CppStruct()->size);
+    msgInterface->CppRecvEnd();
+    m_actionPending = false;
+
+    ProcessEnvActMsg(envActMsg);
+}
+
+void
+OpenGymInterface::ProcessEnvActMsg(const ns3_ai_gym::EnvActMsg& envActMsg)
+{
     bool stopSim = envActMsg.stopsimreq();
     if (stopSim)
     {
         NS_LOG_DEBUG("---Stop requested: " << stopSim);
         m_stopEnvRequested = true;
+        if (m_trajectory)
+        {
+            m_trajectory->Close();
+        }
         Simulator::Stop();
         Simulator::Destroy();
         std::exit(0);
     }
 
+    if (envActMsg.resetsimreq())
+    {
+        NS_ABORT_MSG_IF(!m_resetSupported, "Reset requested but not supported by the simulation");
+        NS_LOG_DEBUG("---Reset requested");
+        m_resetRequested = true;
+        Simulator::Stop();
+        return;
+    }
+
     // first step after reset is called without actions, just to get current state
     ns3_ai_gym::DataContainer actDataContainerPbMsg = envActMsg.actdata();
     Ptr<OpenGymDataContainer> actDataContainer =
         OpenGymDataContainer::CreateFromDataContainerPbMsg(actDataContainerPbMsg);
+    if (m_trajectoryPending)
+    {
+        RecordTransition(actDataContainer, false);
+    }
     ExecuteActions(actDataContainer);
 }
 
+void
+OpenGymInterface::OpenTrajectory(Ptr<OpenGymSpace> obsSpace, Ptr<OpenGymSpace> actionSpace)
+{
+    NS_LOG_FUNCTION(this << m_trajectoryFile);
+    uint32_t obsSize = GetBoxSize(obsSpace);
+    uint32_t actSize = GetBoxSize(actionSpace);
+    m_trajectoryObs.assign(obsSize, 0);
+    m_trajectoryAct.assign(actSize, 0);
+
+    // observations and actions are flattened to float32 arrays
+    m_trajectory = Create<Ns3AiTrajectoryRecorder>();
+    m_trajectory->Open(m_trajectoryFile,
+                       obsSize * sizeof(float),
+                       actSize * sizeof(float),
+                       "(" + std::to_string(obsSize) + ",)<f4",
+                       "(" + std::to_string(actSize) + ",)<f4",
+                       true);
+    m_trajectoryEpisode = m_trajectory->GetNextEpisode();
+    m_trajectoryStep = 0;
+}
+
+void
+OpenGymInterface::RecordTransition(Ptr<OpenGymDataContainer> action, bool done)
+{
+    FlattenBox(action, m_trajectoryAct);
+    m_trajectory->Record(m_trajectoryEpisode,
+                         m_trajectoryStep++,
+                         m_trajectoryObs.data(),
+                         m_trajectoryAct.data(),
+                         m_trajectoryReward,
+                         done);
+    m_trajectoryPending = false;
+    m_trajectoryDone = done;
+}
+
 void
 OpenGymInterface::WaitForStop()
 {
@@ -364,6 +644,68 @@ OpenGymInterface::SetExecuteActionsCb(Callback<bool, Ptr<OpenGymDataContainer>>
     m_actionCb = cb;
 }
 
+void
+OpenGymInterface::SetAsyncMode(bool async, Time decisionDelay)
+{
+    NS_LOG_FUNCTION(this << async << decisionDelay);
+    NS_ABORT_MSG_IF(m_actionPending && !async,
+                    "Cannot leave asynchronous mode while an action is pending");
+    m_asyncMode = async;
+    m_decisionDelay = decisionDelay;
+}
+
+bool
+OpenGymInterface::IsAsyncMode() const
+{
+    return m_asyncMode;
+}
+
+void
+OpenGymInterface::SetObservationHistory(Ptr<OpenGymObsHistory> obsHistory)
+{
+    NS_LOG_FUNCTION(this << obsHistory);
+    NS_ABORT_MSG_IF(m_initSimMsgSent,
+                    "Observation history must be set before the first notification");
+    m_obsHistory = obsHistory;
+}
+
+void
+OpenGymInterface::SetResetSupported(bool supported)
+{
+    NS_LOG_FUNCTION(this << supported);
+    NS_ABORT_MSG_IF(m_initSimMsgSent, "Reset support must be set before the first notification");
+    m_resetSupported = supported;
+}
+
+bool
+OpenGymInterface::IsResetRequested() const
+{
+    return m_resetRequested;
+}
+
+void
+OpenGymInterface::ResetEpisode()
+{
+    NS_LOG_FUNCTION(this);
+    m_simEnd = false;
+    m_resetRequested = false;
+    // the reset request was the last reply, and pending events died with the simulator
+    m_actionPending = false;
+    m_checkActionEvent = EventId();
+    if (m_obsHistory)
+    {
+        m_obsHistory->ResetHistory();
+    }
+    if (m_trajectory)
+    {
+        // an observation cut by the reset has no action to go with
+        m_trajectoryPending = false;
+        m_trajectoryDone = false;
+        m_trajectoryEpisode++;
+        m_trajectoryStep = 0;
+    }
+}
+
 void
 OpenGymInterface::DoInitialize()
 {
@@ -374,6 +716,13 @@ void
 OpenGymInterface::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_checkActionEvent.Cancel();
+    m_obsHistory = nullptr;
+    if (m_trajectory)
+    {
+        m_trajectory->Close();
+        m_trajectory = nullptr;
+    }
 }
 
 void
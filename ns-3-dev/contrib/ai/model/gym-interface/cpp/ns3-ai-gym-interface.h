@@ -26,16 +26,27 @@
 
 #include <ns3/ai-module.h>
 #include <ns3/callback.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/ptr.h>
 #include <ns3/type-id.h>
 
+#include <vector>
+
+namespace ns3_ai_gym
+{
+class EnvActMsg;
+}
+
 namespace ns3
 {
 
 class OpenGymSpace;
 class OpenGymDataContainer;
 class OpenGymEnv;
+class OpenGymObsHistory;
+class Ns3AiTrajectoryRecorder;
 
 class OpenGymInterface : public Object
 {
@@ -68,6 +79,46 @@ class OpenGymInterface : public Object
 
     void Notify(Ptr<OpenGymEnv> entity);
 
+    /**
+     * Enable or disable the asynchronous action mode. In this mode
+     * NotifyCurrentState publishes the state and returns immediately; the
+     * simulation keeps running with the previous action, and the action
+     * returned by Python is executed in a scheduled event, no earlier than
+     * decisionDelay after the state was published.
+     */
+    void SetAsyncMode(bool async, Time decisionDelay = Seconds(0));
+
+    /**
+     * Whether the asynchronous action mode is enabled
+     */
+    bool IsAsyncMode() const;
+
+    /**
+     * Pass the observations through a history (frame stacking and
+     * normalization) stage before sending them. Must be set before the
+     * first notification, as it changes the observation space.
+     */
+    void SetObservationHistory(Ptr<OpenGymObsHistory> obsHistory);
+
+    /**
+     * Announce to Python (in the init message) that episodes can be reset
+     * in place, see OpenGymEnv::RunEpisodes
+     */
+    void SetResetSupported(bool supported);
+
+    /**
+     * Whether Python asked to reset the episode. The simulation is stopped
+     * when the request is received; further notifications are ignored until
+     * ResetEpisode is called.
+     */
+    bool IsResetRequested() const;
+
+    /**
+     * Clear the per-episode state after the scenario has been rebuilt. The
+     * segment and the spaces sent at init are kept.
+     */
+    void ResetEpisode();
+
   protected:
     // Inherited
     void DoInitialize() override;
@@ -77,9 +128,53 @@ class OpenGymInterface : public Object
     static Ptr<OpenGymInterface>* DoGet();
     //    static void Delete();
 
+    /**
+     * Scheduled in asynchronous mode to pick up the pending action, polling
+     * every m_pollInterval until Python has replied
+     */
+    void CheckPendingActions();
+    /**
+     * Handle the stop request or execute the actions carried by the message
+     */
+    void ProcessEnvActMsg(const ns3_ai_gym::EnvActMsg& envActMsg);
+    /**
+     * Open the trajectory file, once the spaces are known
+     */
+    void OpenTrajectory(Ptr<OpenGymSpace> obsSpace, Ptr<OpenGymSpace> actionSpace);
+    /**
+     * Record the last observation sent with the action taken on it (null if
+     * the episode is over)
+     */
+    void RecordTransition(Ptr<OpenGymDataContainer> action, bool done);
+
     bool m_simEnd;
     bool m_stopEnvRequested;
     bool m_initSimMsgSent;
+    bool m_resetSupported;
+    bool m_resetRequested;
+    Ptr<OpenGymObsHistory> m_obsHistory;
+
+    bool m_asyncMode;       //!< publish states without waiting for the action
+    Time m_decisionDelay;   //!< modeled agent latency in asynchronous mode
+    Time m_pollInterval;    //!< re-check period while the action is late
+    bool m_actionPending;   //!< a state was sent and its action is not applied yet
+    EventId m_checkActionEvent;
+    uint64_t m_skippedNotifications;
+
+    std::string m_trajectoryFile;              //!< empty: do not record
+    Ptr<Ns3AiTrajectoryRecorder> m_trajectory; //!< recorder of the transitions
+    std::vector<float> m_trajectoryObs;        //!< last observation sent, flattened
+    std::vector<float> m_trajectoryAct;        //!< scratch buffer for the action
+    float m_trajectoryReward;                  //!< reward sent with the observation
+    bool m_trajectoryPending;                  //!< the observation awaits its action
+    bool m_trajectoryDone;                     //!< the game over state is recorded
+    uint32_t m_trajectoryEpisode;              //!< episode number in the file
+    uint32_t m_trajectoryStep;                 //!< step number in the episode
+
+    std::string m_segmentName;
+    std::string m_cpp2pyMsgName;
+    std::string m_py2cppMsgName;
+    std::string m_lockableName;
 
     Callback<Ptr<OpenGymSpace>> m_actionSpaceCb;
     Callback<Ptr<OpenGymSpace>> m_observationSpaceCb;
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3-ai-gym-multi-agent-env.h"
+
+#include "container.h"
+#include "spaces.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(OpenGymMultiAgentEnv);
+NS_LOG_COMPONENT_DEFINE("OpenGymMultiAgentEnv");
+
+namespace
+{
+
+/**
+ * Escape a string to be used as a JSON string value
+ */
+std::string
+JsonEscape(const std::string& str)
+{
+    std::ostringstream oss;
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"':
+            oss << "\\\"";
+            break;
+        case '\\':
+            oss << "\\\\";
+            break;
+        case '\n':
+            oss << "\\n";
+            break;
+        case '\r':
+            oss << "\\r";
+            break;
+        case '\t':
+            oss << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                // other control characters are not allowed raw in a JSON string
+                oss << "\\u00" << std::hex << std::setw(2) << std::setfill('0')
+                    << static_cast<int>(c) << std::dec;
+            }
+            else
+            {
+                oss << c;
+            }
+        }
+    }
+    return oss.str();
+}
+
+/**
+ * Format a number as a JSON value: null if it is not finite, e.g. the reward of an
+ * empty window, since JSON has no NaN nor infinity
+ */
+std::string
+JsonNumber(double value)
+{
+    if (!std::isfinite(value))
+    {
+        return "null";
+    }
+    std::ostringstream oss;
+    oss << value;
+    return oss.str();
+}
+
+} // namespace
+
+OpenGymMultiAgentEnv::OpenGymMultiAgentEnv()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+OpenGymMultiAgentEnv::~OpenGymMultiAgentEnv()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+OpenGymMultiAgentEnv::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::OpenGymMultiAgentEnv")
+                            .SetParent<OpenGymEnv>()
+                            .SetGroupName("OpenGym")
+                            .AddConstructor<OpenGymMultiAgentEnv>();
+    return tid;
+}
+
+void
+OpenGymMultiAgentEnv::AddAgent(uint32_t agentId, Ptr<OpenGymEnv> agent)
+{
+    NS_LOG_FUNCTION(this << agentId << agent);
+    NS_ABORT_MSG_IF(!agent, "Agent " << agentId << " is null");
+    NS_ABORT_MSG_IF(m_agents.find(agentId) != m_agents.end(),
+                    "Agent " << agentId << " is already registered");
+    m_agents[agentId] = agent;
+    m_keyIds[agentId] = OpenGymFlatDictSpace::InternKey(AgentKey(agentId));
+}
+
+Ptr<OpenGymEnv>
+OpenGymMultiAgentEnv::GetAgent(uint32_t agentId) const
+{
+    auto it = m_agents.find(agentId);
+    if (it == m_agents.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+uint32_t
+OpenGymMultiAgentEnv::GetNAgents() const
+{
+    return m_agents.size();
+}
+
+std::string
+OpenGymMultiAgentEnv::AgentKey(uint32_t agentId)
+{
+    return "agent_" + std::to_string(agentId);
+}
+
+Ptr<OpenGymSpace>
+OpenGymMultiAgentEnv::GetActionSpace()
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<OpenGymFlatDictSpace> space = CreateObject<OpenGymFlatDictSpace>();
+    for (auto& [id, agent] : m_agents)
+    {
+        space->Add(AgentKey(id), agent->GetActionSpace());
+    }
+    return space;
+}
+
+Ptr<OpenGymSpace>
+OpenGymMultiAgentEnv::GetObservationSpace()
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<OpenGymFlatDictSpace> space = CreateObject<OpenGymFlatDictSpace>();
+    for (auto& [id, agent] : m_agents)
+    {
+        space->Add(AgentKey(id), agent->GetObservationSpace());
+    }
+    return space;
+}
+
+bool
+OpenGymMultiAgentEnv::GetGameOver()
+{
+    NS_LOG_FUNCTION(this);
+    bool gameOver = false;
+    for (auto& [id, agent] : m_agents)
+    {
+        gameOver = agent->GetGameOver() || gameOver;
+    }
+    return gameOver;
+}
+
+Ptr<OpenGymDataContainer>
+OpenGymMultiAgentEnv::GetObservation()
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<OpenGymFlatDictContainer> obs = CreateObject<OpenGymFlatDictContainer>();
+    for (auto& [id, agent] : m_agents)
+    {
+        obs->Add(m_keyIds[id], agent->GetObservation());
+    }
+    return obs;
+}
+
+float
+OpenGymMultiAgentEnv::GetReward()
+{
+    NS_LOG_FUNCTION(this);
+    float reward = 0.0;
+    m_rewards.clear();
+    for (auto& [id, agent] : m_agents)
+    {
+        m_rewards[id] = agent->GetReward();
+        reward += m_rewards[id];
+    }
+    return reward;
+}
+
+std::string
+OpenGymMultiAgentEnv::GetExtraInfo()
+{
+    NS_LOG_FUNCTION(this);
+    // the interface collects the reward before the extra info, so the
+    // per-agent rewards are those of the current state
+    std::ostringstream oss;
+    oss << "{";
+    for (auto it = m_agents.begin(); it != m_agents.end(); ++it)
+    {
+        if (it != m_agents.begin())
+        {
+            oss << ", ";
+        }
+        auto reward = m_rewards.find(it->first);
+        oss << "\"" << AgentKey(it->first) << "\": {\"reward\": "
+            << JsonNumber(reward != m_rewards.end() ? reward->second : 0.0) << ", \"info\": \""
+            << JsonEscape(it->second->GetExtraInfo()) << "\"}";
+    }
+    oss << "}";
+    return oss.str();
+}
+
+bool
+OpenGymMultiAgentEnv::ExecuteActions(Ptr<OpenGymDataContainer> action)
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<OpenGymFlatDictContainer> dict = DynamicCast<OpenGymFlatDictContainer>(action);
+    if (!dict)
+    {
+        // first step after reset carries no actions
+        return false;
+    }
+    bool reply = true;
+    for (auto& [id, agent] : m_agents)
+    {
+        Ptr<OpenGymDataContainer> agentAction = dict->Get(m_keyIds[id]);
+        if (agentAction)
+        {
+            reply = agent->ExecuteActions(agentAction) && reply;
+        }
+    }
+    return reply;
+}
+
+void
+OpenGymMultiAgentEnv::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_agents.clear();
+    m_keyIds.clear();
+    m_rewards.clear();
+    OpenGymEnv::DoDispose();
+}
+
+} // namespace ns3
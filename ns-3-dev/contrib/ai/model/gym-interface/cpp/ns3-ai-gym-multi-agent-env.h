@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef OPENGYM_MULTI_AGENT_ENV_H
+#define OPENGYM_MULTI_AGENT_ENV_H
+
+#include "ns3-ai-gym-env.h"
+
+#include <map>
+
+namespace ns3
+{
+
+/**
+ * \brief Environment that batches several agents into one Gym rendezvous.
+ *
+ * Each agent is an ordinary OpenGymEnv registered under an integer ID. The
+ * observation and action spaces are flat Dict spaces (OpenGymFlatDictSpace)
+ * keyed by AgentKey(id), interned when the agent is added, so a
+ * single Notify() sends the observations of all agents in one message and
+ * executes all the actions carried by the single reply. Agents must not call
+ * Notify() themselves.
+ *
+ * The reward is the sum of the agent rewards. Per-agent rewards and extra
+ * info are passed in the extra info as a JSON object, e.g.
+ * {"agent_0": {"reward": 1.5, "info": ""}, ...}.
+ */
+class OpenGymMultiAgentEnv : public OpenGymEnv
+{
+  public:
+    OpenGymMultiAgentEnv();
+    ~OpenGymMultiAgentEnv() override;
+
+    static TypeId GetTypeId();
+
+    /**
+     * Register an agent. Must be called before the first Notify(), as the
+     * spaces are sent to Python only once.
+     */
+    void AddAgent(uint32_t agentId, Ptr<OpenGymEnv> agent);
+
+    /**
+     * Get a registered agent, or nullptr if the ID is unknown
+     */
+    Ptr<OpenGymEnv> GetAgent(uint32_t agentId) const;
+
+    /**
+     * Get the number of registered agents
+     */
+    uint32_t GetNAgents() const;
+
+    /**
+     * Get the key of an agent in the Dict observation and action
+     */
+    static std::string AgentKey(uint32_t agentId);
+
+    // OpenGym interfaces, aggregated over the agents:
+    Ptr<OpenGymSpace> GetActionSpace() override;
+    Ptr<OpenGymSpace> GetObservationSpace() override;
+    bool GetGameOver() override;
+    Ptr<OpenGymDataContainer> GetObservation() override;
+    float GetReward() override;
+    std::string GetExtraInfo() override;
+    bool ExecuteActions(Ptr<OpenGymDataContainer> action) override;
+
+  protected:
+    // Inherited
+    void DoDispose() override;
+
+  private:
+    std::map<uint32_t, Ptr<OpenGymEnv>> m_agents;
+    std::map<uint32_t, uint32_t> m_keyIds; //!< interned AgentKey of each agent
+    std::map<uint32_t, float> m_rewards; //!< rewards collected by the last GetReward
+};
+
+} // end of namespace ns3
+
+#endif /* OPENGYM_MULTI_AGENT_ENV_H */
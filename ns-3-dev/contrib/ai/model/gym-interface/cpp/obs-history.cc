@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "obs-history.h"
+
+#include "container.h"
+#include "spaces.h"
+
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("OpenGymObsHistory");
+NS_OBJECT_ENSURE_REGISTERED(OpenGymObsHistory);
+
+namespace
+{
+
+/**
+ * Copy the values of a Box container of type T, if obs is one
+ */
+template <typename T>
+bool
+GetBoxValues(Ptr<OpenGymDataContainer> obs, std::vector<float>& values)
+{
+    Ptr<OpenGymBoxContainer<T>> box = DynamicCast<OpenGymBoxContainer<T>>(obs);
+    if (!box)
+    {
+        return false;
+    }
+    std::vector<T> data = box->GetData();
+    values.assign(data.begin(), data.end());
+    return true;
+}
+
+} // namespace
+
+TypeId
+OpenGymObsHistory::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::OpenGymObsHistory")
+            .SetParent<Object>()
+            .SetGroupName("OpenGym")
+            .AddConstructor<OpenGymObsHistory>()
+            .AddAttribute("HistoryLength",
+                          "Number of past observations stacked in each observation",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&OpenGymObsHistory::m_historyLength),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Normalize",
+                          "Normalize each element with its running mean and variance",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&OpenGymObsHistory::m_normalize),
+                          MakeBooleanChecker())
+            .AddAttribute("Epsilon",
+                          "Added to the variance to avoid dividing by zero",
+                          DoubleValue(1e-8),
+                          MakeDoubleAccessor(&OpenGymObsHistory::m_epsilon),
+                          MakeDoubleChecker<double>(0));
+    return tid;
+}
+
+OpenGymObsHistory::OpenGymObsHistory()
+    : m_obsSize(0),
+      m_head(0),
+      m_empty(true),
+      m_count(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+OpenGymObsHistory::~OpenGymObsHistory()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+OpenGymObsHistory::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Object::DoDispose();
+}
+
+Ptr<OpenGymSpace>
+OpenGymObsHistory::TransformSpace(Ptr<OpenGymSpace> space)
+{
+    NS_LOG_FUNCTION(this << space);
+    Ptr<OpenGymBoxSpace> box = DynamicCast<OpenGymBoxSpace>(space);
+    NS_ABORT_MSG_IF(!box, "Observation history only supports Box observation spaces");
+
+    m_obsShape = box->GetShape();
+    m_obsSize = 1;
+    for (auto dim : m_obsShape)
+    {
+        m_obsSize *= dim;
+    }
+    m_ring.assign(static_cast<size_t>(m_historyLength) * m_obsSize, 0);
+    m_stacked.assign(m_ring.size(), 0);
+    m_mean.assign(m_obsSize, 0);
+    m_m2.assign(m_obsSize, 0);
+    m_count = 0;
+    ResetHistory();
+
+    std::vector<uint32_t> shape{m_historyLength};
+    shape.insert(shape.end(), m_obsShape.begin(), m_obsShape.end());
+    float low = box->GetLow();
+    float high = box->GetHigh();
+    if (m_normalize)
+    {
+        low = -std::numeric_limits<float>::infinity();
+        high = std::numeric_limits<float>::infinity();
+    }
+    return CreateObject<OpenGymBoxSpace>(low, high, shape, TypeNameGet<float>());
+}
+
+Ptr<OpenGymDataContainer>
+OpenGymObsHistory::Process(Ptr<OpenGymDataContainer> obs)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_obsSize == 0, "TransformSpace must be called before Process");
+    if (!obs)
+    {
+        return obs;
+    }
+    bool isBox = GetBoxValues<float>(obs, m_values) || GetBoxValues<double>(obs, m_values) ||
+                 GetBoxValues<uint32_t>(obs, m_values) || GetBoxValues<int32_t>(obs, m_values) ||
+                 GetBoxValues<uint64_t>(obs, m_values) || GetBoxValues<int64_t>(obs, m_values);
+    NS_ABORT_MSG_IF(!isBox, "Observation history only supports Box observations");
+    NS_ABORT_MSG_IF(m_values.size() != m_obsSize,
+                    "Observation has " << m_values.size() << " elements instead of "
+                                       << m_obsSize);
+
+    if (m_normalize)
+    {
+        UpdateStatistics(m_values);
+        for (uint32_t i = 0; i < m_obsSize; ++i)
+        {
+            double variance = m_m2[i] / m_count;
+            m_values[i] = (m_values[i] - m_mean[i]) / std::sqrt(variance + m_epsilon);
+        }
+    }
+
+    if (m_empty)
+    {
+        // no history yet: repeat the first observation
+        for (uint32_t slot = 0; slot < m_historyLength; ++slot)
+        {
+            std::copy(m_values.begin(), m_values.end(), m_ring.begin() + slot * m_obsSize);
+        }
+        m_head = 0;
+        m_empty = false;
+    }
+    else
+    {
+        // overwrite the oldest observation, which makes the next one the oldest
+        std::copy(m_values.begin(), m_values.end(), m_ring.begin() + m_head * m_obsSize);
+        m_head = (m_head + 1) % m_historyLength;
+    }
+
+    // unroll the ring, oldest first
+    auto split = m_ring.begin() + m_head * m_obsSize;
+    auto next = std::copy(split, m_ring.end(), m_stacked.begin());
+    std::copy(m_ring.begin(), split, next);
+
+    std::vector<uint32_t> shape{m_historyLength};
+    shape.insert(shape.end(), m_obsShape.begin(), m_obsShape.end());
+    Ptr<OpenGymBoxContainer<float>> stacked = CreateObject<OpenGymBoxContainer<float>>(shape);
+    stacked->SetData(m_stacked);
+    return stacked;
+}
+
+void
+OpenGymObsHistory::ResetHistory()
+{
+    NS_LOG_FUNCTION(this);
+    m_head = 0;
+    m_empty = true;
+}
+
+const std::vector<double>&
+OpenGymObsHistory::GetMean() const
+{
+    return m_mean;
+}
+
+std::vector<double>
+OpenGymObsHistory::GetVariance() const
+{
+    std::vector<double> variance(m_m2.size(), 0);
+    if (m_count > 0)
+    {
+        for (size_t i = 0; i < m_m2.size(); ++i)
+        {
+            variance[i] = m_m2[i] / m_count;
+        }
+    }
+    return variance;
+}
+
+void
+OpenGymObsHistory::UpdateStatistics(const std::vector<float>& values)
+{
+    m_count++;
+    for (uint32_t i = 0; i < m_obsSize; ++i)
+    {
+        double delta = values[i] - m_mean[i];
+        m_mean[i] += delta / m_count;
+        m_m2[i] += delta * (values[i] - m_mean[i]);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef OPENGYM_OBS_HISTORY_H
+#define OPENGYM_OBS_HISTORY_H
+
+#include <ns3/object.h>
+
+#include <vector>
+
+namespace ns3
+{
+
+class OpenGymSpace;
+class OpenGymDataContainer;
+
+/**
+ * \brief Observation pipeline stage: normalization and frame stacking.
+ *
+ * Applied by OpenGymInterface to Box observations before they are sent to
+ * Python. Each observation is optionally normalized element-wise with running
+ * mean and variance (Welford's method), then pushed into a ring holding the
+ * last HistoryLength observations. The result is a single float Box of shape
+ * {HistoryLength, <observation shape>}, oldest observation first. At the start
+ * of an episode the ring is filled with the first observation.
+ */
+class OpenGymObsHistory : public Object
+{
+  public:
+    OpenGymObsHistory();
+    ~OpenGymObsHistory() override;
+
+    static TypeId GetTypeId();
+
+    /**
+     * Get the observation space seen by Python, given the one of the env
+     */
+    Ptr<OpenGymSpace> TransformSpace(Ptr<OpenGymSpace> space);
+
+    /**
+     * Update the statistics and the ring with an observation, and get the
+     * stacked (and normalized) history
+     */
+    Ptr<OpenGymDataContainer> Process(Ptr<OpenGymDataContainer> obs);
+
+    /**
+     * Forget the past observations, e.g. at the start of an episode. The
+     * normalization statistics are kept.
+     */
+    void ResetHistory();
+
+    /**
+     * Get the running mean of each observation element
+     */
+    const std::vector<double>& GetMean() const;
+
+    /**
+     * Get the running (population) variance of each observation element
+     */
+    std::vector<double> GetVariance() const;
+
+  protected:
+    // Inherited
+    void DoDispose() override;
+
+  private:
+    /**
+     * Update the running statistics with one observation (Welford)
+     */
+    void UpdateStatistics(const std::vector<float>& values);
+
+    uint32_t m_historyLength; //!< number of stacked observations
+    bool m_normalize;         //!< whether observations are normalized
+    double m_epsilon;         //!< added to the variance before division
+
+    std::vector<uint32_t> m_obsShape; //!< shape of a single observation
+    uint32_t m_obsSize;               //!< number of elements of a single observation
+    std::vector<float> m_values;      //!< scratch buffer for the current observation
+    std::vector<float> m_ring;        //!< m_historyLength observations, m_obsSize each
+    uint32_t m_head;                  //!< ring slot of the oldest observation
+    bool m_empty;                     //!< no observation since the last reset
+    std::vector<float> m_stacked;     //!< output buffer, oldest observation first
+
+    uint64_t m_count;           //!< number of observations in the statistics
+    std::vector<double> m_mean; //!< running mean per element
+    std::vector<double> m_m2;   //!< running sum of squared deviations per element
+};
+
+} // end of namespace ns3
+
+#endif /* OPENGYM_OBS_HISTORY_H */
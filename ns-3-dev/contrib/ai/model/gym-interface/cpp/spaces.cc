@@ -21,15 +21,40 @@
 
 #include "spaces.h"
 
+#include "ns3/abort.h"
 #include "ns3/log.h"
 #include "ns3/object.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("OpenGymSpace");
 NS_OBJECT_ENSURE_REGISTERED(OpenGymSpace);
 
+namespace
+{
+
+/**
+ * Interned keys of the flat dict spaces and containers
+ */
+struct FlatDictKeyTable
+{
+    std::unordered_map<std::string, uint32_t> ids; //!< key ID of each name
+    std::vector<std::string> names;                //!< name of each key ID
+};
+
+FlatDictKeyTable&
+GetFlatDictKeyTable()
+{
+    static FlatDictKeyTable table;
+    return table;
+}
+
+} // namespace
+
 TypeId
 OpenGymSpace::GetTypeId()
 {
@@ -445,4 +470,128 @@ OpenGymDictSpace::Print(std::ostream& where) const
     }
 }
 
+TypeId
+OpenGymFlatDictSpace::GetTypeId()
+{
+    static TypeId tid = TypeId("OpenGymFlatDictSpace")
+                            .SetParent<OpenGymSpace>()
+                            .SetGroupName("OpenGym")
+                            .AddConstructor<OpenGymFlatDictSpace>();
+    return tid;
+}
+
+OpenGymFlatDictSpace::OpenGymFlatDictSpace()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+OpenGymFlatDictSpace::~OpenGymFlatDictSpace()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+OpenGymFlatDictSpace::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_dict.clear();
+}
+
+void
+OpenGymFlatDictSpace::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+OpenGymFlatDictSpace::InternKey(const std::string& key)
+{
+    FlatDictKeyTable& table = GetFlatDictKeyTable();
+    auto [it, inserted] = table.ids.emplace(key, table.names.size());
+    if (inserted)
+    {
+        table.names.push_back(key);
+    }
+    return it->second;
+}
+
+const std::string&
+OpenGymFlatDictSpace::GetKeyName(uint32_t keyId)
+{
+    const FlatDictKeyTable& table = GetFlatDictKeyTable();
+    NS_ABORT_MSG_IF(keyId >= table.names.size(), "Unknown dict key ID " << keyId);
+    return table.names[keyId];
+}
+
+bool
+OpenGymFlatDictSpace::Add(std::string key, Ptr<OpenGymSpace> space)
+{
+    NS_LOG_FUNCTION(this << key);
+    uint32_t keyId = InternKey(key);
+    auto it = std::lower_bound(m_dict.begin(),
+                               m_dict.end(),
+                               keyId,
+                               [](const auto& entry, uint32_t id) { return entry.first < id; });
+    if (it != m_dict.end() && it->first == keyId)
+    {
+        return false;
+    }
+    m_dict.emplace(it, keyId, space);
+    return true;
+}
+
+Ptr<OpenGymSpace>
+OpenGymFlatDictSpace::Get(std::string key)
+{
+    NS_LOG_FUNCTION(this << key);
+    return Get(InternKey(key));
+}
+
+Ptr<OpenGymSpace>
+OpenGymFlatDictSpace::Get(uint32_t keyId)
+{
+    NS_LOG_FUNCTION(this << keyId);
+    auto it = std::lower_bound(m_dict.begin(),
+                               m_dict.end(),
+                               keyId,
+                               [](const auto& entry, uint32_t id) { return entry.first < id; });
+    if (it != m_dict.end() && it->first == keyId)
+    {
+        return it->second;
+    }
+    return nullptr;
+}
+
+ns3_ai_gym::SpaceDescription
+OpenGymFlatDictSpace::GetSpaceDescription()
+{
+    NS_LOG_FUNCTION(this);
+    ns3_ai_gym::SpaceDescription desc;
+    desc.set_type(ns3_ai_gym::FlatDict);
+
+    ns3_ai_gym::FlatDictSpace flatDictSpacePb;
+    for (const auto& [keyId, subSpace] : m_dict)
+    {
+        flatDictSpacePb.add_keyid(keyId);
+        flatDictSpacePb.add_key(GetKeyName(keyId));
+        *flatDictSpacePb.add_element() = subSpace->GetSpaceDescription();
+    }
+
+    desc.mutable_space()->PackFrom(flatDictSpacePb);
+    return desc;
+}
+
+void
+OpenGymFlatDictSpace::Print(std::ostream& where) const
+{
+    where << " FlatDictSpace: " << std::endl;
+
+    for (const auto& [keyId, subSpace] : m_dict)
+    {
+        where << "---" << GetKeyName(keyId) << "(" << keyId << "):";
+        subSpace->Print(where);
+        where << std::endl;
+    }
+}
+
 } // namespace ns3
@@ -180,6 +180,54 @@ class OpenGymDictSpace : public OpenGymSpace
     std::map<std::string, Ptr<OpenGymSpace>> m_dict;
 };
 
+/**
+ * \brief Dict space with keys interned to integer IDs.
+ *
+ * Keys are interned in a process-wide table when they are added, and the
+ * subspaces are kept in a vector sorted by key ID. The key names are only sent
+ * in the space description; the matching OpenGymFlatDictContainer only
+ * carries the key IDs.
+ */
+class OpenGymFlatDictSpace : public OpenGymSpace
+{
+  public:
+    OpenGymFlatDictSpace();
+    ~OpenGymFlatDictSpace() override;
+
+    static TypeId GetTypeId();
+
+    ns3_ai_gym::SpaceDescription GetSpaceDescription() override;
+
+    bool Add(std::string key, Ptr<OpenGymSpace> value);
+    Ptr<OpenGymSpace> Get(std::string key);
+    Ptr<OpenGymSpace> Get(uint32_t keyId);
+
+    /**
+     * Get the ID of a key, interning it on first use
+     */
+    static uint32_t InternKey(const std::string& key);
+    /**
+     * Get the name of an interned key
+     */
+    static const std::string& GetKeyName(uint32_t keyId);
+
+    void Print(std::ostream& where) const override;
+
+    friend std::ostream& operator<<(std::ostream& os, const Ptr<OpenGymFlatDictSpace> space)
+    {
+        space->Print(os);
+        return os;
+    }
+
+  protected:
+    // Inherited
+    void DoInitialize() override;
+    void DoDispose() override;
+
+  private:
+    std::vector<std::pair<uint32_t, Ptr<OpenGymSpace>>> m_dict; //!< sorted by key ID
+};
+
 } // end of namespace ns3
 
 #endif /* OPENGYM_SPACES_H */
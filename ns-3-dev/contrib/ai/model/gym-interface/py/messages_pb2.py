@@ -14,19 +14,19 @@ _sym_db = _symbol_database.Default()
 from google.protobuf import any_pb2 as google_dot_protobuf_dot_any__pb2
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0emessages.proto\x12\nns3_ai_gym\x1a\x19google/protobuf/any.proto\"j\n\x10SpaceDescription\x12#\n\x04type\x18\x01 \x01(\x0e\x32\x15.ns3_ai_gym.SpaceType\x12#\n\x05space\x18\x02 \x01(\x0b\x32\x14.google.protobuf.Any\x12\x0c\n\x04name\x18\x03 \x01(\t\"\x1a\n\rDiscreteSpace\x12\t\n\x01n\x18\x01 \x01(\x05\"V\n\x08\x42oxSpace\x12\x0b\n\x03low\x18\x01 \x01(\x02\x12\x0c\n\x04high\x18\x02 \x01(\x02\x12 \n\x05\x64type\x18\x03 \x01(\x0e\x32\x11.ns3_ai_gym.Dtype\x12\r\n\x05shape\x18\x04 \x03(\r\";\n\nTupleSpace\x12-\n\x07\x65lement\x18\x01 \x03(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\":\n\tDictSpace\x12-\n\x07\x65lement\x18\x01 \x03(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\"f\n\rDataContainer\x12#\n\x04type\x18\x01 \x01(\x0e\x32\x15.ns3_ai_gym.SpaceType\x12\"\n\x04\x64\x61ta\x18\x02 \x01(\x0b\x32\x14.google.protobuf.Any\x12\x0c\n\x04name\x18\x03 \x01(\t\"%\n\x15\x44iscreteDataContainer\x12\x0c\n\x04\x64\x61ta\x18\x01 \x01(\x05\"\x8d\x01\n\x10\x42oxDataContainer\x12 \n\x05\x64type\x18\x01 \x01(\x0e\x32\x11.ns3_ai_gym.Dtype\x12\r\n\x05shape\x18\x02 \x03(\r\x12\x0f\n\x07intData\x18\x03 \x03(\x05\x12\x10\n\x08uintData\x18\x04 \x03(\r\x12\x11\n\tfloatData\x18\x05 \x03(\x02\x12\x12\n\ndoubleData\x18\x06 \x03(\x01\"@\n\x12TupleDataContainer\x12*\n\x07\x65lement\x18\x01 \x03(\x0b\x32\x19.ns3_ai_gym.DataContainer\"?\n\x11\x44ictDataContainer\x12*\n\x07\x65lement\x18\x01 \x03(\x0b\x32\x19.ns3_ai_gym.DataContainer\"l\n\nSimInitMsg\x12.\n\x08obsSpace\x18\x01 \x01(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\x12.\n\x08\x61\x63tSpace\x18\x02 \x01(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\".\n\nSimInitAck\x12\x0c\n\x04\x64one\x18\x01 \x01(\x08\x12\x12\n\nstopSimReq\x18\x02 \x01(\x08\"\xc6\x01\n\x0b\x45nvStateMsg\x12*\n\x07obsData\x18\x01 \x01(\x0b\x32\x19.ns3_ai_gym.DataContainer\x12\x0e\n\x06reward\x18\x02 \x01(\x02\x12\x12\n\nisGameOver\x18\x03 \x01(\x08\x12.\n\x06reason\x18\x04 \x01(\x0e\x32\x1e.ns3_ai_gym.EnvStateMsg.Reason\x12\x0c\n\x04info\x18\x05 \x01(\t\")\n\x06Reason\x12\x11\n\rSimulationEnd\x10\x00\x12\x0c\n\x08GameOver\x10\x01\"K\n\tEnvActMsg\x12*\n\x07\x61\x63tData\x18\x01 \x01(\x0b\x32\x19.ns3_ai_gym.DataContainer\x12\x12\n\nstopSimReq\x18\x02 \x01(\x08*\x9c\x01\n\x07MsgType\x12\x0b\n\x07Unknown\x10\x00\x12\x08\n\x04Init\x10\x01\x12\x0f\n\x0b\x41\x63tionSpace\x10\x02\x12\x14\n\x10ObservationSpace\x10\x03\x12\x0e\n\nIsGameOver\x10\x04\x12\x0f\n\x0bObservation\x10\x05\x12\n\n\x06Reward\x10\x06\x12\r\n\tExtraInfo\x10\x07\x12\n\n\x06\x41\x63tion\x10\x08\x12\x0b\n\x07StopEnv\x10\t*H\n\tSpaceType\x12\x0f\n\x0bNoSpaceType\x10\x00\x12\x0c\n\x08\x44iscrete\x10\x01\x12\x07\n\x03\x42ox\x10\x02\x12\t\n\x05Tuple\x10\x03\x12\x08\n\x04\x44ict\x10\x04*>\n\x05\x44type\x12\x0b\n\x07NoDType\x10\x00\x12\x07\n\x03INT\x10\x01\x12\x08\n\x04UINT\x10\x02\x12\t\n\x05\x46LOAT\x10\x03\x12\n\n\x06\x44OUBLE\x10\x04\x62\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0emessages.proto\x12\nns3_ai_gym\x1a\x19google/protobuf/any.proto\"j\n\x10SpaceDescription\x12#\n\x04type\x18\x01 \x01(\x0e\x32\x15.ns3_ai_gym.SpaceType\x12#\n\x05space\x18\x02 \x01(\x0b\x32\x14.google.protobuf.Any\x12\x0c\n\x04name\x18\x03 \x01(\t\"\x1a\n\rDiscreteSpace\x12\t\n\x01n\x18\x01 \x01(\x05\"V\n\x08\x42oxSpace\x12\x0b\n\x03low\x18\x01 \x01(\x02\x12\x0c\n\x04high\x18\x02 \x01(\x02\x12 \n\x05\x64type\x18\x03 \x01(\x0e\x32\x11.ns3_ai_gym.Dtype\x12\r\n\x05shape\x18\x04 \x03(\r\";\n\nTupleSpace\x12-\n\x07\x65lement\x18\x01 \x03(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\":\n\tDictSpace\x12-\n\x07\x65lement\x18\x01 \x03(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\"Z\n\rFlatDictSpace\x12\r\n\x05keyId\x18\x01 \x03(\r\x12\x0b\n\x03key\x18\x02 \x03(\t\x12-\n\x07\x65lement\x18\x03 \x03(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\"f\n\rDataContainer\x12#\n\x04type\x18\x01 \x01(\x0e\x32\x15.ns3_ai_gym.SpaceType\x12\"\n\x04\x64\x61ta\x18\x02 \x01(\x0b\x32\x14.google.protobuf.Any\x12\x0c\n\x04name\x18\x03 \x01(\t\"%\n\x15\x44iscreteDataContainer\x12\x0c\n\x04\x64\x61ta\x18\x01 \x01(\x05\"\x8d\x01\n\x10\x42oxDataContainer\x12 \n\x05\x64type\x18\x01 \x01(\x0e\x32\x11.ns3_ai_gym.Dtype\x12\r\n\x05shape\x18\x02 \x03(\r\x12\x0f\n\x07intData\x18\x03 \x03(\x05\x12\x10\n\x08uintData\x18\x04 \x03(\r\x12\x11\n\tfloatData\x18\x05 \x03(\x02\x12\x12\n\ndoubleData\x18\x06 \x03(\x01\"@\n\x12TupleDataContainer\x12*\n\x07\x65lement\x18\x01 \x03(\x0b\x32\x19.ns3_ai_gym.DataContainer\"?\n\x11\x44ictDataContainer\x12*\n\x07\x65lement\x18\x01 \x03(\x0b\x32\x19.ns3_ai_gym.DataContainer\"R\n\x15\x46latDictDataContainer\x12\r\n\x05keyId\x18\x01 \x03(\r\x12*\n\x07\x65lement\x18\x02 \x03(\x0b\x32\x19.ns3_ai_gym.DataContainer\"\x84\x01\n\nSimInitMsg\x12.\n\x08obsSpace\x18\x01 \x01(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\x12.\n\x08\x61\x63tSpace\x18\x02 \x01(\x0b\x32\x1c.ns3_ai_gym.SpaceDescription\x12\x16\n\x0eresetSupported\x18\x03 \x01(\x08\".\n\nSimInitAck\x12\x0c\n\x04\x64one\x18\x01 \x01(\x08\x12\x12\n\nstopSimReq\x18\x02 \x01(\x08\"\xc6\x01\n\x0b\x45nvStateMsg\x12*\n\x07obsData\x18\x01 \x01(\x0b\x32\x19.ns3_ai_gym.DataContainer\x12\x0e\n\x06reward\x18\x02 \x01(\x02\x12\x12\n\nisGameOver\x18\x03 \x01(\x08\x12.\n\x06reason\x18\x04 \x01(\x0e\x32\x1e.ns3_ai_gym.EnvStateMsg.Reason\x12\x0c\n\x04info\x18\x05 \x01(\t\")\n\x06Reason\x12\x11\n\rSimulationEnd\x10\x00\x12\x0c\n\x08GameOver\x10\x01\"`\n\tEnvActMsg\x12*\n\x07\x61\x63tData\x18\x01 \x01(\x0b\x32\x19.ns3_ai_gym.DataContainer\x12\x12\n\nstopSimReq\x18\x02 \x01(\x08\x12\x13\n\x0bresetSimReq\x18\x03 \x01(\x08*\x9c\x01\n\x07MsgType\x12\x0b\n\x07Unknown\x10\x00\x12\x08\n\x04Init\x10\x01\x12\x0f\n\x0b\x41\x63tionSpace\x10\x02\x12\x14\n\x10ObservationSpace\x10\x03\x12\x0e\n\nIsGameOver\x10\x04\x12\x0f\n\x0bObservation\x10\x05\x12\n\n\x06Reward\x10\x06\x12\r\n\tExtraInfo\x10\x07\x12\n\n\x06\x41\x63tion\x10\x08\x12\x0b\n\x07StopEnv\x10\t*V\n\tSpaceType\x12\x0f\n\x0bNoSpaceType\x10\x00\x12\x0c\n\x08\x44iscrete\x10\x01\x12\x07\n\x03\x42ox\x10\x02\x12\t\n\x05Tuple\x10\x03\x12\x08\n\x04\x44ict\x10\x04\x12\x0c\n\x08\x46latDict\x10\x05*>\n\x05\x44type\x12\x0b\n\x07NoDType\x10\x00\x12\x07\n\x03INT\x10\x01\x12\x08\n\x04UINT\x10\x02\x12\t\n\x05\x46LOAT\x10\x03\x12\n\n\x06\x44OUBLE\x10\x04\x62\x06proto3')
 
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, globals())
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'messages_pb2', globals())
 if _descriptor._USE_C_DESCRIPTORS == False:
 
   DESCRIPTOR._options = None
-  _MSGTYPE._serialized_start=1257
-  _MSGTYPE._serialized_end=1413
-  _SPACETYPE._serialized_start=1415
-  _SPACETYPE._serialized_end=1487
-  _DTYPE._serialized_start=1489
-  _DTYPE._serialized_end=1551
+  _MSGTYPE._serialized_start=1479
+  _MSGTYPE._serialized_end=1635
+  _SPACETYPE._serialized_start=1637
+  _SPACETYPE._serialized_end=1723
+  _DTYPE._serialized_start=1725
+  _DTYPE._serialized_end=1787
   _SPACEDESCRIPTION._serialized_start=57
   _SPACEDESCRIPTION._serialized_end=163
   _DISCRETESPACE._serialized_start=165
@@ -37,24 +37,28 @@ if _descriptor._USE_C_DESCRIPTORS == False:
   _TUPLESPACE._serialized_end=340
   _DICTSPACE._serialized_start=342
   _DICTSPACE._serialized_end=400
-  _DATACONTAINER._serialized_start=402
-  _DATACONTAINER._serialized_end=504
-  _DISCRETEDATACONTAINER._serialized_start=506
-  _DISCRETEDATACONTAINER._serialized_end=543
-  _BOXDATACONTAINER._serialized_start=546
-  _BOXDATACONTAINER._serialized_end=687
-  _TUPLEDATACONTAINER._serialized_start=689
-  _TUPLEDATACONTAINER._serialized_end=753
-  _DICTDATACONTAINER._serialized_start=755
-  _DICTDATACONTAINER._serialized_end=818
-  _SIMINITMSG._serialized_start=820
-  _SIMINITMSG._serialized_end=928
-  _SIMINITACK._serialized_start=930
-  _SIMINITACK._serialized_end=976
-  _ENVSTATEMSG._serialized_start=979
-  _ENVSTATEMSG._serialized_end=1177
-  _ENVSTATEMSG_REASON._serialized_start=1136
-  _ENVSTATEMSG_REASON._serialized_end=1177
-  _ENVACTMSG._serialized_start=1179
-  _ENVACTMSG._serialized_end=1254
+  _FLATDICTSPACE._serialized_start=402
+  _FLATDICTSPACE._serialized_end=492
+  _DATACONTAINER._serialized_start=494
+  _DATACONTAINER._serialized_end=596
+  _DISCRETEDATACONTAINER._serialized_start=598
+  _DISCRETEDATACONTAINER._serialized_end=635
+  _BOXDATACONTAINER._serialized_start=638
+  _BOXDATACONTAINER._serialized_end=779
+  _TUPLEDATACONTAINER._serialized_start=781
+  _TUPLEDATACONTAINER._serialized_end=845
+  _DICTDATACONTAINER._serialized_start=847
+  _DICTDATACONTAINER._serialized_end=910
+  _FLATDICTDATACONTAINER._serialized_start=912
+  _FLATDICTDATACONTAINER._serialized_end=994
+  _SIMINITMSG._serialized_start=997
+  _SIMINITMSG._serialized_end=1129
+  _SIMINITACK._serialized_start=1131
+  _SIMINITACK._serialized_end=1177
+  _ENVSTATEMSG._serialized_start=1180
+  _ENVSTATEMSG._serialized_end=1378
+  _ENVSTATEMSG_REASON._serialized_start=1337
+  _ENVSTATEMSG_REASON._serialized_end=1378
+  _ENVACTMSG._serialized_start=1380
+  _ENVACTMSG._serialized_end=1476
 # @@protoc_insertion_point(module_scope)
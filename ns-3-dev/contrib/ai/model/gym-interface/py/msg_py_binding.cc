@@ -19,10 +19,114 @@
 
 #include <ns3/ai-module.h>
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
 namespace py = pybind11;
 
+namespace
+{
+
+/**
+ * Copy a repeated field of a box container into a NumPy array. The array gets
+ * the box shape when it matches the number of elements, else it is flat.
+ */
+template <typename T, typename Field>
+py::array
+BoxDataToArray(const Field& data, const google::protobuf::RepeatedField<uint32_t>& shape)
+{
+    std::vector<py::ssize_t> dims(shape.begin(), shape.end());
+    auto count = std::accumulate(dims.begin(),
+                                 dims.end(),
+                                 py::ssize_t{1},
+                                 std::multiplies<py::ssize_t>());
+    if (dims.empty() || count != data.size())
+    {
+        dims = {data.size()};
+    }
+    py::array_t<T> array(dims);
+    std::copy(data.begin(), data.end(), array.mutable_data());
+    return std::move(array);
+}
+
+/**
+ * Convert a data container to Python objects: Discrete to int, Box to a NumPy
+ * array, Tuple to tuple and Dict and FlatDict to dict, recursively. keyNames
+ * maps the FlatDict key IDs to their names; IDs missing from it are kept.
+ */
+py::object
+DataContainerToPy(const ns3_ai_gym::DataContainer& dataContainer, const py::dict& keyNames)
+{
+    switch (dataContainer.type())
+    {
+    case ns3_ai_gym::Discrete: {
+        ns3_ai_gym::DiscreteDataContainer discrete;
+        dataContainer.data().UnpackTo(&discrete);
+        return py::int_(discrete.data());
+    }
+    case ns3_ai_gym::Box: {
+        ns3_ai_gym::BoxDataContainer box;
+        dataContainer.data().UnpackTo(&box);
+        switch (box.dtype())
+        {
+        case ns3_ai_gym::INT:
+            return BoxDataToArray<int32_t>(box.intdata(), box.shape());
+        case ns3_ai_gym::UINT:
+            return BoxDataToArray<uint32_t>(box.uintdata(), box.shape());
+        case ns3_ai_gym::DOUBLE:
+            return BoxDataToArray<double>(box.doubledata(), box.shape());
+        default:
+            return BoxDataToArray<float>(box.floatdata(), box.shape());
+        }
+    }
+    case ns3_ai_gym::Tuple: {
+        ns3_ai_gym::TupleDataContainer tuple;
+        dataContainer.data().UnpackTo(&tuple);
+        py::tuple data(tuple.element_size());
+        for (int i = 0; i < tuple.element_size(); ++i)
+        {
+            data[i] = DataContainerToPy(tuple.element(i), keyNames);
+        }
+        return std::move(data);
+    }
+    case ns3_ai_gym::Dict: {
+        ns3_ai_gym::DictDataContainer dict;
+        dataContainer.data().UnpackTo(&dict);
+        py::dict data;
+        for (const auto& element : dict.element())
+        {
+            data[py::str(element.name())] = DataContainerToPy(element, keyNames);
+        }
+        return std::move(data);
+    }
+    case ns3_ai_gym::FlatDict: {
+        ns3_ai_gym::FlatDictDataContainer dict;
+        dataContainer.data().UnpackTo(&dict);
+        py::dict data;
+        int n = std::min(dict.keyid_size(), dict.element_size());
+        for (int i = 0; i < n; ++i)
+        {
+            py::object key = py::int_(dict.keyid(i));
+            if (keyNames.contains(key))
+            {
+                key = keyNames[key];
+            }
+            data[key] = DataContainerToPy(dict.element(i), keyNames);
+        }
+        return std::move(data);
+    }
+    default:
+        return py::none();
+    }
+}
+
+} // namespace
+
 PYBIND11_MODULE(ns3ai_gym_msg_py, m)
 {
     m.attr("msg_buffer_size") = MSG_BUFFER_SIZE;
@@ -40,6 +144,25 @@ PYBIND11_MODULE(ns3ai_gym_msg_py, m)
             return py::memoryview::from_memory((void*)msg.buffer, MSG_BUFFER_SIZE);
         });
 
+    m.def(
+        "decode_env_state",
+        [](const Ns3AiGymMsg& msg, const py::dict& keyNames) {
+            ns3_ai_gym::EnvStateMsg envStateMsg;
+            if (!envStateMsg.ParseFromArray(msg.buffer, msg.size))
+            {
+                throw std::runtime_error("Cannot parse EnvStateMsg");
+            }
+            return py::make_tuple(DataContainerToPy(envStateMsg.obsdata(), keyNames),
+                                  envStateMsg.reward(),
+                                  envStateMsg.isgameover(),
+                                  static_cast<int>(envStateMsg.reason()),
+                                  py::str(envStateMsg.info()));
+        },
+        py::arg("msg"),
+        py::arg("keyNames") = py::dict(),
+        "Parse an EnvStateMsg and return (obs, reward, isGameOver, reason, info), with Box "
+        "observations as NumPy arrays and FlatDict keys named after keyNames");
+
     py::class_<ns3::Ns3AiMsgInterfaceImpl<Ns3AiGymMsg, Ns3AiGymMsg>>(m, "Ns3AiMsgInterfaceImpl")
         .def(py::init<bool,
                       bool,
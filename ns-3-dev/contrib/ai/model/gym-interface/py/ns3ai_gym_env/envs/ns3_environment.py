@@ -1,3 +1,5 @@
+import os
+
 import numpy as np
 import gymnasium as gym
 from gymnasium import spaces
@@ -58,6 +60,23 @@ class Ns3Env(gym.Env):
 
             space = spaces.Dict(mySpaceDict)
 
+        elif spaceDesc.type == pb.FlatDict:
+            mySpaceDict = {}
+            keyIds = {}
+            flatDictSpacePb = pb.FlatDictSpace()
+            spaceDesc.space.Unpack(flatDictSpacePb)
+
+            # key names are only sent here; data containers carry the key IDs
+            for keyId, key, pbSubSpaceDesc in zip(flatDictSpacePb.keyId, flatDictSpacePb.key,
+                                                  flatDictSpacePb.element):
+                self.keyNames[keyId] = key
+                keyIds[key] = keyId
+                mySpaceDict[key] = self._create_space(pbSubSpaceDesc)
+
+            space = spaces.Dict(mySpaceDict)
+            # actions of this space are packed as FlatDict, in key ID order
+            space.ns3KeyIds = keyIds
+
         return space
 
     def _create_data(self, dataContainerPb):
@@ -73,16 +92,19 @@ class Ns3Env(gym.Env):
             # print(boxContainerPb.shape, boxContainerPb.dtype, boxContainerPb.uintData)
 
             if boxContainerPb.dtype == pb.INT:
-                data = boxContainerPb.intData
+                data = np.array(boxContainerPb.intData, dtype=np.int32)
             elif boxContainerPb.dtype == pb.UINT:
-                data = boxContainerPb.uintData
+                data = np.array(boxContainerPb.uintData, dtype=np.uint32)
             elif boxContainerPb.dtype == pb.DOUBLE:
-                data = boxContainerPb.doubleData
+                data = np.array(boxContainerPb.doubleData, dtype=np.float64)
             else:
-                data = boxContainerPb.floatData
+                data = np.array(boxContainerPb.floatData, dtype=np.float32)
 
-            # TODO: reshape using shape info
-            data = np.array(data)
+            # box shape when it matches the number of elements, else flat, as
+            # decode_env_state does
+            shape = tuple(boxContainerPb.shape)
+            if shape and int(np.prod(shape)) == data.size:
+                data = data.reshape(shape)
             return data
 
         elif dataContainerPb.type == pb.Tuple:
@@ -109,6 +131,15 @@ class Ns3Env(gym.Env):
             data = myDataDict
             return data
 
+        elif dataContainerPb.type == pb.FlatDict:
+            flatDictDataPb = pb.FlatDictDataContainer()
+            dataContainerPb.data.Unpack(flatDictDataPb)
+
+            keyNames = self.keyNames
+            data = {keyNames[keyId]: self._create_data(pbSubData)
+                    for keyId, pbSubData in zip(flatDictDataPb.keyId, flatDictDataPb.element)}
+            return data
+
     def initialize_env(self):
         simInitMsg = pb.SimInitMsg()
         self.msgInterface.PyRecvBegin()
@@ -118,6 +149,7 @@ class Ns3Env(gym.Env):
 
         self.action_space = self._create_space(simInitMsg.actSpace)
         self.observation_space = self._create_space(simInitMsg.obsSpace)
+        self.resetSupported = simInitMsg.resetSupported
 
         reply = pb.SimInitAck()
         reply.done = True
@@ -145,25 +177,48 @@ class Ns3Env(gym.Env):
         self.newStateRx = False
         return True
 
+    def send_reset_command(self):
+        reply = pb.EnvActMsg()
+        reply.resetSimReq = True
+
+        replyMsg = reply.SerializeToString()
+        assert len(replyMsg) <= py_binding.msg_buffer_size
+        self.msgInterface.PySendBegin()
+        self.msgInterface.GetPy2CppStruct().size = len(replyMsg)
+        self.msgInterface.GetPy2CppStruct().get_buffer_full()[:len(replyMsg)] = replyMsg
+        self.msgInterface.PySendEnd()
+
+        self.newStateRx = False
+        return True
+
     def rx_env_state(self):
         if self.newStateRx:
             return
 
-        envStateMsg = pb.EnvStateMsg()
         self.msgInterface.PyRecvBegin()
-        request = self.msgInterface.GetCpp2PyStruct().get_buffer()
-        envStateMsg.ParseFromString(request)
-        self.msgInterface.PyRecvEnd()
-
-        self.obsData = self._create_data(envStateMsg.obsData)
-        self.reward = envStateMsg.reward
-        self.gameOver = envStateMsg.isGameOver
-        self.gameOverReason = envStateMsg.reason
-
-        if self.gameOver:
+        if self.nativeDecoder:
+            # decoded in C++ straight from shared memory into NumPy arrays
+            (self.obsData, self.reward, self.gameOver, self.gameOverReason,
+             info) = py_binding.decode_env_state(self.msgInterface.GetCpp2PyStruct(),
+                                                 self.keyNames)
+            self.msgInterface.PyRecvEnd()
+        else:
+            envStateMsg = pb.EnvStateMsg()
+            request = self.msgInterface.GetCpp2PyStruct().get_buffer()
+            envStateMsg.ParseFromString(request)
+            self.msgInterface.PyRecvEnd()
+
+            self.obsData = self._create_data(envStateMsg.obsData)
+            self.reward = envStateMsg.reward
+            self.gameOver = envStateMsg.isGameOver
+            self.gameOverReason = envStateMsg.reason
+            info = envStateMsg.info
+
+        # a simulation that resets in place waits for reset() or close()
+        if self.gameOver and not self.resetSupported:
             self.send_close_command()
 
-        self.extraInfo = envStateMsg.info
+        self.extraInfo = info
         if not self.extraInfo:
             self.extraInfo = {}
 
@@ -233,6 +288,20 @@ class Ns3Env(gym.Env):
             tupleDataPb.element.extend(subDataList)
             dataContainer.data.Pack(tupleDataPb)
 
+        elif spaceType == spaces.Dict and hasattr(spaceDesc, "ns3KeyIds"):
+            dataContainer.type = pb.FlatDict
+            flatDictDataPb = pb.FlatDictDataContainer()
+
+            subDataList = []
+            for sName, keyId in spaceDesc.ns3KeyIds.items():
+                if sName in actions:
+                    subData = self._pack_data(actions[sName], spaceDesc.spaces[sName])
+                    flatDictDataPb.keyId.append(keyId)
+                    subDataList.append(subData)
+
+            flatDictDataPb.element.extend(subDataList)
+            dataContainer.data.Pack(flatDictDataPb)
+
         elif spaceType == spaces.Dict:
             dataContainer.type = pb.Dict
             dictDataPb = pb.DictDataContainer()
@@ -271,12 +340,40 @@ class Ns3Env(gym.Env):
         extraInfo = {"info": self.get_extra_info()}
         return obs, reward, done, False, extraInfo
 
-    def __init__(self, targetName, ns3Path, ns3Settings=None, shmSize=4096):
+    # shared memory names in Experiment and the matching OpenGymInterface attributes
+    _shmAttributes = {
+        "segName": "OpenGymInterface::SegmentName",
+        "cpp2pyMsgName": "OpenGymInterface::Cpp2PyMsgName",
+        "py2cppMsgName": "OpenGymInterface::Py2CppMsgName",
+        "lockableName": "OpenGymInterface::LockableName",
+    }
+
+    def __init__(self, targetName, ns3Path, ns3Settings=None, shmSize=4096, shmNames=None,
+                 trajectoryFile=None, wait=True, build=True):
         if self._created:
             raise Exception('Error: Ns3Env is singleton')
         self._created = True
-        self.exp = Experiment(targetName, ns3Path, py_binding, shmSize=shmSize)
+        # shmNames: optional dict with keys of _shmAttributes, required to run
+        # several simulations side by side (each one needs its own segment)
+        if shmNames is None:
+            shmNames = {}
+        # trajectoryFile: optional file where the simulation records the transitions
+        # (see ns3ai_trajectory.load_trajectory), relative to the current directory
+        if trajectoryFile:
+            trajectoryFile = os.path.abspath(trajectoryFile)
+        self.exp = Experiment(targetName, ns3Path, py_binding, shmSize=shmSize, **shmNames)
         self.ns3Settings = ns3Settings
+        # build: False when the program was built beforehand (see Ns3VectorEnv), so
+        # that the relaunches do not run the build either
+        self.ns3Build = build
+        # the pure Python decoder is kept for bindings built without decode_env_state
+        self.nativeDecoder = hasattr(py_binding, "decode_env_state")
+        self.ns3ProcEnv = None
+        attributes = ["{}={}".format(self._shmAttributes[k], v) for k, v in shmNames.items()]
+        if trajectoryFile:
+            attributes.append("OpenGymInterface::TrajectoryFile={}".format(trajectoryFile))
+        if attributes:
+            self.ns3ProcEnv = {"NS_ATTRIBUTE_DEFAULT": ";".join(attributes)}
 
         self.newStateRx = False
         self.obsData = None
@@ -284,12 +381,26 @@ class Ns3Env(gym.Env):
         self.gameOver = False
         self.gameOverReason = None
         self.extraInfo = None
-
-        self.msgInterface = self.exp.run(setting=self.ns3Settings, show_output=True)
+        self.resetSupported = False
+        # names of the FlatDict key IDs, filled in when the spaces are received
+        self.keyNames = {}
+
+        # wait: False only starts the simulation; the caller then checks it with
+        # exp.check_started() and gets the first observation with attach(), which lets
+        # several simulations start up in parallel (see Ns3VectorEnv)
+        self.msgInterface = self.exp.start(setting=self.ns3Settings, show_output=True,
+                                           env=self.ns3ProcEnv, build=self.ns3Build)
+        if wait:
+            self.exp.check_started()
+            self.attach()
+
+    def attach(self):
+        """Receive the spaces and the first state of a simulation that was just started"""
         self.initialize_env()
         # get first observations
         self.rx_env_state()
         self.envDirty = False
+        return self.get_obs()
 
     def step(self, actions):
         self.send_actions(actions)
@@ -302,6 +413,29 @@ class Ns3Env(gym.Env):
             obs = self.get_obs()
             return obs, {}
 
+        if self.begin_reset():
+            self.exp.check_started()
+            return self.attach(), {}
+        return self.end_reset(), {}
+
+    def begin_reset(self):
+        """Start resetting the simulation without waiting for its first state.
+
+        Returns True when the simulation process was relaunched: the caller then checks
+        it with exp.check_started() and gets the first observation with attach().
+        Otherwise the simulation resets in place and end_reset() gets the observation.
+        """
+        if self.resetSupported:
+            # the simulation rebuilds the scenario in place and keeps the segment
+            self.rx_env_state()
+            self.send_reset_command()
+            self.obsData = None
+            self.reward = 0
+            self.gameOver = False
+            self.gameOverReason = None
+            self.extraInfo = None
+            return False
+
         # not using self.exp.kill() here in order for semaphores to reset to initial state
         if not self.gameOver:
             self.rx_env_state()
@@ -315,14 +449,15 @@ class Ns3Env(gym.Env):
         self.gameOverReason = None
         self.extraInfo = None
 
-        self.msgInterface = self.exp.run(show_output=True)
-        self.initialize_env()
-        # get first observations
+        self.msgInterface = self.exp.start(setting=self.ns3Settings, show_output=True,
+                                           env=self.ns3ProcEnv, build=self.ns3Build)
+        return True
+
+    def end_reset(self):
+        """Receive the first state of a simulation reset in place"""
         self.rx_env_state()
         self.envDirty = False
-
-        obs = self.get_obs()
-        return obs, {}
+        return self.get_obs()
 
     def render(self, mode='human'):
         return
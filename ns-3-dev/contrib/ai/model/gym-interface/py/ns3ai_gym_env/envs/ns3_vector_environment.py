@@ -0,0 +1,181 @@
+import os
+import time
+import uuid
+
+import numpy as np
+import gymnasium as gym
+from gymnasium.vector.utils import concatenate, create_empty_array, iterate
+
+from ns3ai_gym_env.envs.ns3_environment import Ns3Env
+from ns3ai_utils import SIMULATION_EARLY_ENDING, build_ns3
+
+
+class Ns3VectorEnv(gym.vector.VectorEnv):
+    """Vectorized environment stepping N ns-3 processes in parallel.
+
+    Every sub-environment is an Ns3Env running its own simulation with its own
+    shared memory segment. step_async() hands the actions to all simulations,
+    which then run concurrently; step_wait() collects their states and stacks
+    them into NumPy batches. A sub-environment that reaches game over is reset
+    automatically; its last observation and info are kept in
+    infos["final_observation"] and infos["final_info"].
+    """
+
+    def __init__(self, targetName, ns3Path, numEnvs, ns3Settings=None, shmSize=4096,
+                 trajectoryFile=None):
+        # one settings dict shared by all simulations, or a list with one per env
+        if ns3Settings is None or isinstance(ns3Settings, dict):
+            ns3Settings = [ns3Settings] * numEnvs
+        assert len(ns3Settings) == numEnvs
+
+        # resolved now, since the first Ns3Env changes the working directory
+        if trajectoryFile:
+            trajectoryFile = os.path.abspath(trajectoryFile)
+
+        # built once here, so that the simulations do not build concurrently
+        build_ns3(os.path.abspath(ns3Path), targetName)
+
+        tag = uuid.uuid4().hex[:8]
+        self.envs = []
+        for i in range(numEnvs):
+            shmNames = {
+                "segName": "Ns3VecSeg_{}_{}".format(tag, i),
+                "cpp2pyMsgName": "Ns3VecCpp2Py_{}_{}".format(tag, i),
+                "py2cppMsgName": "Ns3VecPy2Cpp_{}_{}".format(tag, i),
+                "lockableName": "Ns3VecLockable_{}_{}".format(tag, i),
+            }
+            # one trajectory file per simulation, suffixed with the env index
+            envTrajectoryFile = None
+            if trajectoryFile:
+                envTrajectoryFile = "{}.{}".format(trajectoryFile, i)
+            # all the simulations are started before waiting for any of them
+            self.envs.append(Ns3Env(targetName, ns3Path, ns3Settings=ns3Settings[i],
+                                    shmSize=shmSize, shmNames=shmNames,
+                                    trajectoryFile=envTrajectoryFile, wait=False,
+                                    build=False))
+        self._check_started(self.envs)
+        for env in self.envs:
+            env.attach()
+
+        # sets num_envs, the single and batched spaces, and closed
+        super().__init__(numEnvs, self.envs[0].observation_space, self.envs[0].action_space)
+
+        self._observations = create_empty_array(self.single_observation_space, n=numEnvs,
+                                                fn=np.zeros)
+        self._rewards = np.zeros((numEnvs,), dtype=np.float64)
+        self._terminations = np.zeros((numEnvs,), dtype=np.bool_)
+        self._truncations = np.zeros((numEnvs,), dtype=np.bool_)
+        self._actionsPending = False
+
+    def reset(self, seed=None, options=None):
+        self.reset_async(seed=seed, options=options)
+        return self.reset_wait(seed=seed, options=options)
+
+    def reset_async(self, seed=None, options=None):
+        pass
+
+    def reset_wait(self, seed=None, options=None):
+        obsList = self._reset_envs(range(self.num_envs))
+        self._terminations[:] = False
+        self._truncations[:] = False
+        self._observations = concatenate(self.single_observation_space, obsList,
+                                         self._observations)
+        return np.copy(self._observations), {}
+
+    def step(self, actions):
+        self.step_async(actions)
+        return self.step_wait()
+
+    def step_async(self, actions):
+        """Send the actions; the simulations run while the caller does other work"""
+        assert not self._actionsPending, "step_wait() must be called after step_async()"
+        for env, action in zip(self.envs, iterate(self.action_space, actions)):
+            env.send_actions(action)
+            env.envDirty = True
+        self._actionsPending = True
+
+    def step_wait(self):
+        """Collect the states of all simulations, resetting those that are over"""
+        assert self._actionsPending, "step_async() must be called before step_wait()"
+        self._actionsPending = False
+
+        obsList = []
+        infos = {}
+        finished = []
+        for i, env in enumerate(self.envs):
+            env.rx_env_state()
+            obs, reward, terminated, truncated, info = env.get_state()
+            self._rewards[i] = reward
+            self._terminations[i] = terminated
+            self._truncations[i] = truncated
+            obsList.append(obs)
+            infos = self._add_info(infos, info, i)
+            if terminated or truncated:
+                finished.append(i)
+
+        if finished:
+            infos["final_observation"] = np.full((self.num_envs,), None, dtype=object)
+            infos["final_info"] = np.full((self.num_envs,), None, dtype=object)
+            infos["_final_observation"] = np.zeros((self.num_envs,), dtype=np.bool_)
+            infos["_final_info"] = np.zeros((self.num_envs,), dtype=np.bool_)
+            for i in finished:
+                infos["final_observation"][i] = obsList[i]
+                infos["final_info"][i] = {k: v[i] for k, v in infos.items()
+                                          if not k.startswith("_") and k not in
+                                          ("final_observation", "final_info")}
+                infos["_final_observation"][i] = True
+                infos["_final_info"][i] = True
+            for i, obs in zip(finished, self._reset_envs(finished)):
+                obsList[i] = obs
+
+        self._observations = concatenate(self.single_observation_space, obsList,
+                                         self._observations)
+        return (np.copy(self._observations), np.copy(self._rewards),
+                np.copy(self._terminations), np.copy(self._truncations), infos)
+
+    def _reset_envs(self, indices):
+        """Reset the given sub-environments and return their first observations.
+
+        All of them start resetting, and the relaunched simulations all start up, before
+        waiting for any of them.
+        """
+        envs = [self.envs[i] for i in indices]
+        dirty = [env for env in envs if env.envDirty]
+        relaunched = [env for env in dirty if env.begin_reset()]
+        self._check_started(relaunched)
+        obsList = []
+        for env in envs:
+            if env in relaunched:
+                obsList.append(env.attach())
+            elif env in dirty:
+                obsList.append(env.end_reset())
+            else:
+                obsList.append(env.get_obs())
+        return obsList
+
+    @staticmethod
+    def _check_started(envs):
+        # one wait for all the simulations that were just started
+        if envs:
+            time.sleep(SIMULATION_EARLY_ENDING)
+        for env in envs:
+            env.exp.check_started(wait=False)
+
+    def _add_info(self, infos, info, i):
+        for k, v in info.items():
+            if k not in infos:
+                infos[k] = np.full((self.num_envs,), None, dtype=object)
+                infos["_" + k] = np.zeros((self.num_envs,), dtype=np.bool_)
+            infos[k][i] = v
+            infos["_" + k][i] = True
+        return infos
+
+    def close_extras(self, **kwargs):
+        for env in self.envs:
+            env.close()
+
+    def close(self, **kwargs):
+        if self.closed:
+            return
+        self.close_extras(**kwargs)
+        self.closed = True
@@ -24,6 +24,7 @@
 
 #include <ns3/singleton.h>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
@@ -51,6 +52,17 @@ struct Ns3AiMsgSync
     bool m_isFinished{false};
 };
 
+/**
+ * \brief Time one side of the msg interface spent waiting on a semaphore, i.e.
+ * waiting for the other side
+ */
+struct Ns3AiMsgWaitStats
+{
+    uint64_t m_calls{0};  //!< calls that took the semaphore
+    uint64_t m_waits{0};  //!< calls that found it taken, and spun
+    uint64_t m_waitNs{0}; //!< time spent spinning, in nanoseconds
+};
+
 /**
  * \brief A template class implementation of the message interface
  */
@@ -250,7 +262,7 @@ class Ns3AiMsgInterfaceImpl
      */
     void CppSendBegin()
     {
-        Ns3AiSemaphore::sem_wait(&m_sync->m_cpp2pyEmptyCount);
+        TimedWait(&m_sync->m_cpp2pyEmptyCount, m_cppSendWait);
     };
 
     /**
@@ -268,7 +280,17 @@ class Ns3AiMsgInterfaceImpl
      */
     void CppRecvBegin()
     {
-        Ns3AiSemaphore::sem_wait(&m_sync->m_py2cppFullCount);
+        TimedWait(&m_sync->m_py2cppFullCount, m_cppRecvWait);
+    };
+
+    /**
+     * Non-blocking version of CppRecvBegin. Returns true (and the C++ side
+     * may start reading) only if Python has already written a message;
+     * CppRecvEnd must then be called as usual.
+     */
+    bool CppTryRecvBegin()
+    {
+        return Ns3AiSemaphore::sem_try_wait(&m_sync->m_py2cppFullCount);
     };
 
     /**
@@ -303,7 +325,7 @@ class Ns3AiMsgInterfaceImpl
      */
     void PyRecvBegin()
     {
-        Ns3AiSemaphore::sem_wait(&m_sync->m_cpp2pyFullCount);
+        TimedWait(&m_sync->m_cpp2pyFullCount, m_pyRecvWait);
         if (m_handleFinish)
         {
             m_isFinished = m_sync->m_isFinished;
@@ -327,7 +349,7 @@ class Ns3AiMsgInterfaceImpl
     {
 
         // std::cout << "m_py2cppEmptyCount1: " << (int)m_sync->m_py2cppEmptyCount << "\n" << std::flush;
-        Ns3AiSemaphore::sem_wait(&m_sync->m_py2cppEmptyCount);
+        TimedWait(&m_sync->m_py2cppEmptyCount, m_pySendWait);
         // std::cout << "m_py2cppEmptyCount2: " << (int)m_sync->m_py2cppEmptyCount << "\n" << std::flush;
     };
 
@@ -351,7 +373,57 @@ class Ns3AiMsgInterfaceImpl
         return m_isFinished;
     };
 
+    /**
+     * Get the time CppSendBegin waited for Python to read the last message
+     */
+    const Ns3AiMsgWaitStats& GetCppSendWait() const
+    {
+        return m_cppSendWait;
+    }
+
+    /**
+     * Get the time CppRecvBegin waited for Python to send a message
+     */
+    const Ns3AiMsgWaitStats& GetCppRecvWait() const
+    {
+        return m_cppRecvWait;
+    }
+
+    /**
+     * Get the time PySendBegin waited for C++ to read the last message
+     */
+    const Ns3AiMsgWaitStats& GetPySendWait() const
+    {
+        return m_pySendWait;
+    }
+
+    /**
+     * Get the time PyRecvBegin waited for C++ to send a message
+     */
+    const Ns3AiMsgWaitStats& GetPyRecvWait() const
+    {
+        return m_pyRecvWait;
+    }
+
   private:
+    /**
+     * Wait on a semaphore; the clock is only read when it is taken
+     */
+    static void TimedWait(volatile uint8_t* sem, Ns3AiMsgWaitStats& stats)
+    {
+        stats.m_calls++;
+        if (Ns3AiSemaphore::sem_try_wait(sem))
+        {
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        Ns3AiSemaphore::sem_wait(sem);
+        stats.m_waits++;
+        stats.m_waitNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+    }
+
     Cpp2PyMsgType* m_cpp2pyStruct;
     Py2CppMsgType* m_py2CppStruct;
     Cpp2PyMsgVector* m_cpp2pyVector;
@@ -363,6 +435,10 @@ class Ns3AiMsgInterfaceImpl
     const bool m_handleFinish;
     const std::string m_segName;
     bool m_isFinished;
+    Ns3AiMsgWaitStats m_cppSendWait; //!< waits of CppSendBegin
+    Ns3AiMsgWaitStats m_cppRecvWait; //!< waits of CppRecvBegin
+    Ns3AiMsgWaitStats m_pySendWait;  //!< waits of PySendBegin
+    Ns3AiMsgWaitStats m_pyRecvWait;  //!< waits of PyRecvBegin
 };
 
 /**
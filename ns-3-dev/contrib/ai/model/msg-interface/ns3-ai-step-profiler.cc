@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3-ai-step-profiler.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ns3AiStepProfiler");
+
+namespace
+{
+
+const char PROFILE_MAGIC[8] = {'N', 'S', '3', 'A', 'I', 'P', 'R', 'F'};
+const uint32_t PROFILE_VERSION = 1;
+
+static_assert(sizeof(Ns3AiStepProfile::metrics) / sizeof(Ns3AiStepMetric) ==
+                  Ns3AiStepProfiler::MAX_METRICS,
+              "The profile must hold MAX_METRICS metrics");
+static_assert(sizeof(Ns3AiStepMetric::buckets) / sizeof(uint64_t) ==
+                  Ns3AiStepProfiler::NUM_BUCKETS,
+              "A metric must hold NUM_BUCKETS buckets");
+
+// a value of a metric, in the unit of the table of Print()
+double
+Scaled(const Ns3AiStepMetric& metric, double value)
+{
+    return metric.unit == Ns3AiStepProfiler::NANOSECONDS ? value / 1e6 : value;
+}
+
+} // namespace
+
+Ns3AiStepProfiler::Ns3AiStepProfiler()
+    : m_enabled(false),
+      m_profile(nullptr),
+      m_step{},
+      m_recorded(0)
+{
+    // shared, so that the processes forked during the run add to the same profile
+    void* map = mmap(nullptr,
+                     sizeof(Ns3AiStepProfile),
+                     PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS,
+                     -1,
+                     0);
+    NS_ABORT_MSG_IF(map == MAP_FAILED, "Cannot map a step profile: " << std::strerror(errno));
+    m_profile = static_cast<Ns3AiStepProfile*>(map);
+    std::memcpy(m_profile->magic, PROFILE_MAGIC, sizeof(m_profile->magic));
+    m_profile->version = PROFILE_VERSION;
+}
+
+Ns3AiStepProfiler::~Ns3AiStepProfiler()
+{
+    munmap(m_profile, sizeof(Ns3AiStepProfile));
+    if (!m_shmName.empty())
+    {
+        shm_unlink(m_shmName.c_str());
+    }
+}
+
+void
+Ns3AiStepProfiler::Enable(const std::string& shmName)
+{
+    NS_LOG_FUNCTION(this << shmName);
+    m_enabled = true;
+    if (shmName.empty() || !m_shmName.empty())
+    {
+        return;
+    }
+    int fd = shm_open(shmName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    NS_ABORT_MSG_IF(fd < 0, "Cannot create " << shmName << ": " << std::strerror(errno));
+    NS_ABORT_MSG_IF(ftruncate(fd, sizeof(Ns3AiStepProfile)) != 0,
+                    "Cannot size " << shmName << ": " << std::strerror(errno));
+    void* map = mmap(nullptr, sizeof(Ns3AiStepProfile), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    NS_ABORT_MSG_IF(map == MAP_FAILED, "Cannot map " << shmName << ": " << std::strerror(errno));
+    // the metrics registered so far move to the shared page
+    std::memcpy(map, m_profile, sizeof(Ns3AiStepProfile));
+    munmap(m_profile, sizeof(Ns3AiStepProfile));
+    m_profile = static_cast<Ns3AiStepProfile*>(map);
+    m_shmName = shmName;
+}
+
+uint32_t
+Ns3AiStepProfiler::AddMetric(const std::string& name, Unit unit)
+{
+    NS_ABORT_MSG_IF(m_profile->numMetrics >= MAX_METRICS,
+                    "A profile holds at most " << MAX_METRICS << " metrics");
+    uint32_t index = m_profile->numMetrics;
+    Ns3AiStepMetric& metric = m_profile->metrics[index];
+    std::strncpy(metric.name, name.c_str(), sizeof(metric.name) - 1);
+    metric.unit = unit;
+    m_profile->numMetrics++;
+    return index;
+}
+
+void
+Ns3AiStepProfiler::EndStep()
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+    __atomic_store_n(&m_profile->sequence, m_profile->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (uint32_t i = 0; i < m_profile->numMetrics; ++i)
+    {
+        if (!(m_recorded & (1U << i)))
+        {
+            continue;
+        }
+        Ns3AiStepMetric& metric = m_profile->metrics[i];
+        uint64_t value = m_step[i];
+        metric.count++;
+        metric.sum += value;
+        metric.max = std::max(metric.max, value);
+        metric.last = value;
+        metric.buckets[GetBucket(value)]++;
+        m_step[i] = 0;
+    }
+    m_profile->numSteps++;
+    m_recorded = 0;
+    __atomic_store_n(&m_profile->sequence, m_profile->sequence + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t
+Ns3AiStepProfiler::GetBucket(uint64_t value)
+{
+    if (value < 4)
+    {
+        return value;
+    }
+    uint32_t octave = 63 - __builtin_clzll(value);
+    uint32_t bucket = 4 * (octave - 1) + ((value >> (octave - 2)) & 3);
+    return std::min(bucket, NUM_BUCKETS - 1);
+}
+
+uint64_t
+Ns3AiStepProfiler::GetBucketLowerBound(uint32_t bucket)
+{
+    if (bucket < 4)
+    {
+        return bucket;
+    }
+    return static_cast<uint64_t>(4 + bucket % 4) << (bucket / 4 - 1);
+}
+
+uint64_t
+Ns3AiStepProfiler::GetQuantile(uint32_t metric, double q) const
+{
+    const Ns3AiStepMetric& m = m_profile->metrics[metric];
+    if (m.count == 0)
+    {
+        return 0;
+    }
+    auto rank = std::max<uint64_t>(1, std::ceil(q * m.count));
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+    {
+        seen += m.buckets[bucket];
+        if (seen >= rank)
+        {
+            // middle of the bucket
+            uint64_t low = GetBucketLowerBound(bucket);
+            uint64_t high = (bucket + 1 < NUM_BUCKETS ? GetBucketLowerBound(bucket + 1) : m.max);
+            return std::min(low + (high - low) / 2, m.max);
+        }
+    }
+    return m.max;
+}
+
+void
+Ns3AiStepProfiler::Print(std::ostream& os) const
+{
+    os << "Step profile, " << m_profile->numSteps << " steps (times in ms)\n";
+    os << std::left << std::setw(16) << "metric" << std::right << std::setw(8) << "steps"
+       << std::setw(12) << "mean" << std::setw(12) << "p50" << std::setw(12) << "p90"
+       << std::setw(12) << "p99" << std::setw(12) << "max" << std::setw(14) << "total" << "\n";
+    auto flags = os.flags();
+    auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    for (uint32_t i = 0; i < m_profile->numMetrics; ++i)
+    {
+        const Ns3AiStepMetric& metric = m_profile->metrics[i];
+        double mean = metric.count ? static_cast<double>(metric.sum) / metric.count : 0;
+        os << std::left << std::setw(16) << metric.name << std::right << std::setw(8)
+           << metric.count << std::setw(12) << Scaled(metric, mean) << std::setw(12)
+           << Scaled(metric, GetQuantile(i, 0.5)) << std::setw(12)
+           << Scaled(metric, GetQuantile(i, 0.9)) << std::setw(12)
+           << Scaled(metric, GetQuantile(i, 0.99)) << std::setw(12)
+           << Scaled(metric, metric.max) << std::setw(14) << Scaled(metric, metric.sum) << "\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace ns3
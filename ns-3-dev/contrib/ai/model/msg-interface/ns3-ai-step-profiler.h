@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NS3_AI_STEP_PROFILER_H
+#define NS3_AI_STEP_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \brief Counters and histogram of a metric of the steps, e.g. the time spent in a
+ * phase of each step
+ */
+struct Ns3AiStepMetric
+{
+    char name[32];          //!< name of the metric, null-terminated
+    uint32_t unit;          //!< Ns3AiStepProfiler::Unit
+    uint32_t reserved;      //!< padding, zero
+    uint64_t count;         //!< steps where the metric was recorded
+    uint64_t sum;           //!< sum of the values of these steps
+    uint64_t max;           //!< largest value of a step
+    uint64_t last;          //!< value of the last step where it was recorded
+    uint64_t buckets[192];  //!< steps per value bucket, see Ns3AiStepProfiler::GetBucket
+};
+
+/**
+ * \brief Profile of the steps of a run, in the layout of the shared memory page
+ * read by ns3ai_step_profile.py.
+ *
+ * sequence is odd while the profile is updated: a reader copies the profile, and
+ * retries if sequence was odd or changed meanwhile.
+ */
+struct Ns3AiStepProfile
+{
+    char magic[8];                  //!< "NS3AIPRF"
+    uint32_t version;               //!< layout version
+    uint32_t numMetrics;            //!< metrics in use
+    uint64_t sequence;              //!< update counter
+    uint64_t numSteps;              //!< steps ended
+    Ns3AiStepMetric metrics[16];    //!< the metrics
+};
+
+/**
+ * \brief Wall-clock and counter profile of the steps of an RL loop.
+ *
+ * A loop registers its metrics, adds to them during a step, e.g. the time spent
+ * in each of its phases or the events simulated, and ends the step: the total of
+ * each metric in the step goes to its log-linear histogram. Metrics not added to
+ * in a step are not recorded for that step. The profile can be printed at the end
+ * of the run, and be put in a shared memory page that Python reads while the run
+ * goes on. The profile is always in shared memory, so that the processes forked
+ * during the run, which run one after the other, add to the same profile.
+ *
+ * A disabled profiler does nothing, and does not read the clock.
+ */
+class Ns3AiStepProfiler
+{
+  public:
+    /**
+     * Unit of the values of a metric
+     */
+    enum Unit : uint32_t
+    {
+        NANOSECONDS = 0,
+        COUNT = 1,
+    };
+
+    static constexpr uint32_t MAX_METRICS = 16;   //!< metrics of a profile
+    static constexpr uint32_t NUM_BUCKETS = 192;  //!< buckets of a histogram
+
+    Ns3AiStepProfiler();
+    ~Ns3AiStepProfiler();
+
+    Ns3AiStepProfiler(const Ns3AiStepProfiler&) = delete;
+    Ns3AiStepProfiler& operator=(const Ns3AiStepProfiler&) = delete;
+
+    /**
+     * Start recording
+     * \param shmName name of a POSIX shared memory object to put the profile in, such
+     *        as "/apb-profile" (empty: none). It is removed when the profiler is.
+     */
+    void Enable(const std::string& shmName = "");
+
+    /**
+     * Whether the profiler records
+     */
+    bool IsEnabled() const
+    {
+        return m_enabled;
+    }
+
+    /**
+     * Register a metric
+     * \param name the name of the metric
+     * \param unit the unit of its values
+     * \return the index of the metric
+     */
+    uint32_t AddMetric(const std::string& name, Unit unit);
+
+    /**
+     * Get the monotonic clock, in nanoseconds, 0 if the profiler is disabled
+     */
+    uint64_t Now() const
+    {
+        if (!m_enabled)
+        {
+            return 0;
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /**
+     * Add to a metric of the current step
+     */
+    void Add(uint32_t metric, uint64_t value)
+    {
+        if (!m_enabled)
+        {
+            return;
+        }
+        m_step[metric] += value;
+        m_recorded |= (1U << metric);
+    }
+
+    /**
+     * Add the time elapsed since start, given by Now(), to a metric of the current step
+     */
+    void AddTimeSince(uint32_t metric, uint64_t start)
+    {
+        if (m_enabled)
+        {
+            Add(metric, Now() - start);
+        }
+    }
+
+    /**
+     * End the current step: record the metrics added to in it
+     */
+    void EndStep();
+
+    /**
+     * Get the profile
+     */
+    const Ns3AiStepProfile& GetProfile() const
+    {
+        return *m_profile;
+    }
+
+    /**
+     * Get a quantile of the values of a metric, from its histogram (within 12.5%)
+     * \param metric the index of the metric
+     * \param q the quantile, in [0, 1]
+     * \return the quantile, 0 if the metric has no value
+     */
+    uint64_t GetQuantile(uint32_t metric, double q) const;
+
+    /**
+     * Print a table of the metrics: steps, mean, p50, p90, p99, max and total
+     */
+    void Print(std::ostream& os) const;
+
+    /**
+     * Get the bucket of a value: values below 4 have their own bucket, and each
+     * octave above is split into 4 buckets
+     */
+    static uint32_t GetBucket(uint64_t value);
+
+    /**
+     * Get the smallest value of a bucket
+     */
+    static uint64_t GetBucketLowerBound(uint32_t bucket);
+
+  private:
+    bool m_enabled;                                //!< whether the profiler records
+    Ns3AiStepProfile* m_profile;                   //!< the profile
+    std::string m_shmName;                         //!< shared memory object of the profile
+    std::array<uint64_t, MAX_METRICS> m_step;      //!< metrics of the current step
+    uint32_t m_recorded;                           //!< metrics added to in the current step
+};
+
+} // namespace ns3
+
+#endif // NS3_AI_STEP_PROFILER_H
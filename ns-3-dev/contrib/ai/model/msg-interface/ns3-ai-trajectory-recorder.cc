@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3-ai-trajectory-recorder.h"
+
+#include <ns3/abort.h>
+#include <ns3/log.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ns3AiTrajectoryRecorder");
+
+namespace
+{
+
+const uint32_t TRAJECTORY_VERSION = 1;
+const uint32_t RECORD_OBS_OFFSET = 24; //!< after episode, step, reward and done
+const std::size_t GROW_BYTES = 1 << 20; //!< the file grows by at least this much
+
+static_assert(sizeof(Ns3AiTrajectoryHeader) == 4096, "The header must fill one page");
+
+uint32_t
+Align8(uint32_t size)
+{
+    return (size + 7) & ~7U;
+}
+
+} // namespace
+
+Ns3AiTrajectoryRecorder::Ns3AiTrajectoryRecorder()
+    : m_fd(-1),
+      m_map(nullptr),
+      m_mapSize(0),
+      m_pageSize(sysconf(_SC_PAGESIZE)),
+      m_recordSize(0),
+      m_obsOffset(0),
+      m_obsSize(0),
+      m_actOffset(0),
+      m_actSize(0),
+      m_batchRecords(0),
+      m_numRecords(0),
+      m_numWritten(0),
+      m_nextEpisode(0),
+      m_stop(false)
+{
+}
+
+Ns3AiTrajectoryRecorder::~Ns3AiTrajectoryRecorder()
+{
+    Close();
+}
+
+void
+Ns3AiTrajectoryRecorder::Open(const std::string& path,
+                              uint32_t obsSize,
+                              uint32_t actSize,
+                              const std::string& obsDescr,
+                              const std::string& actDescr,
+                              bool append,
+                              uint32_t batchPages)
+{
+    NS_LOG_FUNCTION(this << path << obsSize << actSize << append << batchPages);
+    NS_ABORT_MSG_IF(IsOpen(), "Trajectory file already open");
+    NS_ABORT_MSG_IF(batchPages == 0, "A batch must hold at least one page");
+
+    Ns3AiTrajectoryHeader header;
+    NS_ABORT_MSG_IF(obsDescr.size() >= sizeof(header.obsDescr) ||
+                        actDescr.size() >= sizeof(header.actDescr),
+                    "Observation or action description too long");
+
+    m_obsOffset = RECORD_OBS_OFFSET;
+    m_obsSize = obsSize;
+    m_actOffset = m_obsOffset + Align8(obsSize);
+    m_actSize = actSize;
+    m_recordSize = m_actOffset + Align8(actSize);
+    // enough records to fill the batch pages
+    std::size_t batchBytes = static_cast<std::size_t>(batchPages) * m_pageSize;
+    m_batchRecords = (batchBytes + m_recordSize - 1) / m_recordSize;
+    m_numRecords = 0;
+    m_numWritten = 0;
+    m_nextEpisode = 0;
+
+    m_fd = open(path.c_str(), O_RDWR | O_CREAT | (append ? 0 : O_TRUNC), 0644);
+    NS_ABORT_MSG_IF(m_fd < 0, "Cannot open " << path << ": " << std::strerror(errno));
+
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "NS3AITRJ", sizeof(header.magic));
+    header.version = TRAJECTORY_VERSION;
+    header.headerSize = sizeof(Ns3AiTrajectoryHeader);
+    header.recordSize = m_recordSize;
+    header.obsOffset = m_obsOffset;
+    header.obsSize = m_obsSize;
+    header.actOffset = m_actOffset;
+    header.actSize = m_actSize;
+    header.numRecords = 0;
+    std::strncpy(header.obsDescr, obsDescr.c_str(), sizeof(header.obsDescr) - 1);
+    std::strncpy(header.actDescr, actDescr.c_str(), sizeof(header.actDescr) - 1);
+
+    struct stat st;
+    NS_ABORT_MSG_IF(fstat(m_fd, &st) != 0, "Cannot stat " << path << ": " << std::strerror(errno));
+    if (st.st_size > 0)
+    {
+        Ns3AiTrajectoryHeader existing;
+        NS_ABORT_MSG_IF(pread(m_fd, &existing, sizeof(existing), 0) !=
+                                static_cast<ssize_t>(sizeof(existing)) ||
+                            std::memcmp(existing.magic, header.magic, sizeof(header.magic)) != 0 ||
+                            existing.version != header.version ||
+                            existing.recordSize != header.recordSize ||
+                            existing.obsSize != header.obsSize ||
+                            existing.actSize != header.actSize,
+                        "Cannot append to " << path << ": not a trajectory file with this layout");
+        m_numWritten = existing.numRecords;
+        header.numRecords = existing.numRecords;
+        if (m_numWritten > 0)
+        {
+            uint32_t lastEpisode;
+            NS_ABORT_MSG_IF(pread(m_fd,
+                                  &lastEpisode,
+                                  sizeof(lastEpisode),
+                                  sizeof(Ns3AiTrajectoryHeader) +
+                                      (m_numWritten - 1) * m_recordSize) !=
+                                static_cast<ssize_t>(sizeof(lastEpisode)),
+                            "Cannot read the last record of " << path);
+            m_nextEpisode = lastEpisode + 1;
+        }
+        NS_LOG_DEBUG("Appending to " << path << " after " << m_numWritten << " records");
+    }
+    Remap(sizeof(Ns3AiTrajectoryHeader) + m_numWritten * m_recordSize + GROW_BYTES);
+    std::memcpy(m_map, &header, sizeof(header));
+
+    m_staging.clear();
+    m_staging.reserve(m_batchRecords * m_recordSize);
+    m_stop = false;
+    m_writer = std::thread(&Ns3AiTrajectoryRecorder::WriteLoop, this);
+}
+
+void
+Ns3AiTrajectoryRecorder::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!IsOpen())
+    {
+        return;
+    }
+    SubmitBatch();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_writer.join();
+
+    // drop the space reserved ahead
+    std::size_t used = sizeof(Ns3AiTrajectoryHeader) + m_numWritten * m_recordSize;
+    msync(m_map, used, MS_SYNC);
+    munmap(m_map, m_mapSize);
+    m_map = nullptr;
+    m_mapSize = 0;
+    if (ftruncate(m_fd, used) != 0)
+    {
+        NS_LOG_WARN("Cannot trim the trajectory file: " << std::strerror(errno));
+    }
+    close(m_fd);
+    m_fd = -1;
+    m_queue.clear();
+    m_free.clear();
+    NS_LOG_DEBUG("Trajectory file closed with " << m_numWritten << " records");
+}
+
+bool
+Ns3AiTrajectoryRecorder::IsOpen() const
+{
+    return m_fd >= 0;
+}
+
+void
+Ns3AiTrajectoryRecorder::Record(uint32_t episode,
+                                uint32_t step,
+                                const void* obs,
+                                const void* act,
+                                double reward,
+                                bool done)
+{
+    NS_ABORT_MSG_IF(!IsOpen(), "Trajectory file not open");
+    std::size_t start = m_staging.size();
+    m_staging.resize(start + m_recordSize, 0);
+    char* record = m_staging.data() + start;
+    uint8_t doneByte = done;
+    std::memcpy(record, &episode, sizeof(episode));
+    std::memcpy(record + 4, &step, sizeof(step));
+    std::memcpy(record + 8, &reward, sizeof(reward));
+    std::memcpy(record + 16, &doneByte, sizeof(doneByte));
+    if (obs)
+    {
+        std::memcpy(record + m_obsOffset, obs, m_obsSize);
+    }
+    if (act)
+    {
+        std::memcpy(record + m_actOffset, act, m_actSize);
+    }
+    ++m_numRecords;
+    if (m_staging.size() >= m_batchRecords * m_recordSize)
+    {
+        SubmitBatch();
+    }
+}
+
+uint64_t
+Ns3AiTrajectoryRecorder::GetNumRecords() const
+{
+    return m_numRecords;
+}
+
+uint32_t
+Ns3AiTrajectoryRecorder::GetNextEpisode() const
+{
+    return m_nextEpisode;
+}
+
+void
+Ns3AiTrajectoryRecorder::SubmitBatch()
+{
+    if (m_staging.empty())
+    {
+        return;
+    }
+    std::vector<char> next;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(m_staging));
+        if (!m_free.empty())
+        {
+            next = std::move(m_free.back());
+            m_free.pop_back();
+        }
+    }
+    m_cv.notify_one();
+    next.clear();
+    next.reserve(m_batchRecords * m_recordSize);
+    m_staging = std::move(next);
+}
+
+void
+Ns3AiTrajectoryRecorder::WriteLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            // stop requested and nothing left to write
+            return;
+        }
+        std::vector<char> batch = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        WriteBatch(batch);
+        lock.lock();
+        m_free.push_back(std::move(batch));
+    }
+}
+
+void
+Ns3AiTrajectoryRecorder::WriteBatch(const std::vector<char>& batch)
+{
+    std::size_t offset = sizeof(Ns3AiTrajectoryHeader) + m_numWritten * m_recordSize;
+    if (offset + batch.size() > m_mapSize)
+    {
+        Remap(std::max(m_mapSize * 2, offset + batch.size() + GROW_BYTES));
+    }
+    std::memcpy(m_map + offset, batch.data(), batch.size());
+    m_numWritten += batch.size() / m_recordSize;
+
+    // readers must not see the new count before the records
+    auto header = reinterpret_cast<Ns3AiTrajectoryHeader*>(m_map);
+    __atomic_store_n(&header->numRecords, m_numWritten, __ATOMIC_RELEASE);
+}
+
+void
+Ns3AiTrajectoryRecorder::Remap(std::size_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    // keep the file a whole number of pages
+    size = (size + m_pageSize - 1) / m_pageSize * m_pageSize;
+    NS_ABORT_MSG_IF(ftruncate(m_fd, size) != 0,
+                    "Cannot grow the trajectory file: " << std::strerror(errno));
+    if (m_map)
+    {
+        munmap(m_map, m_mapSize);
+    }
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    NS_ABORT_MSG_IF(map == MAP_FAILED, "Cannot map the trajectory file: " << std::strerror(errno));
+    m_map = static_cast<char*>(map);
+    m_mapSize = size;
+}
+
+} // namespace ns3
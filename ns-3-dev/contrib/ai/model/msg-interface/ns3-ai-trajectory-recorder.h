@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NS3_AI_TRAJECTORY_RECORDER_H
+#define NS3_AI_TRAJECTORY_RECORDER_H
+
+#include <ns3/simple-ref-count.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Header at the start of a trajectory file (one page).
+ *
+ * Records follow the header back to back, each recordSize bytes long:
+ * episode (uint32), step (uint32), reward (double), done (uint8), then the
+ * observation at obsOffset and the action at actOffset. numRecords only
+ * counts records that are completely written, so the file can be read while
+ * it grows. obsDescr and actDescr describe the observation and action for
+ * NumPy: either a dtype string such as "(4,)<f4", or a list of
+ * "name:dtype:offset" fields separated by ';'.
+ */
+struct Ns3AiTrajectoryHeader
+{
+    char magic[8];         //!< "NS3AITRJ"
+    uint32_t version;      //!< file format version
+    uint32_t headerSize;   //!< offset of the first record
+    uint32_t recordSize;   //!< size of one record, including padding
+    uint32_t obsOffset;    //!< offset of the observation in a record
+    uint32_t obsSize;      //!< size of the observation
+    uint32_t actOffset;    //!< offset of the action in a record
+    uint32_t actSize;      //!< size of the action
+    uint32_t reserved;     //!< padding, zero
+    uint64_t numRecords;   //!< number of complete records in the file
+    char obsDescr[2024];   //!< NumPy description of the observation
+    char actDescr[2024];   //!< NumPy description of the action
+};
+
+/**
+ * \brief Append-only recorder of (observation, action, reward, done) records.
+ *
+ * The records go to a memory-mapped file that NumPy reads directly (see
+ * ns3ai_trajectory.py), e.g. as a replay buffer for offline RL. Record() only
+ * copies the record into a staging batch of at least one page; full batches
+ * are handed to a writer thread, which grows the mapping, copies them in and
+ * then publishes the new record count in the header.
+ */
+class Ns3AiTrajectoryRecorder : public SimpleRefCount<Ns3AiTrajectoryRecorder>
+{
+  public:
+    Ns3AiTrajectoryRecorder();
+    ~Ns3AiTrajectoryRecorder();
+
+    /**
+     * Create the file and start the writer thread
+     * \param path the trajectory file
+     * \param obsSize size of an observation in bytes
+     * \param actSize size of an action in bytes
+     * \param obsDescr NumPy description of an observation (empty: raw bytes)
+     * \param actDescr NumPy description of an action (empty: raw bytes)
+     * \param append keep the records of an existing file with the same layout,
+     *        instead of truncating it
+     * \param batchPages number of pages written at once
+     */
+    void Open(const std::string& path,
+              uint32_t obsSize,
+              uint32_t actSize,
+              const std::string& obsDescr = "",
+              const std::string& actDescr = "",
+              bool append = false,
+              uint32_t batchPages = 1);
+
+    /**
+     * Write the pending records, stop the writer thread and trim the file
+     */
+    void Close();
+
+    /**
+     * Whether the file is open
+     */
+    bool IsOpen() const;
+
+    /**
+     * Append a record. obs and act are copied, and may be null to record zeros.
+     */
+    void Record(uint32_t episode,
+                uint32_t step,
+                const void* obs,
+                const void* act,
+                double reward,
+                bool done);
+
+    /**
+     * Append a record of trivially copyable structs, e.g. the structs of the
+     * message interface
+     */
+    template <typename Obs, typename Act>
+    void Record(uint32_t episode,
+                uint32_t step,
+                const Obs& obs,
+                const Act& act,
+                double reward,
+                bool done)
+    {
+        static_assert(std::is_trivially_copyable_v<Obs> && std::is_trivially_copyable_v<Act>,
+                      "Only trivially copyable types can be recorded");
+        Record(episode,
+               step,
+               static_cast<const void*>(&obs),
+               static_cast<const void*>(&act),
+               reward,
+               done);
+    }
+
+    /**
+     * Get the number of records passed to Record since Open
+     */
+    uint64_t GetNumRecords() const;
+
+    /**
+     * Get the episode following the last one found in the file when it was
+     * opened for appending (0 for a new file)
+     */
+    uint32_t GetNextEpisode() const;
+
+    /**
+     * Get the NumPy dtype string of an arithmetic type, e.g. "<f8" for double
+     */
+    template <typename T>
+    static std::string NumpyFormat()
+    {
+        static_assert(std::is_arithmetic_v<T>, "Only arithmetic types have a NumPy format");
+        std::string kind = std::is_same_v<T, bool>        ? "b"
+                           : std::is_floating_point_v<T> ? "f"
+                           : std::is_signed_v<T>         ? "i"
+                                                         : "u";
+        return (sizeof(T) == 1 ? "|" : "<") + kind + std::to_string(sizeof(T));
+    }
+
+    /**
+     * Get the description of one struct field, to be concatenated into obsDescr
+     * or actDescr. See NS3AI_TRAJECTORY_FIELD.
+     */
+    template <typename T>
+    static std::string Field(const std::string& name, std::size_t offset)
+    {
+        return name + ":" + NumpyFormat<T>() + ":" + std::to_string(offset) + ";";
+    }
+
+  private:
+    /**
+     * Queue the staging batch for the writer thread
+     */
+    void SubmitBatch();
+
+    /**
+     * Body of the writer thread
+     */
+    void WriteLoop();
+
+    /**
+     * Copy a batch to the file, growing the mapping if needed
+     */
+    void WriteBatch(const std::vector<char>& batch);
+
+    /**
+     * Map the file with a new size
+     */
+    void Remap(std::size_t size);
+
+    int m_fd;                     //!< file descriptor
+    char* m_map;                  //!< mapping of the whole file
+    std::size_t m_mapSize;        //!< size of the file and of the mapping
+    std::size_t m_pageSize;       //!< system page size
+    uint32_t m_recordSize;        //!< size of a record
+    uint32_t m_obsOffset;         //!< offset of the observation in a record
+    uint32_t m_obsSize;           //!< size of an observation
+    uint32_t m_actOffset;         //!< offset of the action in a record
+    uint32_t m_actSize;           //!< size of an action
+    std::size_t m_batchRecords;   //!< records in a full batch
+    uint64_t m_numRecords;        //!< records passed to Record
+    uint64_t m_numWritten;        //!< records copied to the file (writer thread)
+    uint32_t m_nextEpisode;       //!< first free episode number when opened
+    std::vector<char> m_staging;  //!< batch being filled
+
+    std::thread m_writer;                   //!< writer thread
+    std::mutex m_mutex;                     //!< protects the queues and m_stop
+    std::condition_variable m_cv;           //!< wakes up the writer thread
+    std::deque<std::vector<char>> m_queue;  //!< batches waiting to be written
+    std::vector<std::vector<char>> m_free;  //!< written batches, reused for staging
+    bool m_stop;                            //!< the writer thread must exit
+};
+
+} // namespace ns3
+
+/**
+ * Describe a member of a struct for Ns3AiTrajectoryRecorder::Open, e.g.
+ * NS3AI_TRAJECTORY_FIELD(EnvStruct, env_a)
+ */
+#define NS3AI_TRAJECTORY_FIELD(type, member)                                                      \
+    ns3::Ns3AiTrajectoryRecorder::Field<decltype(type::member)>(#member, offsetof(type, member))
+
+#endif // NS3_AI_TRAJECTORY_RECORDER_H
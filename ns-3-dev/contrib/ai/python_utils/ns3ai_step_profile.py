@@ -0,0 +1,100 @@
+# Copyright (c) 2024
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+import mmap
+import struct
+
+import numpy as np
+
+# layout of Ns3AiStepProfile (ns3-ai-step-profiler.h)
+_HEADER_FORMAT = "<8sIIQQ"
+_HEADER_SIZE = struct.calcsize(_HEADER_FORMAT)
+_NUM_BUCKETS = 192
+_METRIC_FORMAT = "<32sII4Q{}Q".format(_NUM_BUCKETS)
+_METRIC_SIZE = struct.calcsize(_METRIC_FORMAT)
+_MAX_METRICS = 16
+_PROFILE_SIZE = _HEADER_SIZE + _MAX_METRICS * _METRIC_SIZE
+_SEQUENCE_OFFSET = 16
+_MAGIC = b"NS3AIPRF"
+_UNITS = {0: "ns", 1: "count"}
+
+
+def _bucket_bounds():
+    """smallest value of each bucket, see Ns3AiStepProfiler::GetBucketLowerBound"""
+    bounds = []
+    for bucket in range(_NUM_BUCKETS + 1):
+        if bucket < 4:
+            bounds.append(bucket)
+        else:
+            bounds.append((4 + bucket % 4) << (bucket // 4 - 1))
+    return np.array(bounds, dtype=np.float64)
+
+
+_BOUNDS = _bucket_bounds()
+
+
+def _quantile(buckets, count, maximum, q):
+    if count == 0:
+        return 0.0
+    rank = max(1, int(np.ceil(q * count)))
+    bucket = int(np.searchsorted(np.cumsum(buckets), rank))
+    middle = (_BOUNDS[bucket] + _BOUNDS[bucket + 1]) / 2
+    return float(min(middle, maximum))
+
+
+def _snapshot(page):
+    """consistent copy of the profile, retried while the profiler updates it"""
+    while True:
+        before = struct.unpack_from("<Q", page, _SEQUENCE_OFFSET)[0]
+        if before % 2:
+            continue
+        raw = bytes(page[:_PROFILE_SIZE])
+        if struct.unpack_from("<Q", page, _SEQUENCE_OFFSET)[0] == before:
+            return raw
+
+
+# Read the step profile that a run publishes in shared memory (Ns3AiStepProfiler,
+# e.g. apb --profileShm=/apb-profile). It can be read while the run goes on.
+# \param[in] name : name of the shared memory object, as given to the run
+# \return {"numSteps": n, "metrics": {name: {"unit", "count", "sum", "mean", "max",
+#         "last", "p50", "p90", "p99", "buckets"}}}; the times are in nanoseconds
+def read_step_profile(name):
+    with open("/dev/shm/" + name.lstrip("/"), "rb") as f:
+        with mmap.mmap(f.fileno(), _PROFILE_SIZE, access=mmap.ACCESS_READ) as page:
+            raw = _snapshot(page)
+    magic, version, numMetrics, _, numSteps = struct.unpack_from(_HEADER_FORMAT, raw)
+    if magic != _MAGIC:
+        raise ValueError("ns3ai_step_profile: {} is not a step profile".format(name))
+    metrics = {}
+    for i in range(numMetrics):
+        fields = struct.unpack_from(_METRIC_FORMAT, raw, _HEADER_SIZE + i * _METRIC_SIZE)
+        metricName, unit, _, count, total, maximum, last = fields[:7]
+        buckets = np.array(fields[7:], dtype=np.uint64)
+        metrics[metricName.split(b"\0", 1)[0].decode()] = {
+            "unit": _UNITS.get(unit, str(unit)),
+            "count": count,
+            "sum": total,
+            "mean": total / count if count else 0.0,
+            "max": maximum,
+            "last": last,
+            "p50": _quantile(buckets, count, maximum, 0.5),
+            "p90": _quantile(buckets, count, maximum, 0.9),
+            "p99": _quantile(buckets, count, maximum, 0.99),
+            "buckets": buckets,
+        }
+    return {"version": version, "numSteps": numSteps, "metrics": metrics}
+
+
+__all__ = ["read_step_profile"]
@@ -0,0 +1,113 @@
+# Copyright (c) 2024
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+import struct
+
+import numpy as np
+
+# layout of Ns3AiTrajectoryHeader (ns3-ai-trajectory-recorder.h)
+_HEADER_FORMAT = "<8s8IQ2024s2024s"
+_HEADER_SIZE = struct.calcsize(_HEADER_FORMAT)
+_MAGIC = b"NS3AITRJ"
+
+
+def _parse_descr(descr, size):
+    """dtype of an observation or action, given its description in the header"""
+    if not descr:
+        return np.dtype((np.void, size))
+    if ":" not in descr:
+        return np.dtype(descr)
+    names, formats, offsets = [], [], []
+    for field in descr.split(";"):
+        if field:
+            name, fmt, offset = field.split(":")
+            names.append(name)
+            formats.append(fmt)
+            offsets.append(int(offset))
+    return np.dtype({"names": names, "formats": formats, "offsets": offsets, "itemsize": size})
+
+
+def read_header(path):
+    with open(path, "rb") as f:
+        raw = f.read(_HEADER_SIZE)
+    if len(raw) < _HEADER_SIZE:
+        raise ValueError("ns3ai_trajectory: {} is too short".format(path))
+    (magic, version, headerSize, recordSize, obsOffset, obsSize, actOffset, actSize, _,
+     numRecords, obsDescr, actDescr) = struct.unpack(_HEADER_FORMAT, raw)
+    if magic != _MAGIC:
+        raise ValueError("ns3ai_trajectory: {} is not a trajectory file".format(path))
+    return {
+        "version": version,
+        "headerSize": headerSize,
+        "recordSize": recordSize,
+        "obsOffset": obsOffset,
+        "obsSize": obsSize,
+        "actOffset": actOffset,
+        "actSize": actSize,
+        "numRecords": numRecords,
+        "obsDescr": obsDescr.split(b"\0", 1)[0].decode(),
+        "actDescr": actDescr.split(b"\0", 1)[0].decode(),
+    }
+
+
+def record_dtype(header):
+    names = ["episode", "step", "reward", "done"]
+    formats = ["<u4", "<u4", "<f8", "?"]
+    offsets = [0, 4, 8, 16]
+    if header["obsSize"]:
+        names.append("obs")
+        formats.append(_parse_descr(header["obsDescr"], header["obsSize"]))
+        offsets.append(header["obsOffset"])
+    if header["actSize"]:
+        names.append("act")
+        formats.append(_parse_descr(header["actDescr"], header["actSize"]))
+        offsets.append(header["actOffset"])
+    return np.dtype({"names": names, "formats": formats, "offsets": offsets,
+                     "itemsize": header["recordSize"]})
+
+
+# Map the records of a trajectory file written by Ns3AiTrajectoryRecorder.
+# The result is a structured array with fields episode, step, reward, done,
+# obs and act; nothing is read until accessed. Only the records written when
+# the function is called are mapped, so a file being recorded can be loaded
+# again later to see the new records.
+# \param[in] path : trajectory file
+# \param[in] mode : np.memmap mode, 'r' (default) or 'c' (copy-on-write)
+def load_trajectory(path, mode="r"):
+    header = read_header(path)
+    if header["numRecords"] == 0:
+        return np.zeros((0,), dtype=record_dtype(header))
+    return np.memmap(path, dtype=record_dtype(header), mode=mode,
+                     offset=header["headerSize"], shape=(header["numRecords"],))
+
+
+# Turn records into (obs, act, reward, next_obs, done) arrays for offline RL.
+# Each record holds an observation and the action taken on it, with the reward
+# reported along with the observation; the reward of a transition is then the
+# one of the next record. The last record of each episode only provides the
+# final observation.
+def to_transitions(records):
+    sameEpisode = records["episode"][1:] == records["episode"][:-1]
+    idx = np.nonzero(sameEpisode & ~records["done"][:-1])[0]
+    return {
+        "obs": records["obs"][idx],
+        "act": records["act"][idx],
+        "reward": records["reward"][idx + 1],
+        "next_obs": records["obs"][idx + 1],
+        "done": records["done"][idx + 1],
+    }
+
+
+__all__ = ["load_trajectory", "read_header", "record_dtype", "to_transitions"]
@@ -34,17 +34,23 @@ def get_setting(setting_map):
     return ret
 
 
-def run_single_ns3(path, pname, setting=None, env=None, show_output=False):
-    if env is None:
-        env = {}
-    env.update(os.environ)
+# build the ns3 script once, e.g. before several processes run it with build=False
+def build_ns3(path, pname):
+    subprocess.run([os.path.join(path, 'ns3'), 'build', pname], cwd=path, check=True)
+
+
+def run_single_ns3(path, pname, setting=None, env=None, show_output=False, build=True):
+    # the variables given by the caller take precedence over the inherited ones
+    env = {**os.environ, **(env or {})}
     env['LD_LIBRARY_PATH'] = os.path.abspath(os.path.join(path, 'build', 'lib'))
     # import pdb; pdb.set_trace()
     exec_path = os.path.join(path, 'ns3')
+    # without build, concurrent runs do not race on the build directory
+    run = '{} run'.format(exec_path) if build else '{} run --no-build'.format(exec_path)
     if not setting:
-        cmd = '{} run {}'.format(exec_path, pname)
+        cmd = '{} {}'.format(run, pname)
     else:
-        cmd = '{} run {} --{}'.format(exec_path, pname, get_setting(setting))
+        cmd = '{} {} --{}'.format(run, pname, get_setting(setting))
     if show_output:
         proc = subprocess.Popen(cmd, shell=True, text=True, env=env,
                                 stdin=subprocess.PIPE,
@@ -147,18 +153,34 @@ class Experiment:
     # run ns3 script in cmd with the setting being input
     # \param[in] setting : ns3 script input parameters(default : None)
     # \param[in] show_output : whether to show output or not(default : False)
-    def run(self, setting=None, show_output=False):
+    # \param[in] env : extra environment variables of the ns3 process(default : None)
+    def run(self, setting=None, show_output=False, env=None):
+        self.start(setting=setting, show_output=show_output, env=env)
+        self.check_started()
+        return self.msgInterface
+
+    # start the ns3 script like run(), without waiting to see if it keeps running;
+    # check_started() must be called afterwards. Several experiments can be started
+    # first and then checked after a single wait (see Ns3VectorEnv)
+    # \param[in] build : build the script before running it; False when it was
+    #                    built beforehand with build_ns3() (default : True)
+    def start(self, setting=None, show_output=False, env=None, build=True):
         self.kill()
         self.simCmd, self.proc = run_single_ns3(
-            './', self.targetName, setting=setting, show_output=show_output)
-       
-        # exit if an early error occurred, such as wrong target name
-        time.sleep(SIMULATION_EARLY_ENDING)
+            './', self.targetName, setting=setting, env=env, show_output=show_output,
+            build=build)
+        return self.msgInterface
+
+    # exit if an early error occurred, such as wrong target name
+    # \param[in] wait : wait SIMULATION_EARLY_ENDING first; False when the caller
+    #                   already waited after starting (default : True)
+    def check_started(self, wait=True):
+        if wait:
+            time.sleep(SIMULATION_EARLY_ENDING)
         if not self.isalive():
             print('ns3ai_utils: Subprocess died very early')
             exit(1)
         signal.signal(signal.SIGINT, sigint_handler)
-        return self.msgInterface
 
     def kill(self):
         if self.proc and self.isalive():
@@ -172,4 +194,4 @@ class Experiment:
     
 
 
-__all__ = ['Experiment']
+__all__ = ['Experiment', 'build_ns3']
@@ -26,11 +26,11 @@ setuptools.setup(name=name,
                  author="Pengyu Liu and Muyuan Shen",
                  author_email="muyuan_shen@hust.edu.cn",
                  packages=setuptools.find_packages(),
-                 install_requires=["psutil"],
+                 install_requires=["psutil", "numpy"],
                  classifiers=[
                      "Programming Language :: Python :: 3",
                      "License :: OSI Approved :: GNU General Public License v2 (GPLv2)",
                      "Operating System :: POSIX :: Linux",
                  ],
-                 py_modules=["ns3ai_utils"],
+                 py_modules=["ns3ai_utils", "ns3ai_trajectory", "ns3ai_step_profile"],
                  )
@@ -46,6 +46,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/spectrum-wifi-helper.h"
 //home/cola/EE595/ns-3-dev/src/propagation/model/propagation-loss-model.h
+#include "ns3/event-profiler-simulator-impl.h"
+#include "ns3/multi-run.h"
 #include "ns3/two-state-propagation-loss-model.h"
 #include "ns3/simple-wireless-channel.h"
 #include "ns3/simple-wireless-net-device.h"
@@ -105,7 +107,7 @@ ReceivePacket (Ptr<Socket> socket)
 }
 
 int
-main (int argc, char *argv[])
+RunSimulation (int argc, char *argv[])
 {
   DataRate dataRate = DataRate ("100Mbps");
   double distance = 25.0; // meters
@@ -115,6 +117,7 @@ main (int argc, char *argv[])
   double frequency = 5000000000; // Hz
   std::string lossModelType = "Friis";
   std::string metadata = "";
+  std::string eventProfile = "";
 
   g_numPacketsSent = 0;
   g_numPacketsReceived = 0;
@@ -130,7 +133,12 @@ main (int argc, char *argv[])
   cmd.AddValue("frequency","frequency in Hz",frequency);
   cmd.AddValue("lossModelType","loss model (Friis, LogDistance, or TwoState)",lossModelType);
   cmd.AddValue("metadata","metadata about experiment run",metadata);
+  cmd.AddValue("eventProfile","profile the events, written to <prefix>.txt and <prefix>.folded (empty: no profiling)",eventProfile);
   cmd.Parse (argc, argv);
+  if (!eventProfile.empty ())
+    {
+      EventProfilerSimulatorImpl::Enable (eventProfile);
+    }
 
   g_fileRssi.open ("link-performance-rssi.dat", std::ofstream::out);
   g_fileSummary.open ("link-performance-summary.dat", std::ofstream::app);
@@ -245,3 +253,10 @@ main (int argc, char *argv[])
   g_fileSummary.close ();
   return 0;
 }
+
+int
+main (int argc, char *argv[])
+{
+  // once, or once per line of --configs=<file>, see RunConfigurations
+  return RunConfigurations (argc, argv, RunSimulation);
+}
@@ -23,10 +23,12 @@
 #include "ns3/constant-rate-wifi-manager.h"
 #include "ns3/eht-configuration.h"
 #include "ns3/eht-phy.h"
+#include "ns3/event-profiler-simulator-impl.h"
 #include "ns3/frame-exchange-manager.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/log.h"
 #include "ns3/mobility-helper.h"
+#include "ns3/multi-run.h"
 #include "ns3/multi-model-spectrum-channel.h"
 #include "ns3/on-off-helper.h"
 #include "ns3/packet-sink.h"
@@ -34,8 +36,10 @@
 #include "ns3/packet-socket-helper.h"
 #include "ns3/packet-socket-server.h"
 #include "ns3/qos-utils.h"
+#include "ns3/results-store.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/spectrum-wifi-helper.h"
+#include "ns3/sta-wifi-mac.h"
 #include "ns3/uinteger.h"
 #include "ns3/wifi-mac-queue.h"
 #include "ns3/wifi-net-device.h"
@@ -47,7 +51,10 @@
 #include "ns3/yans-wifi-helper.h"
 
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <memory>
+#include <sys/resource.h>
 
 #define PI 3.1415926535
 
@@ -79,17 +86,18 @@ using TrafficConfigMap = std::map<uint32_t /* Node ID */, TrafficConfig>;
 
 Time slotTime;
 
-WifiPhyRxTraceHelper wifiStats;
+// RX stats of the current run
+std::unique_ptr<WifiPhyRxTraceHelper> wifiStats;
 
 void
 CheckStats()
 {
-    wifiStats.PrintStatistics();
+    wifiStats->PrintStatistics();
 
     std::ofstream outFile("tx-timeline.txt");
     outFile << "Start Time,End Time,Source Node,DropReason\n";
 
-    for (const auto& record : wifiStats.GetPpduRecords())
+    for (const auto& record : wifiStats->GetPpduRecords())
     {
         if (record.m_reason)
         {
@@ -202,10 +210,12 @@ GetBernoulliClient(const PacketSocketAddress& sockAddr,
 }
 
 int
-main(int argc, char* argv[])
+RunSimulation(int argc, char* argv[])
 {
     std::ofstream g_fileSummary;
-    g_fileSummary.open("wifi-mld.dat", std::ofstream::app);
+    std::string outputFile{"wifi-mld.dat"};
+    std::string resultsFile;
+    bool fastStart{false};
     bool printTxStats{false};
     bool printTxStatsSingleLine{true};
     bool printRxStats{false};
@@ -233,6 +243,7 @@ main(int argc, char* argv[])
     std::size_t nMldSta{5};
     double mldPerNodeLambda{0.00001};
     double mldProbLink1{0.5}; // prob_link1 + prob_link2 = 1
+    uint32_t numLinks{2};
     uint8_t mldAcLink1Int{AC_BE};
     uint8_t mldAcLink2Int{AC_BE};
     // EDCA configuration for CWmins, CWmaxs
@@ -264,6 +275,9 @@ main(int argc, char* argv[])
     cmd.AddValue("nMldSta", "Number of MLD STAs", nMldSta);
     cmd.AddValue("mldPerNodeLambda", "Per node arrival rate of MLD STAs", mldPerNodeLambda);
     cmd.AddValue("mldProbLink1", "MLD's splitting probability on link 1", mldProbLink1);
+    cmd.AddValue("numLinks",
+                 "Number of links of the MLDs, 1 or 2; with 1 link, mldProbLink1 is 1",
+                 numLinks);
     cmd.AddValue("mldAcLink1Int", "AC of MLD", mldAcLink1Int);
     cmd.AddValue("mldAcLink2Int", "AC of MLD", mldAcLink2Int);
     cmd.AddValue("acBECwminLink1", "Initial CW for AC_BE", acBECwminLink1);
@@ -282,7 +296,49 @@ main(int argc, char* argv[])
     cmd.AddValue("acVICwStageLink2", "Cutoff Stage for AC_VI", acVICwStageLink2);
     cmd.AddValue("acVOCwminLink2", "Initial CW for AC_VO", acVOCwminLink2);
     cmd.AddValue("acVOCwStageLink2", "Cutoff Stage for AC_VO", acVOCwStageLink2);
+    cmd.AddValue("fastStart",
+                 "Start all clients at 0 s, and the stats and simulationTime as soon as the "
+                 "last MLD STA is associated, instead of at 5 s",
+                 fastStart);
+    cmd.AddValue("outputFile",
+                 "File the summary line of the run is appended to",
+                 outputFile);
+    cmd.AddValue("resultsFile",
+                 "Results file the summary of the run is appended to, in binary columnar "
+                 "form (empty: not written)",
+                 resultsFile);
+    std::string eventProfile;
+    cmd.AddValue("eventProfile",
+                 "Profile the wall-clock time of the events by type and node, and write the "
+                 "report to <prefix>.txt and the folded stacks to <prefix>.folded "
+                 "(empty: no profiling)",
+                 eventProfile);
+    bool benchmark{false};
+    cmd.AddValue("benchmark",
+                 "Print the wall time, events and peak memory of the run, and add them to "
+                 "its results (see experiments/benchmark/mld_scaling.py)",
+                 benchmark);
     cmd.Parse(argc, argv);
+    const auto wallStart = std::chrono::steady_clock::now();
+    NS_ABORT_MSG_IF(numLinks < 1 || numLinks > 2, "The MLDs have 1 or 2 links");
+    // the peak RSS is the one of the process, i.e. of the largest run so far
+    NS_ABORT_MSG_IF(benchmark && GetNumConfigurations() > 1,
+                    "--benchmark needs one configuration per process, e.g. a batch size of 1");
+    if (numLinks == 1)
+    {
+        mldProbLink1 = 1;
+    }
+    if (!eventProfile.empty())
+    {
+        EventProfilerSimulatorImpl::Enable(eventProfile);
+    }
+    g_fileSummary.open(outputFile, std::ofstream::app);
+    // typed, columnar copy of the summary lines (see experiments/utils/results_store.py)
+    std::unique_ptr<ResultsStoreWriter> results;
+    if (!resultsFile.empty())
+    {
+        results = std::make_unique<ResultsStoreWriter>(resultsFile);
+    }
     uint8_t nLinks = 0;
 
     RngSeedManager::SetSeed(rngRun);
@@ -357,6 +413,10 @@ main(int argc, char* argv[])
     std::array<std::string, 2> mldChannelStr;
     for (auto freq : {frequency, frequency2})
     {
+        if (nLinks == numLinks)
+        {
+            break;
+        }
         std::string widthStr = (nLinks == 0)
                                    ? std::to_string(channelWidth)
                                    : std::to_string(channelWidth2);
@@ -470,7 +530,7 @@ main(int argc, char* argv[])
     // E.g. BE traffic with TIDs 0 and 3 are sents to Link 0 and 1, respectively.
     // Adding mapping information at MLD STAs side
     // NOTE: only consider UL data traffic for now
-    std::string mldMappingStr = "0,1,4,6 0; 3,2,5,7 1";
+    std::string mldMappingStr = (nLinks == 1) ? "0,1,2,3,4,5,6,7 0" : "0,1,4,6 0; 3,2,5,7 1";
     // To use greedy (ns-3 default way for traffic-to-link allocation):
     // (1) use the default string below
     // (2) need to also set mldProbLink1 to 0 or 1 to have only one L-MAC queue
@@ -503,38 +563,55 @@ main(int argc, char* argv[])
     // set cwmins and cwmaxs for all Access Categories on ALL devices
     // (incl. AP because STAs sync with AP via association, probe, and beacon)
     std::string prefixStr = "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/";
+    // the values of the links in use
+    auto perLink = [nLinks](auto values) {
+        values.resize(nLinks);
+        return values;
+    };
     std::list<uint64_t> acBeCwmins = {acBECwminLink1, acBECwminLink2};
-    Config::Set(prefixStr + "BE_Txop/MinCws", AttributeContainerValue<UintegerValue>(acBeCwmins));
+    Config::Set(prefixStr + "BE_Txop/MinCws",
+                AttributeContainerValue<UintegerValue>(perLink(acBeCwmins)));
     std::list<uint64_t> acBeCwmaxs = {acBECwmaxLink1, acBECwmaxLink2};
-    Config::Set(prefixStr + "BE_Txop/MaxCws", AttributeContainerValue<UintegerValue>(acBeCwmaxs));
+    Config::Set(prefixStr + "BE_Txop/MaxCws",
+                AttributeContainerValue<UintegerValue>(perLink(acBeCwmaxs)));
     std::list<uint64_t> acBkCwmins = {acBKCwminLink1, acBKCwminLink2};
-    Config::Set(prefixStr + "BK_Txop/MinCws", AttributeContainerValue<UintegerValue>(acBkCwmins));
+    Config::Set(prefixStr + "BK_Txop/MinCws",
+                AttributeContainerValue<UintegerValue>(perLink(acBkCwmins)));
     std::list<uint64_t> acBkCwmaxs = {acBKCwmaxLink1, acBKCwmaxLink2};
-    Config::Set(prefixStr + "BK_Txop/MaxCws", AttributeContainerValue<UintegerValue>(acBkCwmaxs));
+    Config::Set(prefixStr + "BK_Txop/MaxCws",
+                AttributeContainerValue<UintegerValue>(perLink(acBkCwmaxs)));
     std::list<uint64_t> acViCwmins = {acVICwminLink1, acVICwminLink2};
-    Config::Set(prefixStr + "VI_Txop/MinCws", AttributeContainerValue<UintegerValue>(acViCwmins));
+    Config::Set(prefixStr + "VI_Txop/MinCws",
+                AttributeContainerValue<UintegerValue>(perLink(acViCwmins)));
     std::list<uint64_t> acViCwmaxs = {acVICwmaxLink1, acVICwmaxLink2};
-    Config::Set(prefixStr + "VI_Txop/MaxCws", AttributeContainerValue<UintegerValue>(acViCwmaxs));
+    Config::Set(prefixStr + "VI_Txop/MaxCws",
+                AttributeContainerValue<UintegerValue>(perLink(acViCwmaxs)));
     std::list<uint64_t> acVoCwmins = {acVOCwminLink1, acVOCwminLink2};
-    Config::Set(prefixStr + "VO_Txop/MinCws", AttributeContainerValue<UintegerValue>(acVoCwmins));
+    Config::Set(prefixStr + "VO_Txop/MinCws",
+                AttributeContainerValue<UintegerValue>(perLink(acVoCwmins)));
     std::list<uint64_t> acVoCwmaxs = {acVOCwmaxLink1, acVOCwmaxLink2};
-    Config::Set(prefixStr + "VO_Txop/MaxCws", AttributeContainerValue<UintegerValue>(acVoCwmaxs));
+    Config::Set(prefixStr + "VO_Txop/MaxCws",
+                AttributeContainerValue<UintegerValue>(perLink(acVoCwmaxs)));
 
     // set all aifsn to be 2 (so that all aifs equal to legacy difs)
     std::list<uint64_t> aifsnList = {2, 2};
-    Config::Set(prefixStr + "BE_Txop/Aifsns", AttributeContainerValue<UintegerValue>(aifsnList));
-    Config::Set(prefixStr + "BK_Txop/Aifsns", AttributeContainerValue<UintegerValue>(aifsnList));
-    Config::Set(prefixStr + "VI_Txop/Aifsns", AttributeContainerValue<UintegerValue>(aifsnList));
-    Config::Set(prefixStr + "VO_Txop/Aifsns", AttributeContainerValue<UintegerValue>(aifsnList));
+    Config::Set(prefixStr + "BE_Txop/Aifsns",
+                AttributeContainerValue<UintegerValue>(perLink(aifsnList)));
+    Config::Set(prefixStr + "BK_Txop/Aifsns",
+                AttributeContainerValue<UintegerValue>(perLink(aifsnList)));
+    Config::Set(prefixStr + "VI_Txop/Aifsns",
+                AttributeContainerValue<UintegerValue>(perLink(aifsnList)));
+    Config::Set(prefixStr + "VO_Txop/Aifsns",
+                AttributeContainerValue<UintegerValue>(perLink(aifsnList)));
     std::list<Time> txopLimitList = {MicroSeconds(0), MicroSeconds(0)};
     Config::Set(prefixStr + "BE_Txop/TxopLimits",
-                AttributeContainerValue<TimeValue>(txopLimitList));
+                AttributeContainerValue<TimeValue>(perLink(txopLimitList)));
     Config::Set(prefixStr + "BK_Txop/TxopLimits",
-                AttributeContainerValue<TimeValue>(txopLimitList));
+                AttributeContainerValue<TimeValue>(perLink(txopLimitList)));
     Config::Set(prefixStr + "VI_Txop/TxopLimits",
-                AttributeContainerValue<TimeValue>(txopLimitList));
+                AttributeContainerValue<TimeValue>(perLink(txopLimitList)));
     Config::Set(prefixStr + "VO_Txop/TxopLimits",
-                AttributeContainerValue<TimeValue>(txopLimitList));
+                AttributeContainerValue<TimeValue>(perLink(txopLimitList)));
 
     auto staWifiManager =
         DynamicCast<ConstantRateWifiManager>(DynamicCast<WifiNetDevice>(mldDevCon.Get(0))
@@ -560,7 +637,8 @@ main(int argc, char* argv[])
     mobility.Install(allNodeCon);
 
     /* Setting applications */
-    // random start time
+    // random start time, or all clients start at 0 s in fast start mode (their packets are
+    // dropped until their STA is associated, a few ms later)
     Ptr<UniformRandomVariable> startTime = CreateObject<UniformRandomVariable>();
     startTime->SetAttribute("Stream", IntegerValue(randomStream));
     startTime->SetAttribute("Min", DoubleValue(0.0));
@@ -614,7 +692,8 @@ main(int argc, char* argv[])
                                                               payloadSize,
                                                               NanoSeconds(
                                                                   mapIt->second.m_determIntervalNs),
-                                                              Seconds(startTime->GetValue()),
+                                                              fastStart ? Seconds(0)
+                                                                        : Seconds(startTime->GetValue()),
                                                               mapIt->second.m_link1Ac,
                                                               mapIt->second.m_split,
                                                               mapIt->second.m_link2Ac,
@@ -629,7 +708,8 @@ main(int argc, char* argv[])
             clientNode->AddApplication(GetBernoulliClient(sockAddr,
                                                           payloadSize,
                                                           mapIt->second.m_lambda,
-                                                          Seconds(startTime->GetValue()),
+                                                          fastStart ? Seconds(0)
+                                                                    : Seconds(startTime->GetValue()),
                                                           mapIt->second.m_link1Ac,
                                                           mapIt->second.m_split,
                                                           mapIt->second.m_link2Ac,
@@ -646,16 +726,43 @@ main(int argc, char* argv[])
     // TX stats
     WifiTxStatsHelper wifiTxStats;
     wifiTxStats.Enable(allNetDevices);
-    wifiTxStats.Start(Seconds(5));
-    wifiTxStats.Stop(Seconds(5 + simulationTime));
-
     // RX stats
-    wifiStats.Enable(allNodeCon);
-    wifiStats.Start(Seconds(5));
-    wifiStats.Stop(Seconds(5 + simulationTime));
-    if (printRxStats)
+    wifiStats = std::make_unique<WifiPhyRxTraceHelper>();
+    wifiStats->Enable(allNodeCon);
+    // the stats run for simulationTime from statsStart
+    auto startStats = [&](Time statsStart) {
+        wifiTxStats.Start(statsStart);
+        wifiTxStats.Stop(statsStart + Seconds(simulationTime));
+        wifiStats->Start(statsStart);
+        wifiStats->Stop(statsStart + Seconds(simulationTime));
+        if (printRxStats)
+        {
+            Simulator::Schedule(statsStart + Seconds(simulationTime), &CheckStats);
+        }
+        Simulator::Stop(statsStart + Seconds(simulationTime));
+    };
+    if (fastStart)
     {
-        Simulator::Schedule(Seconds(5 + simulationTime), &CheckStats);
+        // start the stats once every MLD STA is associated (MaxMissedBeacons is
+        // unlimited, so each STA associates once); the stop at 5 s + simulationTime
+        // below remains as a bound
+        auto nUnassociated = std::make_shared<uint32_t>(mldDevCon.GetN());
+        for (auto dev = mldDevCon.Begin(); dev != mldDevCon.End(); ++dev)
+        {
+            auto staMac = DynamicCast<StaWifiMac>(DynamicCast<WifiNetDevice>(*dev)->GetMac());
+            staMac->TraceConnectWithoutContext(
+                "Assoc",
+                Callback<void, Mac48Address>([nUnassociated, startStats](Mac48Address) {
+                    if (--(*nUnassociated) == 0)
+                    {
+                        startStats(Seconds(0));
+                    }
+                }));
+        }
+    }
+    else
+    {
+        startStats(Seconds(5));
     }
 
     // mldPhyHelp.EnablePcap("single-bss-coex", allNetDevices);
@@ -663,7 +770,11 @@ main(int argc, char* argv[])
     // mldPhyHelp.EnableAsciiAll(asciiTrace.CreateFileStream("single-bss-coex.tr"));
 
     Simulator::Stop(Seconds(5 + simulationTime));
+    const auto runStart = std::chrono::steady_clock::now();
     Simulator::Run();
+    const auto runEnd = std::chrono::steady_clock::now();
+    const uint64_t numEvents = Simulator::GetEventCount();
+    const double simulatedTime = Simulator::Now().GetSeconds();
 
     auto finalResults = wifiTxStats.GetStatistics();
     auto successInfo = wifiTxStats.GetSuccessInfoMap();
@@ -923,7 +1034,99 @@ main(int argc, char* argv[])
             << acVICwminLink2 << "," << +acVICwStageLink2 << ","
             << acVOCwminLink2 << "," << +acVOCwStageLink2 << "\n";
     }
+
+    // cost of the run: setup, Simulator::Run and statistics, in wall-clock seconds
+    auto seconds = [](auto duration) { return std::chrono::duration<double>(duration).count(); };
+    double setupTime = seconds(runStart - wallStart);
+    double runTime = seconds(runEnd - runStart);
+    double statsTime = seconds(std::chrono::steady_clock::now() - runEnd);
+    double eventsPerSecond = numEvents / runTime;
+    double wallPerSimulatedSecond = runTime / simulatedTime;
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    uint64_t peakRssKb = usage.ru_maxrss; // of the process, so far
+    if (benchmark)
+    {
+        std::cout << "Benchmark: nMldSta " << nMldSta << ", numLinks " << numLinks
+                  << ", mldPerNodeLambda " << mldPerNodeLambda << ": setup " << setupTime
+                  << " s, run " << runTime << " s, stats " << statsTime << " s, " << numEvents
+                  << " events (" << eventsPerSecond << "/s), " << wallPerSimulatedSecond
+                  << " s per simulated s, peak RSS " << peakRssKb << " kB" << std::endl;
+    }
+    if (results)
+    {
+        results->Append("mldSuccPrLink1", mldSuccPrLink1);
+        results->Append("mldSuccPrLink2", mldSuccPrLink2);
+        results->Append("mldSuccPrTotal", mldSuccPrTotal);
+        results->Append("mldThptLink1", mldThptLink1);
+        results->Append("mldThptLink2", mldThptLink2);
+        results->Append("mldThptTotal", mldThptTotal);
+        results->Append("mldMeanQueDelayLink1", mldMeanQueDelayLink1);
+        results->Append("mldMeanQueDelayLink2", mldMeanQueDelayLink2);
+        results->Append("mldMeanQueDelayTotal", mldMeanQueDelayTotal);
+        results->Append("mldMeanAccDelayLink1", mldMeanAccDelayLink1);
+        results->Append("mldMeanAccDelayLink2", mldMeanAccDelayLink2);
+        results->Append("mldMeanAccDelayTotal", mldMeanAccDelayTotal);
+        results->Append("mldMeanE2eDelayLink1", mldMeanE2eDelayLink1);
+        results->Append("mldMeanE2eDelayLink2", mldMeanE2eDelayLink2);
+        results->Append("mldMeanE2eDelayTotal", mldMeanE2eDelayTotal);
+        results->Append("mldSecondRawMomentAccDelayLink1", mldSecondRawMomentAccDelayLink1);
+        results->Append("mldSecondRawMomentAccDelayLink2", mldSecondRawMomentAccDelayLink2);
+        results->Append("mldSecondRawMomentAccDelayTotal", mldSecondRawMomentAccDelayTotal);
+        results->Append("mldSecondCentralMomentAccDelayLink1", mldSecondCentralMomentAccDelayLink1);
+        results->Append("mldSecondCentralMomentAccDelayLink2", mldSecondCentralMomentAccDelayLink2);
+        results->Append("mldSecondCentralMomentAccDelayTotal", mldSecondCentralMomentAccDelayTotal);
+        results->Append("rngRun", rngRun);
+        results->Append("simulationTime", simulationTime);
+        results->Append("payloadSize", payloadSize);
+        results->Append("mcs", mcs);
+        results->Append("mcs2", mcs2);
+        results->Append("channelWidth", channelWidth);
+        results->Append("channelWidth2", channelWidth2);
+        results->Append("nMldSta", nMldSta);
+        results->Append("mldPerNodeLambda", mldPerNodeLambda);
+        results->Append("mldProbLink1", mldProbLink1);
+        results->Append("mldAcLink1Int", mldAcLink1Int);
+        results->Append("mldAcLink2Int", mldAcLink2Int);
+        results->Append("acBECwminLink1", acBECwminLink1);
+        results->Append("acBECwStageLink1", acBECwStageLink1);
+        results->Append("acBKCwminLink1", acBKCwminLink1);
+        results->Append("acBKCwStageLink1", acBKCwStageLink1);
+        results->Append("acVICwminLink1", acVICwminLink1);
+        results->Append("acVICwStageLink1", acVICwStageLink1);
+        results->Append("acVOCwminLink1", acVOCwminLink1);
+        results->Append("acVOCwStageLink1", acVOCwStageLink1);
+        results->Append("acBECwminLink2", acBECwminLink2);
+        results->Append("acBECwStageLink2", acBECwStageLink2);
+        results->Append("acBKCwminLink2", acBKCwminLink2);
+        results->Append("acBKCwStageLink2", acBKCwStageLink2);
+        results->Append("acVICwminLink2", acVICwminLink2);
+        results->Append("acVICwStageLink2", acVICwStageLink2);
+        results->Append("acVOCwminLink2", acVOCwminLink2);
+        results->Append("acVOCwStageLink2", acVOCwStageLink2);
+        if (benchmark)
+        {
+            results->Append("numLinks", numLinks);
+            results->Append("benchSetupTime", setupTime);
+            results->Append("benchRunTime", runTime);
+            results->Append("benchStatsTime", statsTime);
+            results->Append("benchEvents", numEvents);
+            results->Append("benchEventsPerSecond", eventsPerSecond);
+            results->Append("benchSimulatedTime", simulatedTime);
+            results->Append("benchWallPerSimulatedSecond", wallPerSimulatedSecond);
+            results->Append("benchPeakRssKb", peakRssKb);
+        }
+        results->EndRow();
+    }
     g_fileSummary.close();
+    results.reset();
     Simulator::Destroy();
     return 0;
-}
\ No newline at end of file
+}
+
+int
+main(int argc, char* argv[])
+{
+    // once, or once per line of --configs=<file>, see RunConfigurations
+    return RunConfigurations(argc, argv, RunSimulation);
+}
@@ -18,6 +18,7 @@
 
 #include "ns3/attribute-container.h"
 #include "ns3/bernoulli_packet_socket_client.h"
+#include "ns3/event-profiler-simulator-impl.h"
 #include "ns3/command-line.h"
 #include "ns3/config.h"
 #include "ns3/constant-rate-wifi-manager.h"
@@ -27,6 +28,7 @@
 #include "ns3/internet-stack-helper.h"
 #include "ns3/log.h"
 #include "ns3/mobility-helper.h"
+#include "ns3/multi-run.h"
 #include "ns3/multi-model-spectrum-channel.h"
 #include "ns3/on-off-helper.h"
 #include "ns3/packet-sink.h"
@@ -117,7 +119,7 @@ GetBernoulliClient(const PacketSocketAddress& sockAddr,
 }
 
 int
-main(int argc, char* argv[])
+RunSimulation(int argc, char* argv[])
 {
     std::ofstream g_fileSummary;
     g_fileSummary.open("wifi-dcf.dat", std::ofstream::app);
@@ -173,7 +175,17 @@ main(int argc, char* argv[])
     // cmd.AddValue("acVICwStage", "Cutoff Stage for AC_VI", acVICwStage);
     // cmd.AddValue("acVOCwmin", "Initial CW for AC_VO", acVOCwmin);
     // cmd.AddValue("acVOCwStage", "Cutoff Stage for AC_VO", acVOCwStage);
+    std::string eventProfile;
+    cmd.AddValue("eventProfile",
+                 "Profile the wall-clock time of the events by type and node, and write the "
+                 "report to <prefix>.txt and the folded stacks to <prefix>.folded "
+                 "(empty: no profiling)",
+                 eventProfile);
     cmd.Parse(argc, argv);
+    if (!eventProfile.empty())
+    {
+        EventProfilerSimulatorImpl::Enable(eventProfile);
+    }
 
     RngSeedManager::SetSeed(rngRun);
     RngSeedManager::SetRun(rngRun);
@@ -609,4 +621,11 @@ main(int argc, char* argv[])
     g_fileSummary.close();
     Simulator::Destroy();
     return 0;
-}
\ No newline at end of file
+}
+
+int
+main(int argc, char* argv[])
+{
+    // once, or once per line of --configs=<file>, see RunConfigurations
+    return RunConfigurations(argc, argv, RunSimulation);
+}
@@ -1,11 +1,14 @@
 import os
 import subprocess
-import shutil
 import signal
 import sys
 from datetime import datetime
 import matplotlib.pyplot as plt
 
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'utils'))
+from sweep import run_sweep, sweep_results_files
+from results_store import load_results_files
+
 def control_c(signum, frame):
     print("exiting")
     sys.exit(1)
@@ -27,10 +30,6 @@ def main():
 
     # Move to ns3 top-level directory
     os.chdir('../../../../')
-    
-
-    # Check for existing data files and prompt for removal
-    check_and_remove('wifi-mld.dat')
 
     # Experiment parameters
     rng_run = 1
@@ -38,13 +37,11 @@ def main():
     min_lambda = -5
     max_lambda = -2
     step_size = 1
-    lambdas = []
-    # Run the ns3 simulation for each distance
-    for lam in range(min_lambda, max_lambda + 1, step_size):
-        lambda_val = 10 ** lam
-        lambdas.append(lambda_val)
-        cmd = f"./ns3 run 'single-bss-mld --rngRun={rng_run} --payloadSize={max_packets} --mldPerNodeLambda={lambda_val}'"
-        subprocess.run(cmd, shell=True)
+    lambdas = [10 ** lam for lam in range(min_lambda, max_lambda + 1, step_size)]
+    # Run the ns3 simulation for each offered load, concurrently; the results of
+    # the runs are merged in the order of lambdas into results_dir/wifi-mld.dat
+    points, _ = run_sweep('single-bss-mld', {'mldPerNodeLambda': lambdas}, results_dir,
+                          fixed={'rngRun': rng_run, 'payloadSize': max_packets})
 
     # draw plots
     plt.figure()
@@ -53,22 +50,15 @@ def main():
     plt.ylabel('Throughput (Mbps)')
     plt.grid()
     plt.xscale('log')
-    throughput_l1 = []
-    throughput_l2 = []
-    throughput_total = []
-    with open('wifi-mld.dat', 'r') as f:
-        lines = f.readlines()
-        for line in lines:
-            tokens = line.split(',')
-            throughput_l1.append(float(tokens[3]))
-            throughput_l2.append(float(tokens[4]))
-            throughput_total.append(float(tokens[5]))
+    results = load_results_files(sweep_results_files(results_dir, points),
+                                 ['mldThptLink1', 'mldThptLink2', 'mldThptTotal'])
+    throughput_l1 = results['mldThptLink1']
+    throughput_l2 = results['mldThptLink2']
+    throughput_total = results['mldThptTotal']
     plt.plot(lambdas, throughput_l1, marker='o')
     plt.plot(lambdas, throughput_l2, marker='x')
     plt.plot(lambdas, throughput_total, marker='^')
     plt.savefig(os.path.join(results_dir, 'wifi-mld.png'))
-    # Move result files to the experiment directory
-    move_file('wifi-mld.dat', results_dir)
 
 
     # Save the git commit information
@@ -76,20 +66,6 @@ def main():
         commit_info = subprocess.run(['git', 'show', '--name-only'], stdout=subprocess.PIPE)
         f.write(commit_info.stdout.decode())
 
-    
-def check_and_remove(filename):
-    if os.path.exists(filename):
-        response = input(f"Remove existing file {filename}? [Yes/No]: ").strip().lower()
-        if response == 'yes':
-            os.remove(filename)
-            print(f"Removed {filename}")
-        else:
-            print("Exiting...")
-            sys.exit(1)
-
-def move_file(filename, destination_dir):
-    if os.path.exists(filename):
-        shutil.move(filename, destination_dir)
 
 if __name__ == "__main__":
     main()
@@ -0,0 +1,106 @@
+import argparse
+import csv
+import json
+import os
+import platform
+import subprocess
+import sys
+from datetime import datetime
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'utils'))
+from sweep import NS3_DIR, run_sweep, sweep_results_files
+from results_store import load_results_files
+
+# scenario inputs of a point, and the cost of its run (single-bss-mld --benchmark)
+POINT_COLUMNS = ['nMldSta', 'numLinks', 'mldPerNodeLambda']
+COST_COLUMNS = ['benchSetupTime', 'benchRunTime', 'benchStatsTime', 'benchEvents',
+                'benchEventsPerSecond', 'benchSimulatedTime', 'benchWallPerSimulatedSecond',
+                'benchPeakRssKb']
+RESULT_COLUMNS = ['mldThptTotal']
+
+
+def parse_list(text, kind):
+    return [kind(value) for value in text.split(',')]
+
+
+def git_commit():
+    result = subprocess.run(['git', 'rev-parse', 'HEAD'], cwd=NS3_DIR,
+                            stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+    return result.stdout.decode().strip()
+
+
+def write_report(results_dir, points, failed, args):
+    """Write scaling-report.json and scaling-report.csv, one record per point that ran."""
+    all_files = sweep_results_files(results_dir, points)
+    # a point that completed but left no results, e.g. the file could not be written
+    failed = sorted(set(failed) | {i for i, path in enumerate(all_files)
+                                   if not os.path.exists(path) or os.path.getsize(path) == 0})
+    ok = [i for i in range(len(points)) if i not in failed]
+    files = [all_files[i] for i in ok]
+    loaded = load_results_files(files, POINT_COLUMNS + COST_COLUMNS + RESULT_COLUMNS)
+    records = []
+    for row in range(len(ok)):
+        records.append({name: loaded[name][row].item() for name in loaded})
+    report = {
+        'program': 'single-bss-mld',
+        'date': datetime.now().isoformat(timespec='seconds'),
+        'commit': git_commit(),
+        'host': {'node': platform.node(), 'machine': platform.machine(),
+                 'cpus': os.cpu_count(), 'python': platform.python_version()},
+        'simulationTime': args.simulation_time,
+        'jobs': args.jobs,
+        'failed': [dict(points[i]) for i in failed],
+        'points': records,
+    }
+    with open(os.path.join(results_dir, 'scaling-report.json'), 'w') as f:
+        json.dump(report, f, indent=1)
+    with open(os.path.join(results_dir, 'scaling-report.csv'), 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=POINT_COLUMNS + COST_COLUMNS + RESULT_COLUMNS)
+        writer.writeheader()
+        writer.writerows(records)
+    return records, failed
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure how the cost of single-bss-mld grows with the number of '
+                    'STAs, the offered load and the number of links')
+    parser.add_argument('--nMldSta', type=lambda t: parse_list(t, int),
+                        default=[8, 16, 32, 64, 128, 256, 512])
+    parser.add_argument('--mldPerNodeLambda', type=lambda t: parse_list(t, float),
+                        default=[1e-5, 1e-4, 1e-3])
+    parser.add_argument('--numLinks', type=lambda t: parse_list(t, int), default=[1, 2])
+    parser.add_argument('--simulation-time', type=float, default=1.0,
+                        help='simulated seconds of statistics per point')
+    parser.add_argument('--jobs', type=int, default=1,
+                        help='concurrent runs; more than 1 makes the runs compete for the '
+                             'CPUs and the memory bandwidth, which biases the times')
+    parser.add_argument('--results-dir', default=None,
+                        help='default: results/mld-scaling-<date> next to this script')
+    args = parser.parse_args()
+
+    results_dir = args.results_dir or os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), 'results',
+        f"mld-scaling-{datetime.now().strftime('%Y%m%d-%H%M%S')}")
+    results_dir = os.path.abspath(results_dir)
+    grid = {'numLinks': args.numLinks, 'mldPerNodeLambda': args.mldPerNodeLambda,
+            'nMldSta': args.nMldSta}
+    fixed = {'rngRun': 1, 'simulationTime': args.simulation_time, 'fastStart': 'true',
+             'benchmark': 'true'}
+    # one point per process, so that the peak RSS is the one of the point
+    points, failed = run_sweep('single-bss-mld', grid, results_dir, jobs=args.jobs,
+                               fixed=fixed, batch_size=1)
+    records, failed = write_report(results_dir, points, failed, args)
+
+    print(f"{'links':>5} {'lambda':>8} {'STAs':>5} {'run (s)':>9} {'events/s':>10} "
+          f"{'s/sim s':>9} {'RSS (MB)':>9}")
+    for r in records:
+        print(f"{r['numLinks']:>5} {r['mldPerNodeLambda']:>8g} {r['nMldSta']:>5} "
+              f"{r['benchRunTime']:>9.3f} {r['benchEventsPerSecond']:>10.0f} "
+              f"{r['benchWallPerSimulatedSecond']:>9.3f} {r['benchPeakRssKb'] / 1024:>9.1f}")
+    print(f"Report: {os.path.join(results_dir, 'scaling-report.json')}")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -94,9 +94,13 @@ stepSize=5
 
 # Echo remaining commands to standard output, to track progress
 set -x
+# One configuration per distance, all run by a single link-performance process
+configsFile=link-performance-configs.txt
 for distance in `seq $minDistance $stepSize $maxDistance`; do
-  ./ns3 run "link-performance --maxPackets=${maxPackets} --transmitPower=${transmitPower} --noisePower=${noisePower} --distance=${distance} --metadata=${distance} --RngRun=${RngRun}"
-done
+  echo "--distance=${distance} --metadata=${distance}"
+done > ${configsFile}
+./ns3 run "link-performance --maxPackets=${maxPackets} --transmitPower=${transmitPower} --noisePower=${noisePower} --RngRun=${RngRun} --configs=${configsFile}"
+rm -f ${configsFile}
 
 # Move files from top level directory to the experiments directory
 mv link-performance-summary.dat ${experimentDir} 
@@ -0,0 +1,80 @@
+import struct
+
+import numpy as np
+
+# layout of ResultsStoreHeader, ResultsStoreColumn and ResultsStoreChunk (results-store.h)
+_HEADER_FORMAT = "<8s4I3Q"
+_HEADER_SIZE = struct.calcsize(_HEADER_FORMAT)
+_COLUMN_FORMAT = "<56s8s"
+_COLUMN_SIZE = struct.calcsize(_COLUMN_FORMAT)
+_CHUNK_FORMAT = "<2Q"
+_CHUNK_SIZE = struct.calcsize(_CHUNK_FORMAT)
+_MAGIC = b"UWRESULT"
+
+
+def read_header(path):
+    with open(path, "rb") as f:
+        raw = f.read(_HEADER_SIZE)
+        if len(raw) < _HEADER_SIZE:
+            raise ValueError("results_store: {} is too short".format(path))
+        magic, version, headerSize, numColumns, _, numRows, numChunks, endOffset = \
+            struct.unpack(_HEADER_FORMAT, raw)
+        if magic != _MAGIC:
+            raise ValueError("results_store: {} is not a results file".format(path))
+        columns = []
+        for _ in range(numColumns):
+            name, fmt = struct.unpack(_COLUMN_FORMAT, f.read(_COLUMN_SIZE))
+            columns.append((name.split(b"\0", 1)[0].decode(), fmt.split(b"\0", 1)[0].decode()))
+    return {
+        "version": version,
+        "headerSize": headerSize,
+        "numRows": numRows,
+        "numChunks": numChunks,
+        "endOffset": endOffset,
+        "columns": columns,
+    }
+
+
+# Load the columns of a results file written by ResultsStoreWriter.
+# The file is mapped and each column is gathered from its chunks, so only the
+# requested columns are read. Rows written after the call are not included.
+# \param[in] path : results file
+# \param[in] columns : names of the columns to load (default: all)
+# \return dict of column name to 1-D array, in file order
+def load_results(path, columns=None):
+    header = read_header(path)
+    wanted = [(name, np.dtype(fmt)) for name, fmt in header["columns"]
+              if columns is None or name in columns]
+    if columns is not None:
+        missing = set(columns) - set(name for name, _ in wanted)
+        if missing:
+            raise KeyError("results_store: no column {} in {}".format(sorted(missing), path))
+    if header["numRows"] == 0:
+        return {name: np.zeros((0,), dtype=dtype) for name, dtype in wanted}
+
+    raw = np.memmap(path, dtype=np.uint8, mode="r", shape=(header["endOffset"],))
+    parts = {name: [] for name, _ in wanted}
+    offset = header["headerSize"]
+    for _ in range(header["numChunks"]):
+        numRows, chunkSize = struct.unpack_from(_CHUNK_FORMAT, raw, offset)
+        data = offset + _CHUNK_SIZE
+        for name, fmt in header["columns"]:
+            size = numRows * np.dtype(fmt).itemsize
+            if name in parts:
+                parts[name].append(raw[data:data + size].view(fmt))
+            data += (size + 7) & ~7
+        offset += chunkSize
+    return {name: parts[name][0] if len(parts[name]) == 1 else np.concatenate(parts[name])
+            for name, _ in wanted}
+
+
+# Load several results files, e.g. the runs of a sweep, concatenated in the
+# given order. The files must have the same columns.
+def load_results_files(paths, columns=None):
+    loaded = [load_results(path, columns) for path in paths]
+    if not loaded:
+        return {}
+    return {name: np.concatenate([results[name] for results in loaded]) for name in loaded[0]}
+
+
+__all__ = ["load_results", "load_results_files", "read_header"]
@@ -0,0 +1,172 @@
+import argparse
+import itertools
+import os
+import re
+import shutil
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+# ns-3 top-level directory, relative to this file
+NS3_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '../../../..'))
+
+# line printed after each configuration run with --configs (see uwee595/model/multi-run.h)
+CONFIG_STATUS = re.compile(r'^RunConfigurations: configuration (\d+) status (-?\d+)$',
+                           re.MULTILINE)
+
+
+def grid_points(grid):
+    """All combinations of a parameter grid, in a fixed order.
+
+    grid maps a program argument (e.g. 'mldPerNodeLambda') to its values; the
+    last argument varies fastest.
+    """
+    names = list(grid.keys())
+    return [dict(zip(names, values)) for values in itertools.product(*grid.values())]
+
+
+def build(program):
+    subprocess.run([os.path.join(NS3_DIR, 'ns3'), 'build', program], cwd=NS3_DIR, check=True)
+
+
+def results_file(runs_dir, index):
+    """Results file (see results_store.py) of a point of the sweep."""
+    return os.path.join(runs_dir, f"{index:05d}-results.bin")
+
+
+def point_args(index, params, runs_dir, output_name):
+    """Program arguments of one point of the sweep, with its own output files."""
+    output = os.path.join(runs_dir, f"{index:05d}-{output_name}")
+    results = results_file(runs_dir, index)
+    for path in (output, results):
+        if os.path.exists(path):
+            os.remove(path)
+    args = ' '.join(f"--{name}={value}" for name, value in params.items())
+    return f"{args} --outputFile={output} --resultsFile={results}", output
+
+
+def run_batch(program, batch, points, runs_dir, output_name):
+    """Run points of the sweep in one process, one after the other (see --configs in
+    uwee595/model/multi-run.h), so that they pay the start of the program once.
+
+    A point failed unless the program reported that its configuration returned
+    0: an abort ends the process, and the points after it in the batch are not
+    run, yet the point that aborted may have left partial output files.
+    """
+    configs = []
+    outputs = []
+    for index in batch:
+        args, output = point_args(index, points[index], runs_dir, output_name)
+        configs.append(args)
+        outputs.append(output)
+    configs_file = os.path.join(runs_dir, f"{batch[0]:05d}.configs")
+    with open(configs_file, 'w') as f:
+        f.write('\n'.join(configs) + '\n')
+    cmd = [os.path.join(NS3_DIR, 'ns3'), 'run', '--no-build',
+           f"{program} --configs={configs_file}"]
+    log_file = os.path.join(runs_dir, f"{batch[0]:05d}.log")
+    with open(log_file, 'w') as log:
+        subprocess.run(cmd, cwd=NS3_DIR, stdout=log, stderr=subprocess.STDOUT)
+    with open(log_file, 'r', errors='replace') as log:
+        statuses = {int(m.group(1)): int(m.group(2)) for m in CONFIG_STATUS.finditer(log.read())}
+    return [(index, statuses.get(i, 1), output)
+            for i, (index, output) in enumerate(zip(batch, outputs))]
+
+
+def run_sweep(program, grid, results_dir, output_name='wifi-mld.dat', jobs=None, fixed=None,
+              batch_size=None):
+    """Run every point of grid concurrently and merge their outputs.
+
+    The points are split into batches of consecutive points, each run by one
+    process of the program. Each run appends to its own files under
+    results_dir/runs, and each batch has its own log there; once all runs are
+    done, the files are concatenated in grid order into results_dir/output_name,
+    so the merged file does not depend on the order the runs finished in. The
+    points are listed in results_dir/sweep-points.csv, in the same order. The
+    results files of the runs can be loaded in that order with
+    results_store.load_results_files(sweep_results_files(results_dir, points)).
+
+    program: ns-3 program accepting --outputFile and --resultsFile, e.g.
+        'single-bss-mld'
+    grid: dict of argument name to the list of its values
+    jobs: number of concurrent runs (default: number of CPUs)
+    fixed: dict of arguments passed to every run
+    batch_size: number of points run by a process (default: as many as gives
+        one batch per job); the program must accept --configs
+
+    Returns the list of points, in the order of the merged file, and the
+    indices of the runs that failed.
+    """
+    points = [dict(fixed or {}, **point) for point in grid_points(grid)]
+    runs_dir = os.path.join(results_dir, 'runs')
+    os.makedirs(runs_dir, exist_ok=True)
+    jobs = jobs or os.cpu_count() or 1
+
+    # build once, so that the concurrent runs do not rebuild
+    build(program)
+
+    batch_size = batch_size or max(1, -(-len(points) // jobs))
+    batches = [list(range(i, min(i + batch_size, len(points))))
+               for i in range(0, len(points), batch_size)]
+
+    outputs = [None] * len(points)
+    failed = []
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        futures = [pool.submit(run_batch, program, batch, points, runs_dir, output_name)
+                   for batch in batches]
+        done = 0
+        for future in as_completed(futures):
+            for index, returncode, output in future.result():
+                done += 1
+                outputs[index] = output
+                if returncode != 0:
+                    failed.append(index)
+                print(f"[{done}/{len(points)}] point {index} {'failed' if returncode else 'done'}")
+
+    with open(os.path.join(results_dir, output_name), 'w') as merged:
+        for output in outputs:
+            if os.path.exists(output):
+                with open(output, 'r') as f:
+                    shutil.copyfileobj(f, merged)
+    with open(os.path.join(results_dir, 'sweep-points.csv'), 'w') as f:
+        names = list(points[0].keys()) if points else []
+        f.write(','.join(['index'] + names) + '\n')
+        for i, point in enumerate(points):
+            f.write(','.join([str(i)] + [str(point[name]) for name in names]) + '\n')
+
+    if failed:
+        print(f"{len(failed)} run(s) failed, see the logs in {runs_dir}: {sorted(failed)}")
+    return points, sorted(failed)
+
+
+def sweep_results_files(results_dir, points):
+    """Results files of the runs of a sweep, in the order of points."""
+    runs_dir = os.path.join(results_dir, 'runs')
+    return [results_file(runs_dir, i) for i in range(len(points))]
+
+
+def parse_param(text):
+    name, values = text.split('=', 1)
+    return name, values.split(',')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run an ns-3 program over a parameter grid')
+    parser.add_argument('--program', default='single-bss-mld')
+    parser.add_argument('--param', action='append', type=parse_param, default=[],
+                        help='grid axis, e.g. --param mldPerNodeLambda=1e-5,1e-4 (repeatable)')
+    parser.add_argument('--jobs', type=int, default=None, help='concurrent runs (default: CPUs)')
+    parser.add_argument('--batch-size', type=int, default=None,
+                        help='points run by a process (default: one batch per job)')
+    parser.add_argument('--output', default='wifi-mld.dat', help='name of the merged file')
+    parser.add_argument('--results-dir', required=True)
+    args = parser.parse_args()
+    if not args.param:
+        parser.error('at least one --param is needed')
+    _, failed = run_sweep(args.program, dict(args.param), os.path.abspath(args.results_dir),
+                          args.output, args.jobs, batch_size=args.batch_size)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -38,13 +38,15 @@ def main():
     min_lambda = -4
     max_lambda = -1
     step_size = 1
-    lambdas = []
-    # Run the ns3 simulation for each distance
-    for lam in range(min_lambda, max_lambda + 1, step_size):
-        lambda_val = 10 ** lam
-        lambdas.append(lambda_val)
-        cmd = f"./ns3 run 'single-bss-sld --rngRun={rng_run} --payloadSize={max_packets} --perSldLambda={lambda_val}'"
-        subprocess.run(cmd, shell=True)
+    lambdas = [10 ** lam for lam in range(min_lambda, max_lambda + 1, step_size)]
+    # Run the ns3 simulation for each offered load, one after the other in a
+    # single process (--configs), each appending its line to wifi-dcf.dat
+    configs_file = os.path.join(results_dir, 'wifi-dcf.configs')
+    with open(configs_file, 'w') as f:
+        for lambda_val in lambdas:
+            f.write(f"--rngRun={rng_run} --payloadSize={max_packets} --perSldLambda={lambda_val}\n")
+    cmd = f"./ns3 run 'single-bss-sld --configs={configs_file}'"
+    subprocess.run(cmd, shell=True)
 
     # draw plots
     plt.figure()
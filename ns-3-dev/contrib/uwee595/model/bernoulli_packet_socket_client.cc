@@ -127,10 +127,33 @@ BernoulliPacketSocketClient::SetRemote(PacketSocketAddress addr)
    m_peerAddressSet = true;
 }
 
+void
+BernoulliPacketSocketClient::SetTrafficParams(Ptr<BernoulliTrafficParams> params)
+{
+   NS_LOG_FUNCTION(this << params);
+   m_params = params;
+}
+
+Ptr<BernoulliTrafficParams>
+BernoulliPacketSocketClient::GetTrafficParams() const
+{
+   return m_params;
+}
+
+int64_t
+BernoulliPacketSocketClient::AssignStreams(int64_t stream)
+{
+   NS_LOG_FUNCTION(this << stream);
+   m_uniformRngForInterval->SetStream(stream);
+   m_uniformRngForTid->SetStream(stream + 1);
+   return 2;
+}
+
 void
 BernoulliPacketSocketClient::DoDispose()
 {
    NS_LOG_FUNCTION(this);
+   m_params = nullptr;
    Application::DoDispose();
 }
 
@@ -188,18 +211,24 @@ BernoulliPacketSocketClient::Send()
    NS_LOG_FUNCTION(this);
    NS_ASSERT(m_sendEvent.IsExpired());
 
-   Ptr<Packet> p = Create<Packet>(m_size);
+   // the shared parameters, if any, take precedence over the attributes
+   uint32_t size = m_params ? m_params->m_size : m_size;
+   uint8_t optionalTid = m_params ? m_params->m_optionalTid : m_optionalTid;
+   double optionalTidPr = m_params ? m_params->m_optionalTidPr : m_optionalTidPr;
+   double bernoulliPr = m_params ? m_params->m_bernoulliPr : m_bernoulliPr;
+
+   Ptr<Packet> p = Create<Packet>(size);
 
    std::stringstream peerAddressStringStream;
    peerAddressStringStream << PacketSocketAddress::ConvertFrom(m_peerAddress);
 
-   if (m_optionalTid != m_priority)
+   if (optionalTid != m_priority)
    {
        // can give the optional TID a try, e.g., set the socket's priority
-       if (m_uniformRngForTid->GetValue() < m_optionalTidPr)
+       if (m_uniformRngForTid->GetValue() < optionalTidPr)
        {
            // use the optional TID
-           m_socket->SetPriority(m_optionalTid);
+           m_socket->SetPriority(optionalTid);
        }
        else
        {
@@ -211,13 +240,13 @@ BernoulliPacketSocketClient::Send()
    if ((m_socket->Send(p)) >= 0)
    {
        m_txTrace(p, m_peerAddress);
-       NS_LOG_INFO("TraceDelay TX " << m_size << " bytes to " << peerAddressStringStream.str()
+       NS_LOG_INFO("TraceDelay TX " << size << " bytes to " << peerAddressStringStream.str()
                                     << " Uid: " << p->GetUid()
                                     << " Time: " << (Simulator::Now()).GetSeconds());
    }
    else
    {
-       NS_LOG_INFO("Error while sending " << m_size << " bytes to "
+       NS_LOG_INFO("Error while sending " << size << " bytes to "
                                           << peerAddressStringStream.str());
    }
    m_sent++;
@@ -225,8 +254,8 @@ BernoulliPacketSocketClient::Send()
     // sample a geometric random number from uniform distribution
    // which is the inter-arrival time
     double uniform = m_uniformRngForInterval->GetValue();
-    NS_ASSERT(m_bernoulliPr < 1);
-    double numInterval = std::floor(std::log(uniform) / std::log(1 - m_bernoulliPr)) + 1;
+    NS_ASSERT(bernoulliPr < 1);
+    double numInterval = std::floor(std::log(uniform) / std::log(1 - bernoulliPr)) + 1;
     NS_ASSERT(numInterval > 0);
     Time interval = numInterval * m_timeSlot;
 
@@ -26,6 +26,7 @@
 #include "ns3/event-id.h"
 #include "ns3/packet-socket-address.h"
 #include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/traced-callback.h"
 #include "ns3/random-variable-stream.h"
 
@@ -35,6 +36,22 @@ namespace ns3
 class Socket;
 class Packet;
 
+/**
+ * \brief Traffic parameters shared by several BernoulliPacketSocketClient.
+ *
+ * A client given a parameter block reads it on every Send(), in place of its
+ * BernoulliPr, OptionalTid, OptionalTidPr and PacketSize attributes, so a
+ * single update of the block reaches all the clients sharing it at their next
+ * packet.
+ */
+struct BernoulliTrafficParams : public SimpleRefCount<BernoulliTrafficParams>
+{
+    double m_bernoulliPr{0.5};  //!< probability of an arrival in a time slot
+    uint8_t m_optionalTid{0};   //!< another TID, used if different from the priority
+    double m_optionalTidPr{0};  //!< probability to use the optional TID
+    uint32_t m_size{1024};      //!< size of the sent packets
+};
+
 /**
  * \ingroup socket
  *
@@ -78,6 +95,26 @@ class BernoulliPacketSocketClient : public Application
      */
     uint8_t GetPriority() const;
 
+    /**
+     * \brief Use a shared parameter block instead of the traffic attributes
+     * \param params the parameter block, or nullptr to use the attributes again
+     */
+    void SetTrafficParams(Ptr<BernoulliTrafficParams> params);
+
+    /**
+     * \return the shared parameter block, or nullptr if the attributes are used
+     */
+    Ptr<BernoulliTrafficParams> GetTrafficParams() const;
+
+    /**
+     * Assign a fixed random variable stream number to the random variables
+     * used by this model (the arrivals and the choice of the TID).
+     *
+     * \param stream first stream index to use
+     * \return the number of stream indices assigned by this model
+     */
+    int64_t AssignStreams(int64_t stream) override;
+
   protected:
     void DoDispose() override;
 
@@ -115,6 +152,8 @@ class BernoulliPacketSocketClient : public Application
     uint8_t m_optionalTid;
     double m_optionalTidPr;
 
+    Ptr<BernoulliTrafficParams> m_params; //!< shared parameters, if set
+
     /// Traced Callback: sent packets, source address.
     TracedCallback<Ptr<const Packet>, const Address&> m_txTrace;
 };
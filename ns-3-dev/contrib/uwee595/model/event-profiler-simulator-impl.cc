@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "event-profiler-simulator-impl.h"
+
+#include "ns3/config.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfilerSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(EventProfilerSimulatorImpl);
+
+namespace
+{
+
+// events of a type and context
+struct EventKey
+{
+    std::type_index type;
+    uint32_t context;
+
+    bool operator==(const EventKey& other) const
+    {
+        return type == other.type && context == other.context;
+    }
+};
+
+struct EventKeyHash
+{
+    std::size_t operator()(const EventKey& key) const
+    {
+        return key.type.hash_code() ^ (std::size_t(key.context) * 0x9e3779b97f4a7c15ULL);
+    }
+};
+
+struct EventTotals
+{
+    uint64_t count{0};
+    uint64_t ns{0};
+};
+
+// the measurements of the process, across simulator instances
+std::unordered_map<EventKey, EventTotals, EventKeyHash>&
+GetEventTotals()
+{
+    static std::unordered_map<EventKey, EventTotals, EventKeyHash> totals;
+    return totals;
+}
+
+// An event wrapped to be measured
+class ProfiledEventImpl : public EventImpl
+{
+  public:
+    explicit ProfiledEventImpl(EventImpl* event)
+        : m_event(event, false)
+    {
+    }
+
+  protected:
+    void Notify() override
+    {
+        uint32_t context = Simulator::GetContext();
+        auto start = std::chrono::steady_clock::now();
+        m_event->Invoke();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+        EventTotals& totals = GetEventTotals()[EventKey{typeid(*m_event), context}];
+        totals.count++;
+        totals.ns += ns;
+    }
+
+  private:
+    Ptr<EventImpl> m_event; //!< the event
+};
+
+// Name of an event type: the function given to MakeEvent when it can be found in the
+// name of the EventImpl, e.g. "void (Txop::*)(unsigned char)", else the demangled name
+std::string
+GetEventTypeName(const std::type_index& type)
+{
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    std::string name = (status == 0 && demangled) ? demangled : type.name();
+    std::free(demangled);
+
+    // first template argument of MakeEvent
+    const std::string makeEvent = "MakeEvent<";
+    std::size_t begin = name.find(makeEvent);
+    if (begin != std::string::npos)
+    {
+        begin += makeEvent.size();
+        int depth = 0;
+        for (std::size_t i = begin; i < name.size(); ++i)
+        {
+            char c = name[i];
+            if (c == '<' || c == '(' || c == '[' || c == '{')
+            {
+                depth++;
+            }
+            else if ((c == ',' || c == '>') && depth == 0)
+            {
+                name = name.substr(begin, i - begin);
+                break;
+            }
+            else if (c == '>' || c == ')' || c == ']' || c == '}')
+            {
+                depth--;
+            }
+        }
+    }
+
+    // shorter, and ';' separates the frames of folded stacks
+    const std::string ns3Prefix = "ns3::";
+    for (std::size_t pos; (pos = name.find(ns3Prefix)) != std::string::npos;)
+    {
+        name.erase(pos, ns3Prefix.size());
+    }
+    std::replace(name.begin(), name.end(), ';', ',');
+    return name;
+}
+
+std::string
+GetContextName(uint32_t context)
+{
+    return context == Simulator::NO_CONTEXT ? "no context" : "node " + std::to_string(context);
+}
+
+// one line of the report
+struct ReportLine
+{
+    std::string type;
+    uint32_t context;
+    EventTotals totals;
+};
+
+std::vector<ReportLine>
+GetReportLines()
+{
+    std::vector<ReportLine> lines;
+    std::map<std::type_index, std::string> names;
+    for (const auto& [key, totals] : GetEventTotals())
+    {
+        auto it = names.find(key.type);
+        if (it == names.end())
+        {
+            it = names.emplace(key.type, GetEventTypeName(key.type)).first;
+        }
+        lines.push_back({it->second, key.context, totals});
+    }
+    return lines;
+}
+
+void
+SortByTime(std::vector<ReportLine>& lines)
+{
+    std::sort(lines.begin(), lines.end(), [](const ReportLine& a, const ReportLine& b) {
+        return a.totals.ns != b.totals.ns ? a.totals.ns > b.totals.ns : a.type < b.type;
+    });
+}
+
+void
+PrintLines(std::ostream& os, const std::vector<ReportLine>& lines, uint64_t totalNs, bool context)
+{
+    os << std::right << std::setw(12) << "time (ms)" << std::setw(8) << "share" << std::setw(12)
+       << "events" << std::setw(12) << "mean (us)";
+    if (context)
+    {
+        os << "  " << std::left << std::setw(12) << "context";
+    }
+    os << "  type\n";
+    for (const auto& line : lines)
+    {
+        os << std::right << std::setw(12) << line.totals.ns / 1e6 << std::setw(7)
+           << (totalNs ? 100.0 * line.totals.ns / totalNs : 0) << "%" << std::setw(12)
+           << line.totals.count << std::setw(12)
+           << (line.totals.count ? line.totals.ns / 1e3 / line.totals.count : 0);
+        if (context)
+        {
+            os << "  " << std::left << std::setw(12) << GetContextName(line.context);
+        }
+        os << "  " << line.type << "\n";
+    }
+}
+
+} // namespace
+
+TypeId
+EventProfilerSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::EventProfilerSimulatorImpl")
+            .SetParent<DefaultSimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<EventProfilerSimulatorImpl>()
+            .AddAttribute("ReportFile",
+                          "File the report of the events is written to at Simulator::Destroy "
+                          "(empty: none)",
+                          StringValue("event-profile.txt"),
+                          MakeStringAccessor(&EventProfilerSimulatorImpl::m_reportFile),
+                          MakeStringChecker())
+            .AddAttribute("FoldedFile",
+                          "File the folded stacks of the events are written to at "
+                          "Simulator::Destroy (empty: none)",
+                          StringValue("event-profile.folded"),
+                          MakeStringAccessor(&EventProfilerSimulatorImpl::m_foldedFile),
+                          MakeStringChecker());
+    return tid;
+}
+
+EventProfilerSimulatorImpl::EventProfilerSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EventProfilerSimulatorImpl::~EventProfilerSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+EventProfilerSimulatorImpl::Enable(const std::string& prefix)
+{
+    NS_LOG_FUNCTION(prefix);
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::EventProfilerSimulatorImpl"));
+    Config::SetDefault("ns3::EventProfilerSimulatorImpl::ReportFile", StringValue(prefix + ".txt"));
+    Config::SetDefault("ns3::EventProfilerSimulatorImpl::FoldedFile",
+                       StringValue(prefix + ".folded"));
+}
+
+EventImpl*
+EventProfilerSimulatorImpl::Wrap(EventImpl* event)
+{
+    return new ProfiledEventImpl(event);
+}
+
+EventId
+EventProfilerSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    return DefaultSimulatorImpl::Schedule(delay, Wrap(event));
+}
+
+void
+EventProfilerSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    DefaultSimulatorImpl::ScheduleWithContext(context, delay, Wrap(event));
+}
+
+EventId
+EventProfilerSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return DefaultSimulatorImpl::ScheduleNow(Wrap(event));
+}
+
+void
+EventProfilerSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    DefaultSimulatorImpl::Destroy();
+    if (!m_reportFile.empty())
+    {
+        std::ofstream report(m_reportFile);
+        PrintReport(report);
+        NS_LOG_INFO("Event report written to " << m_reportFile);
+    }
+    if (!m_foldedFile.empty())
+    {
+        std::ofstream folded(m_foldedFile);
+        PrintFolded(folded);
+        NS_LOG_INFO("Folded event stacks written to " << m_foldedFile);
+    }
+}
+
+void
+EventProfilerSimulatorImpl::PrintReport(std::ostream& os)
+{
+    std::vector<ReportLine> lines = GetReportLines();
+    uint64_t totalNs = 0;
+    uint64_t totalCount = 0;
+    std::map<std::string, EventTotals> byType;
+    for (const auto& line : lines)
+    {
+        totalNs += line.totals.ns;
+        totalCount += line.totals.count;
+        byType[line.type].count += line.totals.count;
+        byType[line.type].ns += line.totals.ns;
+    }
+    std::vector<ReportLine> typeLines;
+    for (const auto& [type, totals] : byType)
+    {
+        typeLines.push_back({type, Simulator::NO_CONTEXT, totals});
+    }
+    SortByTime(typeLines);
+    SortByTime(lines);
+
+    auto flags = os.flags();
+    auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "Event profile: " << totalCount << " events, " << totalNs / 1e6
+       << " ms in their callbacks\n\nBy event type\n";
+    PrintLines(os, typeLines, totalNs, false);
+    os << "\nBy event type and context\n";
+    PrintLines(os, lines, totalNs, true);
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void
+EventProfilerSimulatorImpl::PrintFolded(std::ostream& os)
+{
+    std::vector<ReportLine> lines = GetReportLines();
+    SortByTime(lines);
+    for (const auto& line : lines)
+    {
+        os << line.type << ";" << GetContextName(line.context) << " " << line.totals.ns << "\n";
+    }
+}
+
+void
+EventProfilerSimulatorImpl::Reset()
+{
+    GetEventTotals().clear();
+}
+
+} // namespace ns3
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef EVENT_PROFILER_SIMULATOR_IMPL_H
+#define EVENT_PROFILER_SIMULATOR_IMPL_H
+
+#include "ns3/default-simulator-impl.h"
+
+#include <ostream>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \brief Simulator implementation that measures the wall-clock time of the events.
+ *
+ * It is the default implementation, except that each scheduled event is wrapped to
+ * count its invocations and time its callback, per event type and context (the node
+ * the event runs on). The event type is the type of the EventImpl, which MakeEvent
+ * derives from the scheduled function: events of the same class and signature are
+ * merged, e.g. the methods of a class taking no argument. Trace callbacks are counted
+ * in the event that fires them. The events run at Simulator::Destroy are not timed.
+ *
+ * The measurements are kept for the whole process, across Simulator::Destroy, so that
+ * the runs of a process add up. At each Simulator::Destroy, a report sorted by time
+ * and a file of folded stacks (type;context time in ns, for flamegraph.pl or
+ * speedscope) are written with the totals so far.
+ *
+ * It is selected with the SimulatorImplementationType global value, see Enable(); the
+ * default implementation is left untouched otherwise, so that profiling costs nothing
+ * when it is not enabled.
+ */
+class EventProfilerSimulatorImpl : public DefaultSimulatorImpl
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    EventProfilerSimulatorImpl();
+    ~EventProfilerSimulatorImpl() override;
+
+    void Destroy() override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+
+    /**
+     * Select this implementation for the simulator, which must not be created yet
+     * \param prefix prefix of the files written: <prefix>.txt for the report and
+     *        <prefix>.folded for the folded stacks
+     */
+    static void Enable(const std::string& prefix);
+
+    /**
+     * Print the events of the process so far by type, and by type and context, sorted
+     * by wall-clock time
+     */
+    static void PrintReport(std::ostream& os);
+
+    /**
+     * Print the events of the process so far as folded stacks: one "type;context ns"
+     * line per type and context
+     */
+    static void PrintFolded(std::ostream& os);
+
+    /**
+     * Forget the events measured so far
+     */
+    static void Reset();
+
+  private:
+    /**
+     * Wrap an event to measure it
+     * \param event the event, whose reference is taken over
+     * \return the wrapper, holding one reference
+     */
+    static EventImpl* Wrap(EventImpl* event);
+
+    std::string m_reportFile; //!< file the report is written to (empty: none)
+    std::string m_foldedFile; //!< file the folded stacks are written to (empty: none)
+};
+
+} // namespace ns3
+
+#endif // EVENT_PROFILER_SIMULATOR_IMPL_H
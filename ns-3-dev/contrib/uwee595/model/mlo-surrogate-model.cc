@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mlo-surrogate-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MloSurrogateModel");
+
+namespace
+{
+
+const double EHT_PREAMBLE = 48e-6;     // L-STF to one EHT-LTF of an EHT MU PPDU
+const double EHT_SYMBOL = 13.6e-6;     // 12.8 us + 800 ns GI
+const double NON_HT_PREAMBLE = 20e-6;  // L-STF, L-LTF and L-SIG
+const double NON_HT_SYMBOL = 4e-6;
+const double PHY_RX_START = 20e-6;     // ack timeout margin for the start of the ack
+const uint32_t MAC_OVERHEAD = 42;      // QoS data header, FCS, A-MPDU subframe header, LLC
+const uint32_t ACK_SIZE = 14;
+const uint32_t SERVICE_TAIL_BITS = 16 + 6;
+const uint32_t MAX_ITERATIONS = 1000;
+const double TOLERANCE = 1e-10; // relative, on the attempt probability
+// with unlimited retries, the backoff stages are walked until the pkts not acked yet
+// are below this probability; they are counted as dropped
+const double UNLIMITED_RETRIES_TAIL_PR = 1e-12;
+const uint32_t MAX_UNLIMITED_STAGES = 100000;
+
+// coded bits per subcarrier times coding rate, per MCS
+const double BITS_PER_SUBCARRIER[] = {
+    0.5, 1, 1.5, 2, 3, 4, 4.5, 5, 6, 20.0 / 3, 7.5, 25.0 / 3, 9, 10};
+
+} // namespace
+
+bool
+MloSurrogateLinkConfig::operator==(const MloSurrogateLinkConfig& other) const
+{
+    return m_mcs == other.m_mcs && m_channelWidth == other.m_channelWidth &&
+           m_cwmin == other.m_cwmin && m_cwStage == other.m_cwStage && m_aifsn == other.m_aifsn;
+}
+
+bool
+MloSurrogateConfig::operator==(const MloSurrogateConfig& other) const
+{
+    return m_nMldSta == other.m_nMldSta && m_mldPerNodeLambda == other.m_mldPerNodeLambda &&
+           m_mldProbLink1 == other.m_mldProbLink1 && m_payloadSize == other.m_payloadSize &&
+           m_retryLimit == other.m_retryLimit && m_maxQueueSize == other.m_maxQueueSize &&
+           m_maxQueueDelay == other.m_maxQueueDelay && m_duration == other.m_duration &&
+           m_links == other.m_links;
+}
+
+double
+MloSurrogateModel::GetDataRate(int mcs, int channelWidth)
+{
+    NS_ABORT_MSG_IF(mcs < 0 || mcs > 13, "Invalid EHT MCS " << mcs);
+    double dataSubcarriers = 0;
+    switch (channelWidth)
+    {
+    case 20:
+        dataSubcarriers = 234;
+        break;
+    case 40:
+        dataSubcarriers = 468;
+        break;
+    case 80:
+        dataSubcarriers = 980;
+        break;
+    case 160:
+        dataSubcarriers = 1960;
+        break;
+    case 320:
+        dataSubcarriers = 3920;
+        break;
+    default:
+        NS_ABORT_MSG("Invalid channel width " << channelWidth);
+    }
+    return dataSubcarriers * BITS_PER_SUBCARRIER[mcs] / EHT_SYMBOL;
+}
+
+double
+MloSurrogateModel::GetDataTxDuration(uint32_t payloadSize, int mcs, int channelWidth)
+{
+    double bitsPerSymbol = GetDataRate(mcs, channelWidth) * EHT_SYMBOL;
+    double bits = SERVICE_TAIL_BITS + 8.0 * (payloadSize + MAC_OVERHEAD);
+    return EHT_PREAMBLE + std::ceil(bits / bitsPerSymbol) * EHT_SYMBOL;
+}
+
+double
+MloSurrogateModel::GetAckTxDuration(int mcs)
+{
+    // highest basic rate (6, 12 or 24 Mbps) below the non-HT reference rate of the MCS
+    double rate = (mcs == 0 ? 6e6 : mcs < 3 ? 12e6 : 24e6);
+    double bits = SERVICE_TAIL_BITS + 8.0 * ACK_SIZE;
+    return NON_HT_PREAMBLE + std::ceil(bits / (rate * NON_HT_SYMBOL)) * NON_HT_SYMBOL;
+}
+
+MloSurrogateLinkStats
+MloSurrogateModel::SolveLink(std::size_t nSta,
+                             double arrivalPr,
+                             uint32_t payloadSize,
+                             uint32_t retryLimit,
+                             uint32_t maxQueueSize,
+                             double maxQueueDelay,
+                             double duration,
+                             const MloSurrogateLinkConfig& link)
+{
+    NS_LOG_FUNCTION(nSta << arrivalPr << payloadSize << retryLimit << maxQueueSize
+                         << maxQueueDelay << duration);
+    MloSurrogateLinkStats stats;
+    if (nSta == 0 || arrivalPr <= 0)
+    {
+        stats.m_succPr = 1;
+        return stats;
+    }
+    NS_ABORT_MSG_IF(link.m_cwmin == 0, "The contention window must hold at least one slot");
+
+    double aifs = SIFS + link.m_aifsn * SLOT;
+    double dataTx = GetDataTxDuration(payloadSize, link.m_mcs, link.m_channelWidth);
+    // a success is followed by the ack, a collision by the ack timeout
+    double ts = dataTx + SIFS + GetAckTxDuration(link.m_mcs) + aifs;
+    double tc = dataTx + SIFS + SLOT + PHY_RX_START + aifs;
+    double arrivalRate = arrivalPr / SLOT;
+    bool unlimitedRetries = (retryLimit == MloSurrogateConfig::UNLIMITED_RETRIES);
+
+    double tau = 0;
+    double lastStep = 0;
+    double damping = 1;
+    for (stats.m_iterations = 1; stats.m_iterations <= MAX_ITERATIONS; ++stats.m_iterations)
+    {
+        double p = 1 - std::pow(1 - tau, nSta - 1);
+        // a backoff slot of a STA lasts as long as the activity of the other STAs in it
+        double othersSuccessPr =
+            (nSta > 1 ? (nSta - 1) * tau * std::pow(1 - tau, nSta - 2) : 0);
+        double slot = (1 - p) * SLOT + othersSuccessPr * ts + (p - othersSuccessPr) * tc;
+
+        // walk the backoff stages; the service time ends with the ack or the drop
+        double reachPr = 1;      // probability of reaching the stage, p^i
+        double backoffMean = 0;  // duration of the backoffs up to the stage
+        double backoffVar = 0;
+        double attempts = 0;     // attempts and backoff slots per pkt
+        double backoffSlots = 0;
+        double succMean = 0;     // moments of the service time of the successful pkts
+        double succSquare = 0;
+        double succAttempts = 0;
+        uint32_t numStages = 0;
+        for (uint32_t i = 0; i <= retryLimit; ++i)
+        {
+            if (unlimitedRetries &&
+                (reachPr < UNLIMITED_RETRIES_TAIL_PR || i == MAX_UNLIMITED_STAGES))
+            {
+                break;
+            }
+            // the stages after the last doubling stay at CWmax
+            double cw = link.m_cwmin * std::pow(2.0, std::min<uint32_t>(i, link.m_cwStage));
+            backoffMean += (cw - 1) / 2 * slot;
+            backoffVar += (cw * cw - 1) / 12 * slot * slot;
+            attempts += reachPr;
+            backoffSlots += reachPr * (cw - 1) / 2;
+            double delay = backoffMean + i * tc + ts;
+            double successPr = reachPr * (1 - p);
+            succMean += successPr * delay;
+            succSquare += successPr * (backoffVar + delay * delay);
+            succAttempts += successPr * (i + 1);
+            reachPr *= p;
+            numStages++;
+        }
+        double dropDelay = backoffMean + numStages * tc;
+        double deliveredPr = 1 - reachPr;
+        double serviceMean = succMean + reachPr * dropDelay;
+        double serviceSquare = succSquare + reachPr * (backoffVar + dropDelay * dropDelay);
+
+        double rho = arrivalRate * serviceMean;
+        double tauNew = std::min(rho, 1.0) * attempts / (attempts + backoffSlots);
+
+        stats.m_attemptPr = tauNew;
+        stats.m_collisionPr = p;
+        stats.m_utilization = rho;
+        stats.m_succPr = deliveredPr / succAttempts;
+        stats.m_meanAccDelayMs = succMean / deliveredPr * 1e3;
+        stats.m_secondRawMomentAccDelayMs2 = succSquare / deliveredPr * 1e6;
+        stats.m_secondCentralMomentAccDelayMs2 =
+            stats.m_secondRawMomentAccDelayMs2 -
+            stats.m_meanAccDelayMs * stats.m_meanAccDelayMs;
+        // Pollaczek-Khinchine, capped at half the observation time; an overloaded
+        // queue also grows by rho - 1 seconds of backlog per second
+        double queDelay =
+            (rho < 1 ? arrivalRate * serviceSquare / (2 * (1 - rho)) : duration / 2);
+        queDelay = std::min(queDelay, duration / 2);
+        if (rho >= 1)
+        {
+            queDelay += (rho - 1) * duration / 2;
+        }
+        // the MAC queue drops the pkts beyond its size or its max delay
+        queDelay = std::min({queDelay, maxQueueSize * serviceMean, maxQueueDelay});
+        stats.m_meanQueDelayMs = queDelay * 1e3;
+        stats.m_successRate =
+            nSta * deliveredPr * (rho < 1 ? arrivalRate : 1 / serviceMean);
+
+        if (std::abs(tauNew - tau) <= TOLERANCE * tauNew)
+        {
+            break;
+        }
+        // plain iterations converge fast at low load; damp them once they oscillate
+        double step = tauNew - tau;
+        if (step * lastStep < 0)
+        {
+            damping = 0.5;
+        }
+        lastStep = step;
+        tau += damping * step;
+    }
+    NS_LOG_DEBUG("tau=" << stats.m_attemptPr << " p=" << stats.m_collisionPr
+                        << " rho=" << stats.m_utilization << " after " << stats.m_iterations
+                        << " iterations");
+    return stats;
+}
+
+const std::array<MloSurrogateLinkStats, MloSurrogateModel::N_LINKS>&
+MloSurrogateModel::Solve(const MloSurrogateConfig& config)
+{
+    if (m_solved && config == m_config)
+    {
+        return m_stats;
+    }
+    std::array<double, N_LINKS> linkPr = {config.m_mldProbLink1, 1 - config.m_mldProbLink1};
+    for (std::size_t linkId = 0; linkId < N_LINKS; ++linkId)
+    {
+        m_stats[linkId] = SolveLink(config.m_nMldSta,
+                                    config.m_mldPerNodeLambda * linkPr[linkId],
+                                    config.m_payloadSize,
+                                    config.m_retryLimit,
+                                    config.m_maxQueueSize,
+                                    config.m_maxQueueDelay,
+                                    config.m_duration,
+                                    config.m_links[linkId]);
+    }
+    m_config = config;
+    m_solved = true;
+    return m_stats;
+}
+
+} // namespace ns3
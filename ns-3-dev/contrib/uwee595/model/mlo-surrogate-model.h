@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NS3_MLO_SURROGATE_MODEL_H
+#define NS3_MLO_SURROGATE_MODEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ns3
+{
+
+/**
+ * \brief EDCA and PHY configuration of a link for MloSurrogateModel
+ */
+struct MloSurrogateLinkConfig
+{
+    int m_mcs{6};            //!< EHT MCS, 1 spatial stream, 800 ns GI
+    int m_channelWidth{20};  //!< channel width in MHz
+    uint64_t m_cwmin{16};    //!< initial contention window (backoff drawn in [0, CWmin - 1])
+    uint8_t m_cwStage{6};    //!< number of times the contention window is doubled
+    uint8_t m_aifsn{2};      //!< AIFSN of the AC used on the link (2: AIFS = DIFS)
+
+    bool operator==(const MloSurrogateLinkConfig& other) const;
+};
+
+/**
+ * \brief Scenario of MloSurrogateModel, i.e. the parameters of the single BSS MLD scenario
+ */
+struct MloSurrogateConfig
+{
+    //! m_retryLimit of persistent retransmissions: the pkts are never dropped by the MAC
+    static constexpr uint32_t UNLIMITED_RETRIES = std::numeric_limits<uint32_t>::max();
+
+    std::size_t m_nMldSta{5};        //!< number of MLD STAs
+    double m_mldPerNodeLambda{1e-5}; //!< probability that a STA generates a pkt in a slot
+    double m_mldProbLink1{0.5};      //!< probability that a pkt is sent on link 1
+    uint32_t m_payloadSize{1500};    //!< application payload size in bytes
+    uint32_t m_retryLimit{7};        //!< retransmissions before a pkt is dropped, or
+                                     //!< UNLIMITED_RETRIES
+    uint32_t m_maxQueueSize{500};    //!< size of the MAC queue of a STA, in pkts
+    double m_maxQueueDelay{0.5};     //!< time after which a queued pkt is dropped, seconds
+    double m_duration{1};            //!< observation time in seconds, see MloSurrogateLinkStats
+    std::array<MloSurrogateLinkConfig, 2> m_links; //!< configuration of link 1 and link 2
+
+    bool operator==(const MloSurrogateConfig& other) const;
+};
+
+/**
+ * \brief Steady state of a link given by MloSurrogateModel
+ *
+ * The delays are those of the successful pkts, split as in WifiTxStatsHelper: the
+ * queuing delay ends when the pkt reaches the head of the queue, the access delay
+ * ends when it is acked. When the arrivals exceed what the link can serve
+ * (m_utilization >= 1), the queues grow during the whole observation time, and the
+ * mean queuing delay is that of a pkt arriving in its middle, up to what the MAC
+ * queue keeps (its size and its max delay).
+ */
+struct MloSurrogateLinkStats
+{
+    double m_attemptPr{0};                     //!< probability that a STA transmits in a slot
+    double m_collisionPr{0};                   //!< probability that a transmission collides
+    double m_utilization{0};                   //!< arrival rate x mean service time of a STA
+    double m_succPr{0};                        //!< successful pkts / their TX attempts
+    double m_successRate{0};                   //!< successful pkts per second, all STAs
+    double m_meanQueDelayMs{0};                //!< mean queuing delay
+    double m_meanAccDelayMs{0};                //!< mean access delay
+    double m_secondRawMomentAccDelayMs2{0};    //!< mean of the squared access delay
+    double m_secondCentralMomentAccDelayMs2{0}; //!< variance of the access delay
+    uint32_t m_iterations{0};                  //!< iterations of the fixed point
+};
+
+/**
+ * \brief Analytical model of the single BSS MLD scenario, to screen configurations
+ * and to train agents without simulating.
+ *
+ * Each link is solved as an independent DCF with Bernoulli arrivals, with the
+ * fixed point of Bianchi's model extended to a retry limit (or to persistent
+ * retransmissions, the stages after the last doubling keeping CWmax) and to non-saturated
+ * STAs: a STA transmits in a slot with probability tau = rho * tau_sat(p), where
+ * tau_sat is the saturated attempt probability for the collision probability
+ * p = 1 - (1 - tau)^(n - 1), and rho is the fraction of time its queue is not
+ * empty, i.e. its arrival rate times its mean service time. The queues are then
+ * M/G/1 queues (Pollaczek-Khinchine). The PHY durations follow the EHT PPDUs of
+ * the scenario, with normal acks at the highest basic rate below the data rate.
+ *
+ * The model ignores the downlink, the A-MPDUs of several MPDUs and the interplay
+ * of the two links when they share an AC queue.
+ */
+class MloSurrogateModel
+{
+  public:
+    static constexpr std::size_t N_LINKS = 2;  //!< number of links
+    static constexpr double SLOT = 9e-6;       //!< slot time, seconds
+    static constexpr double SIFS = 16e-6;      //!< SIFS, seconds
+
+    /**
+     * Solve the model. The last solution is kept, and returned as is if the
+     * configuration did not change.
+     */
+    const std::array<MloSurrogateLinkStats, N_LINKS>& Solve(const MloSurrogateConfig& config);
+
+    /**
+     * Solve a link
+     * \param nSta number of STAs
+     * \param arrivalPr probability that a STA generates a pkt for this link in a slot
+     * \param payloadSize application payload size in bytes
+     * \param retryLimit retransmissions before a pkt is dropped, or
+     *        MloSurrogateConfig::UNLIMITED_RETRIES
+     * \param maxQueueSize size of the MAC queue of a STA, in pkts
+     * \param maxQueueDelay time after which a queued pkt is dropped, seconds
+     * \param duration observation time in seconds
+     * \param link configuration of the link
+     * \return the steady state of the link
+     */
+    static MloSurrogateLinkStats SolveLink(std::size_t nSta,
+                                           double arrivalPr,
+                                           uint32_t payloadSize,
+                                           uint32_t retryLimit,
+                                           uint32_t maxQueueSize,
+                                           double maxQueueDelay,
+                                           double duration,
+                                           const MloSurrogateLinkConfig& link);
+
+    /**
+     * Get the data rate of an EHT MCS, 1 spatial stream, 800 ns GI
+     * \param mcs the MCS (0 to 13)
+     * \param channelWidth the channel width in MHz (20 to 320)
+     * \return the data rate in bit/s
+     */
+    static double GetDataRate(int mcs, int channelWidth);
+
+    /**
+     * Get the duration of the PPDU of a data frame
+     * \param payloadSize application payload size in bytes
+     * \param mcs the MCS
+     * \param channelWidth the channel width in MHz
+     * \return the duration in seconds
+     */
+    static double GetDataTxDuration(uint32_t payloadSize, int mcs, int channelWidth);
+
+    /**
+     * Get the duration of the normal ack of a data frame
+     * \param mcs the MCS of the data frame
+     * \return the duration in seconds
+     */
+    static double GetAckTxDuration(int mcs);
+
+  private:
+    bool m_solved{false};                                  //!< whether m_stats is valid
+    MloSurrogateConfig m_config;                           //!< configuration of m_stats
+    std::array<MloSurrogateLinkStats, N_LINKS> m_stats;    //!< last solution
+};
+
+} // namespace ns3
+
+#endif // NS3_MLO_SURROGATE_MODEL_H
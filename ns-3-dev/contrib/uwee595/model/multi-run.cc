@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "multi-run.h"
+
+#include "ns3/abort.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MultiRun");
+
+namespace
+{
+
+uint32_t g_numConfigurations = 1; //!< configurations run by RunConfigurations
+
+} // namespace
+
+int
+RunConfigurations(int argc, char* argv[], const std::function<int(int, char*[])>& run)
+{
+    const std::string configsArg = "--configs=";
+    std::string configsFile;
+    std::vector<std::string> baseArgs;
+    for (int i = 0; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (i > 0 && arg.compare(0, configsArg.size(), configsArg) == 0)
+        {
+            configsFile = arg.substr(configsArg.size());
+        }
+        else
+        {
+            baseArgs.push_back(arg);
+        }
+    }
+    if (configsFile.empty())
+    {
+        g_numConfigurations = 1;
+        return run(argc, argv);
+    }
+
+    std::ifstream file;
+    if (configsFile != "-")
+    {
+        file.open(configsFile);
+        NS_ABORT_MSG_IF(!file.is_open(), "Cannot open " << configsFile);
+    }
+    std::istream& configs = (configsFile == "-") ? std::cin : file;
+
+    // read all the configurations first, for GetNumConfigurations
+    std::vector<std::pair<std::string, std::vector<std::string>>> runs;
+    std::string line;
+    while (std::getline(configs, line))
+    {
+        std::istringstream tokens(line);
+        std::vector<std::string> args = baseArgs;
+        std::string token;
+        if (!(tokens >> token) || token[0] == '#')
+        {
+            continue;
+        }
+        do
+        {
+            args.push_back(token);
+        } while (tokens >> token);
+        runs.emplace_back(line, args);
+    }
+    g_numConfigurations = runs.size();
+
+    int status = 0;
+    uint32_t numRuns = 0;
+    for (auto& [config, args] : runs)
+    {
+        // as in a new process
+        Config::Reset();
+        RngSeedManager::ResetNextStreamIndex();
+
+        NS_LOG_INFO("Configuration " << numRuns << ": " << config);
+        std::vector<char*> runArgv;
+        for (auto& arg : args)
+        {
+            runArgv.push_back(arg.data());
+        }
+        runArgv.push_back(nullptr);
+        int runStatus = run(static_cast<int>(args.size()), runArgv.data());
+        Simulator::Destroy();
+        // a configuration without this line did not complete, e.g. it aborted
+        std::cout << "RunConfigurations: configuration " << numRuns << " status " << runStatus
+                  << std::endl;
+        if (runStatus != 0 && status == 0)
+        {
+            status = runStatus;
+        }
+        numRuns++;
+    }
+    NS_LOG_INFO(numRuns << " configurations run");
+    return status;
+}
+
+uint32_t
+GetNumConfigurations()
+{
+    return g_numConfigurations;
+}
+
+} // namespace ns3
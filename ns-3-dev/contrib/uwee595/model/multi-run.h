@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NS3_MULTI_RUN_H
+#define NS3_MULTI_RUN_H
+
+#include <cstdint>
+#include <functional>
+
+namespace ns3
+{
+
+/**
+ * \brief Run a simulation program once per configuration of a list, in this process.
+ *
+ * Without a --configs=<file> argument, run is called once with the arguments of the
+ * program. Otherwise, each non-empty line of the file ('-': the standard input) not
+ * starting with '#' is a configuration: the program arguments of one run, separated
+ * by whitespace, e.g. "--nMldSta=8 --mldPerNodeLambda=0.001". run is called for each
+ * configuration with the arguments of the program, without --configs, followed by
+ * those of the configuration, which thus override them. Each run writes its results
+ * as a run in its own process would, e.g. appends its summary line. The file is
+ * read entirely before the first run.
+ *
+ * The runs start from the same state as a new process: the attribute defaults and
+ * global values are reset, and so is the numbering of the automatic random streams.
+ * The simulator is destroyed after each run, even if run returned early. A run
+ * that aborts ends the process, and the configurations after it are not run.
+ * After each run, the line "RunConfigurations: configuration <i> status <s>" is
+ * printed on the standard output, with i the index of the configuration in the
+ * file (from 0, not counting the empty and comment lines) and s the value returned
+ * by run, so that a configuration without this line did not complete.
+ *
+ * \param argc the number of arguments of the program
+ * \param argv the arguments of the program
+ * \param run the simulation, taking its arguments as main() does
+ * \return 0 if every run returned 0, else the first non-zero value returned
+ */
+int RunConfigurations(int argc,
+                      char* argv[],
+                      const std::function<int(int, char*[])>& run);
+
+/**
+ * Get the number of configurations of the last call to RunConfigurations, e.g. to
+ * reject the options that measure the whole process when it runs several of them
+ * \return the number of configurations, 1 without --configs
+ */
+uint32_t GetNumConfigurations();
+
+} // namespace ns3
+
+#endif // NS3_MULTI_RUN_H
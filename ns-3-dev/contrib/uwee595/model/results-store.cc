@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "results-store.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ResultsStore");
+
+namespace
+{
+
+const uint32_t RESULTS_STORE_VERSION = 1;
+const char RESULTS_STORE_MAGIC[8] = {'U', 'W', 'R', 'E', 'S', 'U', 'L', 'T'};
+
+std::size_t
+Align8(std::size_t size)
+{
+    return (size + 7) & ~static_cast<std::size_t>(7);
+}
+
+// the chunks start on a page boundary, so that they can be mapped
+uint32_t
+HeaderSize(std::size_t numColumns)
+{
+    std::size_t size = sizeof(ResultsStoreHeader) + numColumns * sizeof(ResultsStoreColumn);
+    return (size + 4095) & ~static_cast<std::size_t>(4095);
+}
+
+void
+WriteAll(int fd, const void* data, std::size_t size, off_t offset, const std::string& path)
+{
+    const char* p = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        ssize_t n = pwrite(fd, p, size, offset);
+        NS_ABORT_MSG_IF(n < 0 && errno != EINTR,
+                        "Cannot write " << path << ": " << std::strerror(errno));
+        if (n > 0)
+        {
+            p += n;
+            size -= n;
+            offset += n;
+        }
+    }
+}
+
+} // namespace
+
+ResultsStoreWriter::ResultsStoreWriter(const std::string& path, bool append, uint32_t chunkRows)
+    : m_path(path),
+      m_append(append),
+      m_chunkRows(chunkRows),
+      m_fd(-1),
+      m_next(0),
+      m_numRowsOpen(0),
+      m_numRowsBuffered(0)
+{
+    NS_ABORT_MSG_IF(chunkRows == 0, "A chunk must hold at least one row");
+    std::memset(&m_header, 0, sizeof(m_header));
+}
+
+ResultsStoreWriter::~ResultsStoreWriter()
+{
+    Close();
+}
+
+void
+ResultsStoreWriter::AddColumn(const std::string& name,
+                              const std::string& format,
+                              std::size_t elemSize)
+{
+    NS_ABORT_MSG_IF(name.size() >= sizeof(ResultsStoreColumn::name),
+                    "Column name " << name << " too long");
+    for (const auto& column : m_columns)
+    {
+        NS_ABORT_MSG_IF(column.name == name, "Column " << name << " defined twice");
+    }
+    m_columns.push_back({name, format, elemSize, {}});
+    m_columns.back().data.reserve(elemSize * m_chunkRows);
+}
+
+void
+ResultsStoreWriter::EndRow()
+{
+    NS_ABORT_MSG_IF(m_next != m_columns.size(),
+                    "Row with " << m_next << " of the " << m_columns.size() << " columns");
+    m_next = 0;
+    m_numRowsOpen++;
+    m_numRowsBuffered++;
+    if (m_numRowsBuffered == m_chunkRows)
+    {
+        Flush();
+    }
+}
+
+void
+ResultsStoreWriter::Open()
+{
+    NS_LOG_FUNCTION(this << m_path << m_append);
+    m_fd = open(m_path.c_str(), O_RDWR | O_CREAT | (m_append ? 0 : O_TRUNC), 0644);
+    NS_ABORT_MSG_IF(m_fd < 0, "Cannot open " << m_path << ": " << std::strerror(errno));
+
+    std::vector<ResultsStoreColumn> descr(m_columns.size());
+    for (std::size_t i = 0; i < m_columns.size(); ++i)
+    {
+        std::memset(&descr[i], 0, sizeof(descr[i]));
+        std::strncpy(descr[i].name, m_columns[i].name.c_str(), sizeof(descr[i].name) - 1);
+        std::strncpy(descr[i].format, m_columns[i].format.c_str(), sizeof(descr[i].format) - 1);
+    }
+    std::memcpy(m_header.magic, RESULTS_STORE_MAGIC, sizeof(m_header.magic));
+    m_header.version = RESULTS_STORE_VERSION;
+    m_header.headerSize = HeaderSize(m_columns.size());
+    m_header.numColumns = m_columns.size();
+    m_header.numRows = 0;
+    m_header.numChunks = 0;
+    m_header.endOffset = m_header.headerSize;
+
+    struct stat st;
+    NS_ABORT_MSG_IF(fstat(m_fd, &st) != 0, "Cannot stat " << m_path << ": " << std::strerror(errno));
+    if (st.st_size > 0)
+    {
+        ResultsStoreHeader existing;
+        std::vector<ResultsStoreColumn> existingDescr(m_columns.size());
+        std::size_t descrSize = existingDescr.size() * sizeof(ResultsStoreColumn);
+        NS_ABORT_MSG_IF(pread(m_fd, &existing, sizeof(existing), 0) !=
+                                static_cast<ssize_t>(sizeof(existing)) ||
+                            std::memcmp(existing.magic, m_header.magic, sizeof(m_header.magic)) !=
+                                0 ||
+                            existing.version != m_header.version ||
+                            existing.numColumns != m_header.numColumns ||
+                            pread(m_fd, existingDescr.data(), descrSize, sizeof(existing)) !=
+                                static_cast<ssize_t>(descrSize) ||
+                            std::memcmp(existingDescr.data(), descr.data(), descrSize) != 0,
+                        "Cannot append to " << m_path << ": not a results file with these columns");
+        // drop whatever an interrupted writer left after the last chunk
+        m_header = existing;
+        NS_ABORT_MSG_IF(ftruncate(m_fd, m_header.endOffset) != 0,
+                        "Cannot truncate " << m_path << ": " << std::strerror(errno));
+        NS_LOG_DEBUG("Appending to " << m_path << " after " << m_header.numRows << " rows");
+        return;
+    }
+    std::vector<char> header(m_header.headerSize, 0);
+    std::memcpy(header.data(), &m_header, sizeof(m_header));
+    std::memcpy(header.data() + sizeof(m_header), descr.data(), descr.size() * sizeof(descr[0]));
+    WriteAll(m_fd, header.data(), header.size(), 0, m_path);
+}
+
+void
+ResultsStoreWriter::Flush()
+{
+    NS_LOG_FUNCTION(this << m_numRowsBuffered);
+    if (m_numRowsBuffered == 0)
+    {
+        return;
+    }
+    if (m_fd < 0)
+    {
+        Open();
+    }
+
+    ResultsStoreChunk chunk;
+    chunk.numRows = m_numRowsBuffered;
+    chunk.chunkSize = sizeof(chunk);
+    for (const auto& column : m_columns)
+    {
+        chunk.chunkSize += Align8(column.data.size());
+    }
+    m_chunk.assign(chunk.chunkSize, 0);
+    std::memcpy(m_chunk.data(), &chunk, sizeof(chunk));
+    std::size_t offset = sizeof(chunk);
+    for (auto& column : m_columns)
+    {
+        std::memcpy(m_chunk.data() + offset, column.data.data(), column.data.size());
+        offset += Align8(column.data.size());
+        column.data.clear();
+    }
+    WriteAll(m_fd, m_chunk.data(), m_chunk.size(), m_header.endOffset, m_path);
+
+    // publish the chunk once it is written
+    m_header.numRows += m_numRowsBuffered;
+    m_header.numChunks++;
+    m_header.endOffset += chunk.chunkSize;
+    WriteAll(m_fd, &m_header, sizeof(m_header), 0, m_path);
+    m_numRowsBuffered = 0;
+}
+
+void
+ResultsStoreWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+        NS_LOG_DEBUG("Results file closed with " << m_header.numRows << " rows");
+    }
+}
+
+ResultsStoreReader::ResultsStoreReader(const std::string& path)
+    : m_map(nullptr),
+      m_mapSize(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    NS_ABORT_MSG_IF(fd < 0, "Cannot open " << path << ": " << std::strerror(errno));
+    struct stat st;
+    NS_ABORT_MSG_IF(fstat(fd, &st) != 0 ||
+                        static_cast<std::size_t>(st.st_size) < sizeof(ResultsStoreHeader),
+                    path << " is not a results file");
+    m_mapSize = st.st_size;
+    void* map = mmap(nullptr, m_mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    NS_ABORT_MSG_IF(map == MAP_FAILED, "Cannot map " << path << ": " << std::strerror(errno));
+    m_map = static_cast<const char*>(map);
+
+    std::memcpy(&m_header, m_map, sizeof(m_header));
+    NS_ABORT_MSG_IF(std::memcmp(m_header.magic, RESULTS_STORE_MAGIC, sizeof(m_header.magic)) != 0 ||
+                        m_header.version != RESULTS_STORE_VERSION ||
+                        m_header.endOffset > m_mapSize,
+                    path << " is not a results file");
+    m_columns.resize(m_header.numColumns);
+    std::memcpy(m_columns.data(),
+                m_map + sizeof(m_header),
+                m_columns.size() * sizeof(ResultsStoreColumn));
+    std::size_t offset = m_header.headerSize;
+    for (uint64_t i = 0; i < m_header.numChunks; ++i)
+    {
+        m_chunkOffsets.push_back(offset);
+        ResultsStoreChunk chunk;
+        std::memcpy(&chunk, m_map + offset, sizeof(chunk));
+        offset += chunk.chunkSize;
+    }
+}
+
+ResultsStoreReader::~ResultsStoreReader()
+{
+    munmap(const_cast<char*>(m_map), m_mapSize);
+}
+
+uint64_t
+ResultsStoreReader::GetNumRows() const
+{
+    return m_header.numRows;
+}
+
+std::vector<std::string>
+ResultsStoreReader::GetColumnNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& column : m_columns)
+    {
+        names.emplace_back(column.name);
+    }
+    return names;
+}
+
+std::string
+ResultsStoreReader::GetColumnFormat(const std::string& name) const
+{
+    return m_columns[FindColumn(name, "")].format;
+}
+
+std::size_t
+ResultsStoreReader::FindColumn(const std::string& name, const std::string& format) const
+{
+    for (std::size_t i = 0; i < m_columns.size(); ++i)
+    {
+        if (name == m_columns[i].name)
+        {
+            NS_ABORT_MSG_IF(!format.empty() && format != m_columns[i].format,
+                            "Column " << name << " has format " << m_columns[i].format
+                                      << ", not " << format);
+            return i;
+        }
+    }
+    NS_ABORT_MSG("No column " << name);
+    return 0;
+}
+
+void
+ResultsStoreReader::ReadColumn(std::size_t column, void* values, std::size_t elemSize) const
+{
+    char* out = static_cast<char*>(values);
+    for (auto offset : m_chunkOffsets)
+    {
+        ResultsStoreChunk chunk;
+        std::memcpy(&chunk, m_map + offset, sizeof(chunk));
+        // skip the previous columns of the chunk
+        std::size_t data = offset + sizeof(chunk);
+        for (std::size_t i = 0; i < column; ++i)
+        {
+            std::string format = m_columns[i].format;
+            data += Align8(chunk.numRows * std::stoul(format.substr(2)));
+        }
+        std::memcpy(out, m_map + data, chunk.numRows * elemSize);
+        out += chunk.numRows * elemSize;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NS3_RESULTS_STORE_H
+#define NS3_RESULTS_STORE_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Header at the start of a results file.
+ *
+ * The header is followed by numColumns ResultsStoreColumn, then by the
+ * chunks from headerSize on. A chunk starts with a ResultsStoreChunk, then
+ * holds each column in turn: numRows values, padded to 8 bytes. numRows,
+ * numChunks and endOffset only count complete chunks, so the file can be
+ * read while it grows, and anything after endOffset is ignored.
+ */
+struct ResultsStoreHeader
+{
+    char magic[8];        //!< "UWRESULT"
+    uint32_t version;     //!< file format version
+    uint32_t headerSize;  //!< offset of the first chunk
+    uint32_t numColumns;  //!< number of columns
+    uint32_t reserved;    //!< padding, zero
+    uint64_t numRows;     //!< number of rows in the file
+    uint64_t numChunks;   //!< number of chunks in the file
+    uint64_t endOffset;   //!< end of the last chunk
+};
+
+/**
+ * \brief Description of a column of a results file
+ */
+struct ResultsStoreColumn
+{
+    char name[56];   //!< column name
+    char format[8];  //!< NumPy dtype string, e.g. "<f8"
+};
+
+/**
+ * \brief Header of a chunk of rows
+ */
+struct ResultsStoreChunk
+{
+    uint64_t numRows;    //!< number of rows in the chunk
+    uint64_t chunkSize;  //!< size of the chunk, including this header
+};
+
+/**
+ * \brief Appendable columnar file of typed results, e.g. one row per run or per step.
+ *
+ * The columns are defined by the first row: Append(name, value) for each
+ * column, then EndRow(). Later rows append the same columns in the same
+ * order. The rows are buffered per column and written as one chunk every
+ * chunkRows rows, and when the store is closed; rows that are not written
+ * yet are lost if the program does not close the store. Appending to an
+ * existing file requires the same columns.
+ *
+ * See results_store.py for the NumPy reader and ResultsStoreReader for C++.
+ */
+class ResultsStoreWriter
+{
+  public:
+    /**
+     * \param path the results file
+     * \param append keep the rows of an existing file, instead of truncating it
+     * \param chunkRows number of rows written at once
+     */
+    ResultsStoreWriter(const std::string& path, bool append = true, uint32_t chunkRows = 4096);
+    ~ResultsStoreWriter();
+
+    /**
+     * Set the value of the next column of the current row
+     */
+    template <typename T>
+    void Append(const std::string& name, T value)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Only arithmetic values can be stored");
+        if (m_numRowsOpen == 0 && m_columns.size() == m_next)
+        {
+            // first row: define the column
+            AddColumn(name, NumpyFormat<T>(), sizeof(T));
+        }
+        NS_ASSERT_MSG(m_next < m_columns.size() && m_columns[m_next].name == name &&
+                          m_columns[m_next].elemSize == sizeof(T),
+                      "Column " << name << " does not match the columns of the first row");
+        auto& data = m_columns[m_next++].data;
+        std::size_t size = data.size();
+        data.resize(size + sizeof(T));
+        std::memcpy(data.data() + size, &value, sizeof(T));
+    }
+
+    /**
+     * Complete the current row
+     */
+    void EndRow();
+
+    /**
+     * Write the buffered rows as a chunk
+     */
+    void Flush();
+
+    /**
+     * Write the buffered rows and close the file
+     */
+    void Close();
+
+    /**
+     * Get the NumPy dtype string of an arithmetic type, e.g. "<f8" for double
+     */
+    template <typename T>
+    static std::string NumpyFormat()
+    {
+        std::string kind = std::is_same_v<T, bool>        ? "b"
+                           : std::is_floating_point_v<T> ? "f"
+                           : std::is_signed_v<T>         ? "i"
+                                                         : "u";
+        return (sizeof(T) == 1 ? "|" : "<") + kind + std::to_string(sizeof(T));
+    }
+
+  private:
+    struct Column
+    {
+        std::string name;        //!< column name
+        std::string format;      //!< NumPy dtype string
+        std::size_t elemSize;    //!< size of a value
+        std::vector<char> data;  //!< buffered values
+    };
+
+    void AddColumn(const std::string& name, const std::string& format, std::size_t elemSize);
+
+    /**
+     * Open the file once the columns are known
+     */
+    void Open();
+
+    std::string m_path;              //!< results file
+    bool m_append;                   //!< keep the rows of an existing file
+    uint32_t m_chunkRows;            //!< rows in a full chunk
+    int m_fd;                        //!< file descriptor, -1 until the first row
+    std::vector<Column> m_columns;   //!< columns and their buffered values
+    std::size_t m_next;              //!< next column of the current row
+    uint64_t m_numRowsOpen;          //!< rows completed since the writer was created
+    uint64_t m_numRowsBuffered;      //!< completed rows not written yet
+    ResultsStoreHeader m_header;     //!< header, as last written
+    std::vector<char> m_chunk;       //!< scratch buffer of a chunk
+};
+
+/**
+ * \brief Reader of the files written by ResultsStoreWriter
+ */
+class ResultsStoreReader
+{
+  public:
+    /**
+     * Read the header, the column descriptions and the chunk layout of a file
+     */
+    explicit ResultsStoreReader(const std::string& path);
+    ~ResultsStoreReader();
+
+    /**
+     * Get the number of rows
+     */
+    uint64_t GetNumRows() const;
+
+    /**
+     * Get the column names, in file order
+     */
+    std::vector<std::string> GetColumnNames() const;
+
+    /**
+     * Get the NumPy dtype string of a column
+     */
+    std::string GetColumnFormat(const std::string& name) const;
+
+    /**
+     * Read all the values of a column, which must be of type T
+     */
+    template <typename T>
+    std::vector<T> ReadColumn(const std::string& name) const
+    {
+        std::size_t column = FindColumn(name, ResultsStoreWriter::NumpyFormat<T>());
+        std::vector<T> values(m_header.numRows);
+        ReadColumn(column, values.data(), sizeof(T));
+        return values;
+    }
+
+  private:
+    std::size_t FindColumn(const std::string& name, const std::string& format) const;
+    void ReadColumn(std::size_t column, void* values, std::size_t elemSize) const;
+
+    const char* m_map;                          //!< mapping of the whole file
+    std::size_t m_mapSize;                      //!< size of the mapping
+    ResultsStoreHeader m_header;                //!< header
+    std::vector<ResultsStoreColumn> m_columns;  //!< column descriptions
+    std::vector<std::size_t> m_chunkOffsets;    //!< offset of each chunk
+};
+
+} // namespace ns3
+
+#endif // NS3_RESULTS_STORE_H
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "step-cache.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("StepCache");
+
+namespace
+{
+
+const char STEP_CACHE_MAGIC[8] = {'U', 'W', 'S', 'T', 'E', 'P', 'C', '1'};
+
+// FNV-1a, then the finalizer of splitmix64 to spread the bits
+uint64_t
+HashLane(const std::string& data, uint64_t basis)
+{
+    uint64_t h = basis;
+    for (unsigned char c : data)
+    {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    h ^= data.size();
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+void
+MakeDir(const std::string& dir)
+{
+    NS_ABORT_MSG_IF(mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST,
+                    "Cannot create " << dir << ": " << std::strerror(errno));
+}
+
+bool
+ReadAll(int fd, void* data, std::size_t size)
+{
+    char* p = static_cast<char*>(data);
+    while (size > 0)
+    {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool
+WriteAll(int fd, const void* data, std::size_t size)
+{
+    const char* p = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+} // namespace
+
+StepCache::StepCache(const std::string& dir)
+    : m_dir(dir)
+{
+    NS_ABORT_MSG_IF(dir.empty(), "The cache needs a directory");
+    MakeDir(m_dir);
+}
+
+std::string
+StepCache::Hash(const std::string& data)
+{
+    char hex[33];
+    std::snprintf(hex,
+                  sizeof(hex),
+                  "%016llx%016llx",
+                  static_cast<unsigned long long>(HashLane(data, 0xcbf29ce484222325ULL)),
+                  static_cast<unsigned long long>(HashLane(data, 0x84222325cbf29ce4ULL)));
+    return hex;
+}
+
+std::string
+StepCache::GetPath(const std::string& hash) const
+{
+    return m_dir + "/" + hash.substr(0, 2) + "/" + hash.substr(2);
+}
+
+bool
+StepCache::Lookup(const std::string& key, void* value, std::size_t size)
+{
+    std::string path = GetPath(Hash(key));
+    int fd = open(path.c_str(), O_RDONLY);
+    bool hit = false;
+    if (fd >= 0)
+    {
+        StepCacheEntryHeader header;
+        std::string storedKey;
+        if (ReadAll(fd, &header, sizeof(header)) &&
+            std::memcmp(header.magic, STEP_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+            header.keySize == key.size() && header.valueSize == size)
+        {
+            storedKey.resize(header.keySize);
+            hit = ReadAll(fd, storedKey.data(), storedKey.size()) && storedKey == key &&
+                  ReadAll(fd, value, size);
+        }
+        close(fd);
+    }
+    (hit ? m_numHits : m_numMisses)++;
+    NS_LOG_DEBUG((hit ? "Hit " : "Miss ") << path);
+    return hit;
+}
+
+void
+StepCache::Store(const std::string& key, const void* value, std::size_t size)
+{
+    std::string hash = Hash(key);
+    MakeDir(m_dir + "/" + hash.substr(0, 2));
+    std::string path = GetPath(hash);
+    // unique among the processes sharing the cache
+    std::string tmpPath =
+        path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(m_numStored++);
+
+    StepCacheEntryHeader header;
+    std::memcpy(header.magic, STEP_CACHE_MAGIC, sizeof(header.magic));
+    header.keySize = key.size();
+    header.valueSize = size;
+    std::vector<char> entry(sizeof(header) + key.size() + size);
+    std::memcpy(entry.data(), &header, sizeof(header));
+    std::memcpy(entry.data() + sizeof(header), key.data(), key.size());
+    std::memcpy(entry.data() + sizeof(header) + key.size(), value, size);
+
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    bool written = fd >= 0 && WriteAll(fd, entry.data(), entry.size());
+    if (fd >= 0)
+    {
+        written = (close(fd) == 0) && written;
+    }
+    // the entry appears complete, or not at all
+    if (!written || rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        NS_LOG_WARN("Cannot store " << path << ": " << std::strerror(errno));
+        unlink(tmpPath.c_str());
+        return;
+    }
+    NS_LOG_DEBUG("Stored " << path);
+}
+
+uint64_t
+StepCache::GetNumHits() const
+{
+    return m_numHits;
+}
+
+uint64_t
+StepCache::GetNumMisses() const
+{
+    return m_numMisses;
+}
+
+} // namespace ns3
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NS3_STEP_CACHE_H
+#define NS3_STEP_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace ns3
+{
+
+/**
+ * \brief Header of an entry of a StepCache
+ */
+struct StepCacheEntryHeader
+{
+    char magic[8];       //!< "UWSTEPC1"
+    uint32_t keySize;    //!< size of the key, which follows the header
+    uint32_t valueSize;  //!< size of the value, which follows the key
+};
+
+/**
+ * \brief On-disk, content-addressed cache of fixed-size values, e.g. the statistics of
+ * a simulation step for a given scenario, seed and action history.
+ *
+ * Each entry is a file named after the hash of its key, in a subdirectory named after
+ * the first two digits of the hash. The file also holds the key, which is compared on
+ * lookup, so that a hash collision is a miss. Entries are written to a temporary file
+ * then renamed, so that concurrent processes can share a cache directory without
+ * locks: a reader finds either no entry or a complete one, and the writers of a key
+ * write the same value.
+ *
+ * The key must describe everything the value depends on; the cache cannot tell when
+ * the code producing the values changed, so its directory must then be emptied.
+ */
+class StepCache
+{
+  public:
+    /**
+     * \param dir directory of the cache, created if needed
+     */
+    explicit StepCache(const std::string& dir);
+
+    /**
+     * Look up the value of a key
+     * \param key the key
+     * \param value the value, set on a hit
+     * \param size the size of the value
+     * \return whether the key has a value of this size
+     */
+    bool Lookup(const std::string& key, void* value, std::size_t size);
+
+    /**
+     * Store the value of a key. A failure to write is logged and ignored.
+     * \param key the key
+     * \param value the value
+     * \param size the size of the value
+     */
+    void Store(const std::string& key, const void* value, std::size_t size);
+
+    /**
+     * Look up a trivially copyable value
+     */
+    template <typename T>
+    bool Lookup(const std::string& key, T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be cached");
+        return Lookup(key, &value, sizeof(T));
+    }
+
+    /**
+     * Store a trivially copyable value
+     */
+    template <typename T>
+    void Store(const std::string& key, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be cached");
+        Store(key, &value, sizeof(T));
+    }
+
+    /**
+     * Get a 128-bit hash of some data, as 32 hex digits. Not cryptographic.
+     */
+    static std::string Hash(const std::string& data);
+
+    /**
+     * Get the number of lookups that found a value
+     */
+    uint64_t GetNumHits() const;
+
+    /**
+     * Get the number of lookups that found no value
+     */
+    uint64_t GetNumMisses() const;
+
+  private:
+    /**
+     * Get the path of the entry of a key hash
+     */
+    std::string GetPath(const std::string& hash) const;
+
+    std::string m_dir;          //!< directory of the cache
+    uint64_t m_numHits{0};      //!< lookups that found a value
+    uint64_t m_numMisses{0};    //!< lookups that found no value
+    uint64_t m_numStored{0};    //!< entries stored, to name the temporary files
+};
+
+} // namespace ns3
+
+#endif // NS3_STEP_CACHE_H
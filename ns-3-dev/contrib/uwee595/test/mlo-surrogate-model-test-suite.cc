@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/mlo-surrogate-model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace ns3;
+
+class MloSurrogateTxDurations : public TestCase
+{
+public:
+  MloSurrogateTxDurations ();
+  virtual ~MloSurrogateTxDurations ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MloSurrogateTxDurations::MloSurrogateTxDurations ()
+  : TestCase ("Check the PPDU durations of the MloSurrogateModel")
+{
+}
+
+MloSurrogateTxDurations::~MloSurrogateTxDurations ()
+{
+}
+
+void
+MloSurrogateTxDurations::DoRun (void)
+{
+  // EHT MCS 6, 20 MHz: 234 x 4.5 = 1053 bits per 13.6 us symbol
+  double valueToCheck = MloSurrogateModel::GetDataRate (6, 20);
+  NS_TEST_ASSERT_MSG_EQ_TOL (valueToCheck, 77.426e6, 1e3, "Numbers are not equal within tolerance");
+  // 1500 B payload: 22 + 8 x 1542 = 12358 bits in 12 symbols, after a 48 us preamble
+  valueToCheck = MloSurrogateModel::GetDataTxDuration (1500, 6, 20);
+  NS_TEST_ASSERT_MSG_EQ_TOL (valueToCheck, 211.2e-6, 1e-9, "Numbers are not equal within tolerance");
+  // MCS 0, 20 MHz: 117 bits per symbol, 106 symbols
+  valueToCheck = MloSurrogateModel::GetDataTxDuration (1500, 0, 20);
+  NS_TEST_ASSERT_MSG_EQ_TOL (valueToCheck, 1489.6e-6, 1e-9, "Numbers are not equal within tolerance");
+  // MCS 11, 80 MHz: 8166.7 bits per symbol, 2 symbols
+  valueToCheck = MloSurrogateModel::GetDataTxDuration (1500, 11, 80);
+  NS_TEST_ASSERT_MSG_EQ_TOL (valueToCheck, 75.2e-6, 1e-9, "Numbers are not equal within tolerance");
+
+  // normal ack (14 B) at the highest basic rate below the MCS: 44, 32 and 28 us
+  valueToCheck = MloSurrogateModel::GetAckTxDuration (0);
+  NS_TEST_ASSERT_MSG_EQ_TOL (valueToCheck, 44e-6, 1e-9, "Numbers are not equal within tolerance");
+  valueToCheck = MloSurrogateModel::GetAckTxDuration (2);
+  NS_TEST_ASSERT_MSG_EQ_TOL (valueToCheck, 32e-6, 1e-9, "Numbers are not equal within tolerance");
+  valueToCheck = MloSurrogateModel::GetAckTxDuration (6);
+  NS_TEST_ASSERT_MSG_EQ_TOL (valueToCheck, 28e-6, 1e-9, "Numbers are not equal within tolerance");
+}
+
+class MloSurrogateSaturatedFixedPoint : public TestCase
+{
+public:
+  MloSurrogateSaturatedFixedPoint ();
+  virtual ~MloSurrogateSaturatedFixedPoint ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Saturated attempt probability of Bianchi's model with a retry limit
+   * \param p the collision probability
+   * \param link the contention window of the link
+   * \param retryLimit the retransmissions before a pkt is dropped
+   * \return the probability that a STA transmits in a slot
+   */
+  static double GetSaturatedTau (double p, const MloSurrogateLinkConfig &link, uint32_t retryLimit);
+  /**
+   * Solve the saturated fixed point by bisection
+   * \param nSta the number of STAs
+   * \param link the contention window of the link
+   * \param retryLimit the retransmissions before a pkt is dropped
+   * \return the probability that a STA transmits in a slot
+   */
+  static double SolveSaturatedTau (std::size_t nSta, const MloSurrogateLinkConfig &link,
+                                   uint32_t retryLimit);
+};
+
+MloSurrogateSaturatedFixedPoint::MloSurrogateSaturatedFixedPoint ()
+  : TestCase ("Check the saturated Bianchi fixed point of the MloSurrogateModel")
+{
+}
+
+MloSurrogateSaturatedFixedPoint::~MloSurrogateSaturatedFixedPoint ()
+{
+}
+
+double
+MloSurrogateSaturatedFixedPoint::GetSaturatedTau (double p, const MloSurrogateLinkConfig &link,
+                                                  uint32_t retryLimit)
+{
+  // attempts per pkt over attempts plus mean backoff slots per pkt
+  double attempts = 0;
+  double backoffSlots = 0;
+  double reachPr = 1;
+  for (uint32_t i = 0; i <= retryLimit; ++i)
+    {
+      double cw = link.m_cwmin * std::pow (2.0, std::min<uint32_t> (i, link.m_cwStage));
+      attempts += reachPr;
+      backoffSlots += reachPr * (cw - 1) / 2;
+      reachPr *= p;
+    }
+  return attempts / (attempts + backoffSlots);
+}
+
+double
+MloSurrogateSaturatedFixedPoint::SolveSaturatedTau (std::size_t nSta, const MloSurrogateLinkConfig &link,
+                                                    uint32_t retryLimit)
+{
+  // tau = tau_sat (1 - (1 - tau)^(n - 1)): the right side decreases with tau
+  double low = 0;
+  double high = 1;
+  for (int i = 0; i < 100; ++i)
+    {
+      double tau = (low + high) / 2;
+      double p = 1 - std::pow (1 - tau, nSta - 1);
+      (GetSaturatedTau (p, link, retryLimit) > tau ? low : high) = tau;
+    }
+  return (low + high) / 2;
+}
+
+void
+MloSurrogateSaturatedFixedPoint::DoRun (void)
+{
+  MloSurrogateLinkConfig link;
+  link.m_cwmin = 16;
+  link.m_cwStage = 6;
+  uint32_t retryLimit = 7;
+
+  for (std::size_t nSta : {2, 3, 5})
+    {
+      double tau = SolveSaturatedTau (nSta, link, retryLimit);
+      double p = 1 - std::pow (1 - tau, nSta - 1);
+
+      // a pkt per slot saturates the STAs
+      MloSurrogateLinkStats stats =
+        MloSurrogateModel::SolveLink (nSta, 1, 1500, retryLimit, 500, 0.5, 1, link);
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (stats.m_utilization, 1, "The STAs should be saturated");
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_attemptPr, tau, 1e-7, "Numbers are not equal within tolerance");
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_collisionPr, p, 1e-7, "Numbers are not equal within tolerance");
+    }
+
+  // n = 3, CWmin 16, 6 stages, 7 retries
+  MloSurrogateLinkStats stats = MloSurrogateModel::SolveLink (3, 1, 1500, retryLimit, 500, 0.5, 1, link);
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_attemptPr, 0.0933933, 1e-6, "Numbers are not equal within tolerance");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_collisionPr, 0.1780644, 1e-6, "Numbers are not equal within tolerance");
+
+  // persistent retransmissions: the stages after the last doubling keep CWmax, and no
+  // pkt is dropped, so that 1 - p of the attempts succeed
+  for (std::size_t nSta : {3, 20})
+    {
+      double tau = SolveSaturatedTau (nSta, link, 5000);
+      double p = 1 - std::pow (1 - tau, nSta - 1);
+      stats = MloSurrogateModel::SolveLink (nSta, 1, 1500, MloSurrogateConfig::UNLIMITED_RETRIES,
+                                            std::numeric_limits<uint32_t>::max (), 0.5, 1, link);
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_attemptPr, tau, 1e-7, "Numbers are not equal within tolerance");
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_collisionPr, p, 1e-7, "Numbers are not equal within tolerance");
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_succPr, 1 - p, 1e-7, "Numbers are not equal within tolerance");
+    }
+}
+
+class MloSurrogateIdleLink : public TestCase
+{
+public:
+  MloSurrogateIdleLink ();
+  virtual ~MloSurrogateIdleLink ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MloSurrogateIdleLink::MloSurrogateIdleLink ()
+  : TestCase ("Check the MloSurrogateModel links without traffic")
+{
+}
+
+MloSurrogateIdleLink::~MloSurrogateIdleLink ()
+{
+}
+
+void
+MloSurrogateIdleLink::DoRun (void)
+{
+  MloSurrogateLinkConfig link;
+  // no STA
+  MloSurrogateLinkStats stats = MloSurrogateModel::SolveLink (0, 1e-3, 1500, 7, 500, 0.5, 1, link);
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_succPr, 1, 1e-12, "Numbers are not equal within tolerance");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_successRate, 0, 1e-12, "Numbers are not equal within tolerance");
+  // no arrival
+  stats = MloSurrogateModel::SolveLink (5, 0, 1500, 7, 500, 0.5, 1, link);
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_succPr, 1, 1e-12, "Numbers are not equal within tolerance");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_successRate, 0, 1e-12, "Numbers are not equal within tolerance");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.m_attemptPr, 0, 1e-12, "Numbers are not equal within tolerance");
+
+  // all the pkts on link 1: link 2 is idle
+  MloSurrogateModel model;
+  MloSurrogateConfig config;
+  config.m_mldProbLink1 = 1;
+  const auto &links = model.Solve (config);
+  NS_TEST_ASSERT_MSG_GT (links[0].m_successRate, 0, "Link 1 should carry the traffic");
+  NS_TEST_ASSERT_MSG_EQ_TOL (links[1].m_succPr, 1, 1e-12, "Numbers are not equal within tolerance");
+  NS_TEST_ASSERT_MSG_EQ_TOL (links[1].m_successRate, 0, 1e-12, "Numbers are not equal within tolerance");
+}
+
+class MloSurrogateModelTestSuite : public TestSuite
+{
+public:
+  MloSurrogateModelTestSuite ();
+};
+
+MloSurrogateModelTestSuite::MloSurrogateModelTestSuite ()
+  : TestSuite ("mlo-surrogate-model", UNIT)
+{
+  AddTestCase (new MloSurrogateTxDurations, TestCase::QUICK);
+  AddTestCase (new MloSurrogateSaturatedFixedPoint, TestCase::QUICK);
+  AddTestCase (new MloSurrogateIdleLink, TestCase::QUICK);
+}
+
+static MloSurrogateModelTestSuite mloSurrogateModelTestSuite;
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/results-store.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sys/wait.h>
+
+using namespace ns3;
+
+namespace
+{
+
+// rows written in chunks of 2: 2, 2 and 1 rows, then 2 rows by a second writer
+const uint32_t NUM_ROWS = 5;
+const uint32_t NUM_APPENDED_ROWS = 2;
+
+void
+WriteRows (ResultsStoreWriter &writer, uint32_t first, uint32_t numRows)
+{
+  for (uint32_t i = first; i < first + numRows; ++i)
+    {
+      writer.Append ("step", i);
+      writer.Append ("thpt", 0.5 * i);
+      writer.Append ("delta", -static_cast<int64_t> (i) * 1000000000000LL);
+      writer.Append ("done", i % 2 == 1);
+      writer.EndRow ();
+    }
+}
+
+} // namespace
+
+class ResultsStoreRoundTrip : public TestCase
+{
+public:
+  ResultsStoreRoundTrip ();
+  virtual ~ResultsStoreRoundTrip ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ResultsStoreRoundTrip::ResultsStoreRoundTrip ()
+  : TestCase ("Check that the rows written by ResultsStoreWriter are read back")
+{
+}
+
+ResultsStoreRoundTrip::~ResultsStoreRoundTrip ()
+{
+}
+
+void
+ResultsStoreRoundTrip::DoRun (void)
+{
+  std::string path = CreateTempDirFilename ("results-store-test.bin");
+  {
+    ResultsStoreWriter writer (path, false, 2);
+    WriteRows (writer, 0, NUM_ROWS);
+  }
+  {
+    // more rows, appended to the same columns
+    ResultsStoreWriter writer (path, true, 2);
+    WriteRows (writer, NUM_ROWS, NUM_APPENDED_ROWS);
+  }
+
+  ResultsStoreReader reader (path);
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNumRows (), NUM_ROWS + NUM_APPENDED_ROWS, "Wrong number of rows");
+  std::vector<std::string> names = reader.GetColumnNames ();
+  NS_TEST_ASSERT_MSG_EQ (names.size (), 4, "Wrong number of columns");
+  NS_TEST_ASSERT_MSG_EQ (names[0], "step", "Columns not in the order of the first row");
+  NS_TEST_ASSERT_MSG_EQ (names[3], "done", "Columns not in the order of the first row");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetColumnFormat ("step"), "<u4", "Wrong NumPy format");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetColumnFormat ("thpt"), "<f8", "Wrong NumPy format");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetColumnFormat ("delta"), "<i8", "Wrong NumPy format");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetColumnFormat ("done"), "|b1", "Wrong NumPy format");
+
+  std::vector<uint32_t> step = reader.ReadColumn<uint32_t> ("step");
+  std::vector<double> thpt = reader.ReadColumn<double> ("thpt");
+  std::vector<int64_t> delta = reader.ReadColumn<int64_t> ("delta");
+  // bool columns are checked by results_store.py: there is no std::vector<bool>::data ()
+  for (uint32_t i = 0; i < NUM_ROWS + NUM_APPENDED_ROWS; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (step[i], i, "Wrong value in row " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (thpt[i], 0.5 * i, 1e-12, "Wrong value in row " << i);
+      NS_TEST_ASSERT_MSG_EQ (delta[i], -static_cast<int64_t> (i) * 1000000000000LL, "Wrong value in row " << i);
+    }
+
+  // the same values through results_store.py, when Python and NumPy are available
+  std::string utils = std::string (NS_TEST_SOURCEDIR) + "/../experiments/utils";
+  if (WEXITSTATUS (std::system ("python3 -c 'import numpy' > /dev/null 2>&1")) != 0)
+    {
+      std::remove (path.c_str ());
+      return;
+    }
+  std::string script =
+    "import sys; sys.path.insert(0, '" + utils + "'); "
+    "from results_store import load_results, read_header; "
+    "n = " + std::to_string (NUM_ROWS + NUM_APPENDED_ROWS) + "; "
+    "r = load_results('" + path + "'); "
+    "h = read_header('" + path + "'); "
+    "ok = (h['numRows'] == n and h['numChunks'] == 4 and "
+    "list(r) == ['step', 'thpt', 'delta', 'done'] and "
+    "r['step'].dtype.str == '<u4' and r['done'].dtype.str == '|b1' and "
+    "r['step'].tolist() == list(range(n)) and "
+    "r['thpt'].tolist() == [0.5 * i for i in range(n)] and "
+    "r['delta'].tolist() == [-i * 10**12 for i in range(n)] and "
+    "r['done'].tolist() == [i % 2 == 1 for i in range(n)] and "
+    "load_results('" + path + "', ['thpt']).keys() == {'thpt'}); "
+    "sys.exit(0 if ok else 1)";
+  int status = std::system (("python3 -c \"" + script + "\"").c_str ());
+  std::remove (path.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (WEXITSTATUS (status), 0, "results_store.py does not read the values written");
+}
+
+class ResultsStoreTestSuite : public TestSuite
+{
+public:
+  ResultsStoreTestSuite ();
+};
+
+ResultsStoreTestSuite::ResultsStoreTestSuite ()
+  : TestSuite ("results-store", UNIT)
+{
+  AddTestCase (new ResultsStoreRoundTrip, TestCase::QUICK);
+}
+
+static ResultsStoreTestSuite resultsStoreTestSuite;
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/step-cache.h"
+
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ns3;
+
+namespace
+{
+
+// value of a step, as cached by the experiments
+struct StepStats
+{
+  uint32_t numPkts;
+  double thpt;
+  double delay;
+};
+
+} // namespace
+
+class StepCacheHitMiss : public TestCase
+{
+public:
+  StepCacheHitMiss ();
+  virtual ~StepCacheHitMiss ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Get the path of the entry of a key
+   * \param dir the directory of the cache
+   * \param key the key
+   * \return the path of the entry file
+   */
+  static std::string GetEntryPath (const std::string &dir, const std::string &key);
+  /**
+   * Remove the entry of a key, and its subdirectory if it is empty
+   * \param dir the directory of the cache
+   * \param key the key
+   */
+  static void RemoveEntry (const std::string &dir, const std::string &key);
+};
+
+StepCacheHitMiss::StepCacheHitMiss ()
+  : TestCase ("Check the hits and misses of the StepCache")
+{
+}
+
+StepCacheHitMiss::~StepCacheHitMiss ()
+{
+}
+
+std::string
+StepCacheHitMiss::GetEntryPath (const std::string &dir, const std::string &key)
+{
+  std::string hash = StepCache::Hash (key);
+  return dir + "/" + hash.substr (0, 2) + "/" + hash.substr (2);
+}
+
+void
+StepCacheHitMiss::RemoveEntry (const std::string &dir, const std::string &key)
+{
+  std::string path = GetEntryPath (dir, key);
+  unlink (path.c_str ());
+  rmdir (path.substr (0, path.rfind ('/')).c_str ());
+}
+
+void
+StepCacheHitMiss::DoRun (void)
+{
+  std::string dir = CreateTempDirFilename ("step-cache-test");
+  // keys of the same size, so that only the key comparison tells them apart
+  std::string keyA = "scenario=1 seed=1 actions=0,1";
+  std::string keyB = "scenario=1 seed=2 actions=0,1";
+  NS_TEST_ASSERT_MSG_EQ (StepCache::Hash (keyA).size (), 32, "The hash should be 32 hex digits");
+  NS_TEST_ASSERT_MSG_EQ (StepCache::Hash (keyA), StepCache::Hash (keyA), "The hash should be deterministic");
+  NS_TEST_ASSERT_MSG_NE (StepCache::Hash (keyA), StepCache::Hash (keyB), "The keys should not collide");
+
+  StepCache cache (dir);
+  StepStats stats = {12, 3.5, 0.25};
+  StepStats found = {0, 0, 0};
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (keyA, found), false, "The cache should be empty");
+  cache.Store (keyA, stats);
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (keyA, found), true, "The value stored should be found");
+  NS_TEST_ASSERT_MSG_EQ (found.numPkts, stats.numPkts, "Wrong value found");
+  NS_TEST_ASSERT_MSG_EQ_TOL (found.thpt, stats.thpt, 1e-12, "Numbers are not equal within tolerance");
+  NS_TEST_ASSERT_MSG_EQ_TOL (found.delay, stats.delay, 1e-12, "Numbers are not equal within tolerance");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (keyB, found), false, "Another key should miss");
+
+  // a value of another size is a miss
+  double thpt = 0;
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (keyA, thpt), false, "A value of another size should miss");
+
+  // the entries are shared with another cache on the same directory
+  StepCache otherCache (dir);
+  found = {0, 0, 0};
+  NS_TEST_ASSERT_MSG_EQ (otherCache.Lookup (keyA, found), true, "The value stored should be shared");
+  NS_TEST_ASSERT_MSG_EQ (found.numPkts, stats.numPkts, "Wrong value found");
+
+  // the entry of keyA at the path of keyB, as on a hash collision: the stored key differs
+  std::string pathB = GetEntryPath (dir, keyB);
+  mkdir (pathB.substr (0, pathB.rfind ('/')).c_str (), 0755);
+  NS_TEST_ASSERT_MSG_EQ (std::rename (GetEntryPath (dir, keyA).c_str (), pathB.c_str ()), 0,
+                         "Cannot move the entry");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (keyB, found), false, "The entry of another key should miss");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (keyA, found), false, "The entry was moved");
+
+  NS_TEST_ASSERT_MSG_EQ (cache.GetNumHits (), 1, "Wrong number of hits");
+  NS_TEST_ASSERT_MSG_EQ (cache.GetNumMisses (), 5, "Wrong number of misses");
+  NS_TEST_ASSERT_MSG_EQ (otherCache.GetNumHits (), 1, "Wrong number of hits");
+  NS_TEST_ASSERT_MSG_EQ (otherCache.GetNumMisses (), 0, "Wrong number of misses");
+
+  RemoveEntry (dir, keyA);
+  RemoveEntry (dir, keyB);
+  rmdir (dir.c_str ());
+}
+
+class StepCacheTestSuite : public TestSuite
+{
+public:
+  StepCacheTestSuite ();
+};
+
+StepCacheTestSuite::StepCacheTestSuite ()
+  : TestSuite ("step-cache", UNIT)
+{
+  AddTestCase (new StepCacheHitMiss, TestCase::QUICK);
+}
+
+static StepCacheTestSuite stepCacheTestSuite;
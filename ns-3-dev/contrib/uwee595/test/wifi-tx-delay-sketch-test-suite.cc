@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2024
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/wifi-tx-stats-helper.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * Get delays on a geometric grid, from exp (logLow) to exp (logHigh) ms, in increasing order
+ */
+std::vector<double>
+GetDelays (double logLow, double logHigh, uint32_t numDelays)
+{
+  std::vector<double> delays;
+  for (uint32_t i = 0; i < numDelays; ++i)
+    {
+      delays.push_back (std::exp (logLow + (logHigh - logLow) * i / (numDelays - 1)));
+    }
+  return delays;
+}
+
+/**
+ * Get the delay of the rank used by WifiTxDelaySketch::GetQuantile
+ */
+double
+GetExactQuantile (const std::vector<double> &sortedDelays, double q)
+{
+  return sortedDelays[static_cast<std::size_t> (q * (sortedDelays.size () - 1))];
+}
+
+} // namespace
+
+class WifiTxDelaySketchQuantiles : public TestCase
+{
+public:
+  WifiTxDelaySketchQuantiles ();
+  virtual ~WifiTxDelaySketchQuantiles ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WifiTxDelaySketchQuantiles::WifiTxDelaySketchQuantiles ()
+  : TestCase ("Check the quantiles of the WifiTxDelaySketch within its relative accuracy")
+{
+}
+
+WifiTxDelaySketchQuantiles::~WifiTxDelaySketchQuantiles ()
+{
+}
+
+void
+WifiTxDelaySketchQuantiles::DoRun (void)
+{
+  WifiTxDelaySketch sketch;
+  NS_TEST_ASSERT_MSG_EQ (std::isnan (sketch.GetQuantile (0.5)), true, "An empty sketch has no quantile");
+
+  // 0.05 ms to 150 ms, added from the largest
+  std::vector<double> delays = GetDelays (std::log (0.05), std::log (150), 1001);
+  for (auto it = delays.rbegin (); it != delays.rend (); ++it)
+    {
+      sketch.Add (*it);
+    }
+  NS_TEST_ASSERT_MSG_EQ (sketch.m_count, delays.size (), "Wrong number of delays");
+  for (double q : {0.0, 0.01, 0.25, 0.5, 0.9, 0.95, 0.99, 1.0})
+    {
+      double exact = GetExactQuantile (delays, q);
+      NS_TEST_ASSERT_MSG_EQ_TOL (sketch.GetQuantile (q), exact, WifiTxDelaySketch::ALPHA * exact,
+                                 "Quantile " << q << " not within the relative accuracy");
+    }
+
+  // the delays below MIN_DELAY_MS are the lowest quantiles, returned as 0
+  for (uint32_t i = 0; i < delays.size (); ++i)
+    {
+      sketch.Add (0);
+    }
+  NS_TEST_ASSERT_MSG_EQ (sketch.m_zeroCount, delays.size (), "Wrong number of zero delays");
+  NS_TEST_ASSERT_MSG_EQ_TOL (sketch.GetQuantile (0.25), 0, 1e-12, "Numbers are not equal within tolerance");
+  double exact = delays[delays.size () / 2 - 1];
+  NS_TEST_ASSERT_MSG_EQ_TOL (sketch.GetQuantile (0.75), exact, WifiTxDelaySketch::ALPHA * exact,
+                             "Quantile 0.75 not within the relative accuracy");
+
+  // more buckets than MAX_BUCKETS: the lowest are collapsed, the upper quantiles stay accurate
+  WifiTxDelaySketch wideSketch;
+  delays = GetDelays (-10, 40, 20001);
+  for (double delay : delays)
+    {
+      wideSketch.Add (delay);
+    }
+  NS_TEST_ASSERT_MSG_EQ (wideSketch.m_buckets.size (), WifiTxDelaySketch::MAX_BUCKETS,
+                         "The buckets should be collapsed");
+  for (double q : {0.5, 0.9, 0.99, 1.0})
+    {
+      exact = GetExactQuantile (delays, q);
+      NS_TEST_ASSERT_MSG_EQ_TOL (wideSketch.GetQuantile (q), exact, WifiTxDelaySketch::ALPHA * exact,
+                                 "Quantile " << q << " not within the relative accuracy");
+    }
+}
+
+class WifiTxDelaySketchMerge : public TestCase
+{
+public:
+  WifiTxDelaySketchMerge ();
+  virtual ~WifiTxDelaySketchMerge ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WifiTxDelaySketchMerge::WifiTxDelaySketchMerge ()
+  : TestCase ("Check that merged WifiTxDelaySketch equal the sketch of all the delays")
+{
+}
+
+WifiTxDelaySketchMerge::~WifiTxDelaySketchMerge ()
+{
+}
+
+void
+WifiTxDelaySketchMerge::DoRun (void)
+{
+  std::vector<double> delays = GetDelays (std::log (0.05), std::log (150), 1001);
+  WifiTxDelaySketch all;
+  WifiTxDelaySketch even;
+  WifiTxDelaySketch odd;
+  for (uint32_t i = 0; i < delays.size (); ++i)
+    {
+      double delay = (i % 10 == 0) ? 0 : delays[i];
+      all.Add (delay);
+      (i % 2 == 0 ? even : odd).Add (delay);
+    }
+  // a sketch without delays changes nothing
+  even.Merge (WifiTxDelaySketch ());
+  even.Merge (odd);
+  NS_TEST_ASSERT_MSG_EQ (even.m_count, all.m_count, "Wrong number of delays");
+  NS_TEST_ASSERT_MSG_EQ (even.m_zeroCount, all.m_zeroCount, "Wrong number of zero delays");
+  NS_TEST_ASSERT_MSG_EQ ((even.m_buckets == all.m_buckets), true, "The bucket counts should be equal");
+  for (double q : {0.0, 0.1, 0.5, 0.95, 0.99, 1.0})
+    {
+      NS_TEST_ASSERT_MSG_EQ (even.GetQuantile (q), all.GetQuantile (q), "Quantile " << q << " differs");
+    }
+
+  // merged into an empty sketch, as done for the totals
+  WifiTxDelaySketch total;
+  total.Merge (all);
+  NS_TEST_ASSERT_MSG_EQ (total.GetQuantile (0.95), all.GetQuantile (0.95), "Quantile 0.95 differs");
+}
+
+class WifiTxDelaySketchTestSuite : public TestSuite
+{
+public:
+  WifiTxDelaySketchTestSuite ();
+};
+
+WifiTxDelaySketchTestSuite::WifiTxDelaySketchTestSuite ()
+  : TestSuite ("wifi-tx-delay-sketch", UNIT)
+{
+  AddTestCase (new WifiTxDelaySketchQuantiles, TestCase::QUICK);
+  AddTestCase (new WifiTxDelaySketchMerge, TestCase::QUICK);
+}
+
+static WifiTxDelaySketchTestSuite wifiTxDelaySketchTestSuite;